@@ -16,16 +16,21 @@
 #include "LogManager.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageLoadProject.h"
+#include "MessageQuitApplication.h"
 #include "MessageStatus.h"
+#include "PersistentStorage.h"
 #include "productVersion.h"
+#include "ProjectSettings.h"
 #include "QtNetworkFactory.h"
 #include "QtApplication.h"
 #include "QtCoreApplication.h"
+#include "QtQueryServer.h"
 #include "QtViewFactory.h"
 #include "ResourcePaths.h"
 #include "ScopedFunctor.h"
 #include "SourceGroupFactory.h"
 #include "SourceGroupFactoryModuleCustom.h"
+#include "StorageQueryHandler.h"
 #include "UserPaths.h"
 #include "utility.h"
 #include "utilityApp.h"
@@ -52,6 +57,53 @@ void signalHandler(int signum)
 	MessageIndexingInterrupted().dispatch();
 }
 
+void stopQueryServerSignalHandler(int signum)
+{
+	std::cout << "stop query server" << std::endl;
+	MessageQuitApplication().dispatch();
+}
+
+int runQueryServer(const FilePath& projectFilePath, const std::string& serverName)
+{
+	ProjectSettings projectSettings(projectFilePath);
+	if (!projectSettings.reload())
+	{
+		std::wcout << L"ERROR: Unable to load project " << projectFilePath.wstr() << std::endl;
+		return 1;
+	}
+
+	if (!projectSettings.getDBFilePath().exists())
+	{
+		std::cout << "ERROR: The project needs to be indexed with this version first." << std::endl;
+		return 1;
+	}
+
+	// the index is opened read-only, so the database indices for reading are not created here. They
+	// exist once the project was loaded by the application. Bookmarks are not served, so no
+	// bookmark database gets opened.
+	std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+		projectSettings.getDBFilePath(), FilePath(), true);
+	if (storage->isEmpty() || storage->isIncompatible())
+	{
+		std::cout << "ERROR: The project needs to be indexed with this version first." << std::endl;
+		return 1;
+	}
+
+	storage->buildCaches();
+	storage->setConcurrentReadsEnabled(true);
+
+	QtQueryServer server(std::make_shared<StorageQueryHandler>(storage));
+	if (!server.listen(serverName))
+	{
+		return 1;
+	}
+
+	signal(SIGINT, stopQueryServerSignalHandler);
+	signal(SIGTERM, stopQueryServerSignalHandler);
+
+	return QCoreApplication::exec();
+}
+
 void setupLogging()
 {
 	LogManager* logManager = LogManager::getInstance().get();
@@ -164,8 +216,28 @@ int main(int argc, char *argv[])
 		{
 			std::wcout << commandLineParser.getError() << std::endl;
 		}
+		else if (!commandLineParser.getQueryServerName().empty())
+		{
+			return runQueryServer(
+				commandLineParser.getProjectFilePath(), commandLineParser.getQueryServerName());
+		}
 		else
 		{
+			if (!commandLineParser.getTraceFilePath().empty())
+			{
+				Application::setTraceFilePath(commandLineParser.getTraceFilePath().getAbsolute());
+			}
+
+			if (!commandLineParser.getReportFilePath().empty())
+			{
+				Application::setIndexingReportFilePath(
+					commandLineParser.getReportFilePath().getAbsolute());
+			}
+
+			Application::setIndexingShard(
+				commandLineParser.getIndexingShardIndex(),
+				commandLineParser.getIndexingShardCount());
+
 			MessageLoadProject(
 				commandLineParser.getProjectFilePath(),
 				false,
@@ -218,6 +290,10 @@ int main(int argc, char *argv[])
 		}
 		else
 		{
+			Application::setIndexingShard(
+				commandLineParser.getIndexingShardIndex(),
+				commandLineParser.getIndexingShardCount());
+
 			MessageLoadProject(
 				commandLineParser.getProjectFilePath(),
 				false,
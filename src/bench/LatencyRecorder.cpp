@@ -0,0 +1,67 @@
+#include "LatencyRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+LatencyRecorder::ScopedSample::ScopedSample(LatencyRecorder* recorder)
+	: m_recorder(recorder), m_start(std::chrono::steady_clock::now())
+{
+}
+
+LatencyRecorder::ScopedSample::~ScopedSample()
+{
+	m_recorder->addSample(std::chrono::duration_cast<std::chrono::microseconds>(
+							  std::chrono::steady_clock::now() - m_start)
+							  .count());
+}
+
+void LatencyRecorder::addSample(long long microseconds)
+{
+	m_sorted = m_samples.empty() || (m_sorted && m_samples.back() <= microseconds);
+	m_samples.push_back(microseconds);
+}
+
+size_t LatencyRecorder::getSampleCount() const
+{
+	return m_samples.size();
+}
+
+double LatencyRecorder::getPercentileMs(double percentile) const
+{
+	if (m_samples.empty())
+	{
+		return 0.0;
+	}
+
+	if (!m_sorted)
+	{
+		std::sort(m_samples.begin(), m_samples.end());
+		m_sorted = true;
+	}
+
+	const size_t rank = static_cast<size_t>(
+		std::ceil(std::max(0.0, std::min(percentile, 100.0)) / 100.0 * m_samples.size()));
+	return m_samples[rank > 0 ? rank - 1 : 0] / 1000.0;
+}
+
+QJsonObject LatencyRecorder::toJson() const
+{
+	long long totalMicroseconds = 0;
+	for (long long sample: m_samples)
+	{
+		totalMicroseconds += sample;
+	}
+
+	const double totalMs = totalMicroseconds / 1000.0;
+
+	QJsonObject json;
+	json["count"] = double(m_samples.size());
+	json["total_ms"] = totalMs;
+	json["mean_ms"] = m_samples.empty() ? 0.0 : totalMs / m_samples.size();
+	json["p50_ms"] = getPercentileMs(50);
+	json["p90_ms"] = getPercentileMs(90);
+	json["p99_ms"] = getPercentileMs(99);
+	json["max_ms"] = getPercentileMs(100);
+	json["throughput_per_second"] = totalMs > 0.0 ? m_samples.size() * 1000.0 / totalMs : 0.0;
+	return json;
+}
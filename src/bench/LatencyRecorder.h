@@ -0,0 +1,41 @@
+#ifndef LATENCY_RECORDER_H
+#define LATENCY_RECORDER_H
+
+#include <chrono>
+#include <vector>
+
+#include <QJsonObject>
+
+// Collects the latencies of repeated executions of one benchmark and summarizes them as
+// percentiles and throughput.
+class LatencyRecorder
+{
+public:
+	// adds the time until destruction as sample
+	class ScopedSample
+	{
+	public:
+		ScopedSample(LatencyRecorder* recorder);
+		~ScopedSample();
+
+	private:
+		LatencyRecorder* const m_recorder;
+		const std::chrono::steady_clock::time_point m_start;
+	};
+
+	void addSample(long long microseconds);
+
+	size_t getSampleCount() const;
+
+	// percentile in [0, 100], uses the nearest rank method
+	double getPercentileMs(double percentile) const;
+
+	QJsonObject toJson() const;
+
+private:
+	// sorted lazily, which only changes the order of the samples
+	mutable std::vector<long long> m_samples;
+	mutable bool m_sorted = true;
+};
+
+#endif	  // LATENCY_RECORDER_H
@@ -0,0 +1,260 @@
+#include "QueryBenchmark.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include "FilePath.h"
+#include "Graph.h"
+#include "LatencyRecorder.h"
+#include "logging.h"
+#include "NameHierarchy.h"
+#include "NodeTypeSet.h"
+#include "PersistentStorage.h"
+#include "SearchMatch.h"
+#include "SourceLocationCollection.h"
+#include "TextAccess.h"
+#include "utilityString.h"
+
+namespace
+{
+// same as the default of the trail depth slider
+const size_t s_trailDepth = 5;
+
+bool getTrailEdgeTypes(const NodeType& type, Edge::TypeMask* edgeTypes)
+{
+	if (type.isInheritable())
+	{
+		*edgeTypes = Edge::EDGE_INHERITANCE | Edge::EDGE_TEMPLATE_SPECIALIZATION;
+	}
+	else if (type.isCallable())
+	{
+		*edgeTypes = Edge::EDGE_CALL | Edge::EDGE_OVERRIDE;
+	}
+	else if (type.isFile())
+	{
+		*edgeTypes = Edge::EDGE_INCLUDE;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+}	 // namespace
+
+std::string QueryBenchmark::queryTypeToString(QueryType type)
+{
+	switch (type)
+	{
+	case QUERY_AUTOCOMPLETION:
+		return "autocompletion";
+	case QUERY_FULLTEXT:
+		return "fulltext";
+	case QUERY_GRAPH:
+		return "graph";
+	case QUERY_TRAIL:
+		return "trail";
+	case QUERY_LOCATIONS:
+		return "locations";
+	}
+	return "";
+}
+
+bool QueryBenchmark::stringToQueryType(const std::string& str, QueryType* type)
+{
+	for (QueryType queryType:
+		 {QUERY_AUTOCOMPLETION, QUERY_FULLTEXT, QUERY_GRAPH, QUERY_TRAIL, QUERY_LOCATIONS})
+	{
+		if (queryTypeToString(queryType) == str)
+		{
+			*type = queryType;
+			return true;
+		}
+	}
+	return false;
+}
+
+QueryBenchmark::QueryBenchmark(std::shared_ptr<PersistentStorage> storage): m_storage(storage) {}
+
+void QueryBenchmark::addGeneratedQueries(size_t countPerType, unsigned int seed)
+{
+	std::vector<StorageNode> nodes;
+	for (const StorageNode& node: m_storage->getStorageNodes())
+	{
+		const NodeType type(NodeType::intToType(node.type));
+		if (!type.isFile() && type.getType() != NodeType::NODE_SYMBOL)
+		{
+			nodes.push_back(node);
+		}
+	}
+
+	if (nodes.empty())
+	{
+		LOG_WARNING("No symbols to generate queries from.");
+		return;
+	}
+
+	// sort to be independent of the order the database returns the nodes in
+	std::sort(nodes.begin(), nodes.end(), [](const StorageNode& a, const StorageNode& b) {
+		return a.serializedName < b.serializedName;
+	});
+
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<size_t> distribution(0, nodes.size() - 1);
+
+	for (size_t i = 0; i < countPerType; i++)
+	{
+		const StorageNode& node = nodes[distribution(generator)];
+		const std::wstring name = NameHierarchy::deserialize(node.serializedName).back().getName();
+		if (name.empty())
+		{
+			continue;
+		}
+
+		// the prefix a user has typed when the autocompletion list is requested
+		const std::wstring prefix = name.substr(0, std::max<size_t>(2, name.size() / 2));
+
+		m_queries.push_back({QUERY_AUTOCOMPLETION, prefix, 0});
+		m_queries.push_back({QUERY_FULLTEXT, name, 0});
+		m_queries.push_back({QUERY_GRAPH, name, node.id});
+		m_queries.push_back({QUERY_LOCATIONS, name, node.id});
+
+		Edge::TypeMask edgeTypes;
+		if (getTrailEdgeTypes(NodeType(NodeType::intToType(node.type)), &edgeTypes))
+		{
+			m_queries.push_back({QUERY_TRAIL, name, node.id});
+		}
+	}
+}
+
+bool QueryBenchmark::addScriptedQueries(const FilePath& scriptFilePath)
+{
+	if (!scriptFilePath.exists())
+	{
+		LOG_ERROR(L"Query script does not exist: " + scriptFilePath.wstr());
+		return false;
+	}
+
+	for (const std::string& line: TextAccess::createFromFile(scriptFilePath)->getAllLines())
+	{
+		const std::string trimmedLine = utility::trim(line);
+		if (trimmedLine.empty() || trimmedLine[0] == '#')
+		{
+			continue;
+		}
+
+		const size_t pos = trimmedLine.find(' ');
+		QueryType type;
+		if (pos == std::string::npos || !stringToQueryType(trimmedLine.substr(0, pos), &type))
+		{
+			LOG_ERROR("Invalid query in script: " + trimmedLine);
+			return false;
+		}
+
+		Query query {type, utility::decodeFromUtf8(utility::trim(trimmedLine.substr(pos + 1))), 0};
+		if (type == QUERY_GRAPH || type == QUERY_TRAIL || type == QUERY_LOCATIONS)
+		{
+			query.tokenId = getTokenIdForName(query.term);
+			if (!query.tokenId)
+			{
+				LOG_WARNING(L"Skipping query for unknown symbol: " + query.term);
+				continue;
+			}
+		}
+
+		m_queries.push_back(query);
+	}
+
+	return true;
+}
+
+size_t QueryBenchmark::getQueryCount() const
+{
+	return m_queries.size();
+}
+
+QJsonObject QueryBenchmark::run(size_t repetitions) const
+{
+	std::map<QueryType, LatencyRecorder> recorders;
+	std::map<QueryType, size_t> resultCounts;
+
+	for (size_t i = 0; i < repetitions; i++)
+	{
+		for (const Query& query: m_queries)
+		{
+			LatencyRecorder::ScopedSample sample(&recorders[query.type]);
+			resultCounts[query.type] += runQuery(query);
+		}
+	}
+
+	QJsonObject json;
+	for (const auto& p: recorders)
+	{
+		QJsonObject latencies = p.second.toJson();
+		latencies["result_count"] = double(resultCounts[p.first]);
+		json[QString::fromStdString(queryTypeToString(p.first))] = latencies;
+	}
+	return json;
+}
+
+Id QueryBenchmark::getTokenIdForName(const std::wstring& name) const
+{
+	// resolved like a search in the search bar, prefers the symbol with exactly this name
+	Id tokenId = 0;
+	for (const SearchMatch& match:
+		 m_storage->getAutocompletionMatches(name, NodeTypeSet::all(), false))
+	{
+		if (match.searchType != SearchMatch::SEARCH_TOKEN || match.tokenIds.empty())
+		{
+			continue;
+		}
+
+		if (match.getFullName() == name)
+		{
+			return match.tokenIds.front();
+		}
+
+		if (!tokenId)
+		{
+			tokenId = match.tokenIds.front();
+		}
+	}
+	return tokenId;
+}
+
+size_t QueryBenchmark::runQuery(const Query& query) const
+{
+	switch (query.type)
+	{
+	case QUERY_AUTOCOMPLETION:
+		return m_storage->getAutocompletionMatches(query.term, NodeTypeSet::all(), true).size();
+
+	case QUERY_FULLTEXT:
+		return m_storage->getFullTextSearchLocations(query.term, false)->getSourceLocationCount();
+
+	case QUERY_GRAPH:
+	{
+		Id declarationId = 0;
+		const std::vector<Id> activeTokenIds =
+			m_storage->getActiveTokenIdsForId(query.tokenId, &declarationId);
+		return m_storage->getGraphForActiveTokenIds(activeTokenIds, {})->getNodeCount();
+	}
+
+	case QUERY_TRAIL:
+	{
+		Edge::TypeMask edgeTypes;
+		if (!getTrailEdgeTypes(m_storage->getNodeTypeForNodeWithId(query.tokenId), &edgeTypes))
+		{
+			return 0;
+		}
+		return m_storage
+			->getGraphForTrail(query.tokenId, 0, 0, edgeTypes, false, s_trailDepth, true)
+			->getNodeCount();
+	}
+
+	case QUERY_LOCATIONS:
+		return m_storage->getSourceLocationsForTokenIds({query.tokenId})->getSourceLocationCount();
+	}
+	return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef QUERY_BENCHMARK_H
+#define QUERY_BENCHMARK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QJsonObject>
+
+#include "types.h"
+
+class FilePath;
+class PersistentStorage;
+
+// Replays the queries the UI sends when navigating a project against a storage and measures their
+// latencies per query type. Queries are either picked from the symbols of the storage or read from
+// a script, so the same database and seed or script always produce the same workload.
+class QueryBenchmark
+{
+public:
+	enum QueryType
+	{
+		QUERY_AUTOCOMPLETION,
+		QUERY_FULLTEXT,
+		QUERY_GRAPH,
+		QUERY_TRAIL,
+		QUERY_LOCATIONS
+	};
+
+	static std::string queryTypeToString(QueryType type);
+	static bool stringToQueryType(const std::string& str, QueryType* type);
+
+	QueryBenchmark(std::shared_ptr<PersistentStorage> storage);
+
+	// adds up to countPerType queries of every type, built from randomly picked symbols
+	void addGeneratedQueries(size_t countPerType, unsigned int seed);
+
+	// every line holds "<type> <term>" with type being one of autocompletion, fulltext, graph,
+	// trail and locations. The term of graph, trail and locations queries is a symbol name.
+	bool addScriptedQueries(const FilePath& scriptFilePath);
+
+	size_t getQueryCount() const;
+
+	QJsonObject run(size_t repetitions) const;
+
+private:
+	struct Query
+	{
+		QueryType type;
+		std::wstring term;
+		Id tokenId;
+	};
+
+	Id getTokenIdForName(const std::wstring& name) const;
+	size_t runQuery(const Query& query) const;
+
+	std::shared_ptr<PersistentStorage> m_storage;
+	std::vector<Query> m_queries;
+};
+
+#endif	  // QUERY_BENCHMARK_H
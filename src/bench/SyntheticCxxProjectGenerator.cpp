@@ -0,0 +1,175 @@
+#include "SyntheticCxxProjectGenerator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+
+#include "FileSystem.h"
+#include "utilityString.h"
+#include "utilityUuid.h"
+
+namespace
+{
+const size_t s_methodsPerClass = 4;
+const size_t s_maxIncludesPerModule = 3;
+const size_t s_modulesPerNamespace = 16;
+
+std::string getModuleName(size_t moduleIndex)
+{
+	return "module_" + std::to_string(moduleIndex);
+}
+
+std::string getNamespaceName(size_t moduleIndex)
+{
+	return "group_" + std::to_string(moduleIndex / s_modulesPerNamespace);
+}
+
+std::string getClassName(size_t moduleIndex, size_t classIndex)
+{
+	return "Class_" + std::to_string(moduleIndex) + "_" + std::to_string(classIndex);
+}
+
+std::string getQualifiedClassName(size_t moduleIndex, size_t classIndex)
+{
+	return "synthetic::" + getNamespaceName(moduleIndex) +
+		"::" + getClassName(moduleIndex, classIndex);
+}
+
+void writeFile(const FilePath& filePath, const std::string& content)
+{
+	std::ofstream file(filePath.str());
+	file << content;
+}
+}	 // namespace
+
+SyntheticCxxProjectGenerator::SyntheticCxxProjectGenerator(
+	size_t moduleCount, size_t classesPerModule, unsigned int seed)
+	: m_moduleCount(moduleCount)
+	, m_classesPerModule(std::max<size_t>(1, classesPerModule))
+	, m_seed(seed)
+{
+}
+
+FilePath SyntheticCxxProjectGenerator::generate(
+	const FilePath& projectDirectory, const std::wstring& projectName) const
+{
+	const FilePath sourceDirectory = projectDirectory.getConcatenated(L"src");
+	FileSystem::createDirectory(sourceDirectory);
+
+	std::mt19937 generator(m_seed);
+	std::uniform_int_distribution<size_t> classDistribution(0, m_classesPerModule - 1);
+	std::uniform_int_distribution<size_t> methodDistribution(0, s_methodsPerClass - 1);
+	std::bernoulli_distribution inheritanceDistribution(0.3);
+
+	for (size_t i = 0; i < m_moduleCount; i++)
+	{
+		// modules only include earlier ones, which keeps the include graph acyclic
+		std::set<size_t> includedModules;
+		if (i > 0)
+		{
+			std::uniform_int_distribution<size_t> moduleDistribution(0, i - 1);
+			for (size_t j = 0; j < s_maxIncludesPerModule; j++)
+			{
+				includedModules.insert(moduleDistribution(generator));
+			}
+		}
+
+		const std::vector<size_t> dependencies(includedModules.begin(), includedModules.end());
+		auto getDependency = [&]() {
+			if (dependencies.empty())
+			{
+				return i;
+			}
+			return dependencies[std::uniform_int_distribution<size_t>(
+				0, dependencies.size() - 1)(generator)];
+		};
+
+		const std::string guard = "SYNTHETIC_" + getModuleName(i) + "_H";
+
+		std::stringstream header;
+		header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+		for (size_t dependency: dependencies)
+		{
+			header << "#include \"" << getModuleName(dependency) << ".h\"\n";
+		}
+		header << "\nnamespace synthetic\n{\nnamespace " << getNamespaceName(i) << "\n{\n";
+
+		std::stringstream source;
+		source << "#include \"" << getModuleName(i) << ".h\"\n\n";
+		source << "namespace synthetic\n{\nnamespace " << getNamespaceName(i) << "\n{\n";
+
+		for (size_t c = 0; c < m_classesPerModule; c++)
+		{
+			header << "class " << getClassName(i, c);
+			if (!dependencies.empty() && inheritanceDistribution(generator))
+			{
+				// draw in a fixed order, so the project does not depend on the evaluation order
+				const size_t baseModule = getDependency();
+				const size_t baseClass = classDistribution(generator);
+				header << ": public " << getQualifiedClassName(baseModule, baseClass);
+			}
+			header << "\n{\npublic:\n";
+			for (size_t m = 0; m < s_methodsPerClass; m++)
+			{
+				header << "\tint method_" << m << "(int value);\n";
+			}
+			header << "\n\tint m_value = " << c << ";\n};\n\n";
+
+			for (size_t m = 0; m < s_methodsPerClass; m++)
+			{
+				const size_t calledModule = getDependency();
+				// classes of the own module can only be called if they are declared before
+				const size_t calledClass = calledModule == i
+					? std::uniform_int_distribution<size_t>(0, c)(generator)
+					: classDistribution(generator);
+
+				source << "int " << getClassName(i, c) << "::method_" << m << "(int value)\n{\n";
+				if (calledModule == i && calledClass == c)
+				{
+					source << "\treturn value + m_value;\n}\n\n";
+					continue;
+				}
+
+				source << "\t" << getQualifiedClassName(calledModule, calledClass) << " other;\n";
+				const size_t calledMethod = methodDistribution(generator);
+				source << "\treturn other.method_" << calledMethod << "(value) + m_value;\n}\n\n";
+			}
+		}
+
+		const std::string namespaceEnd = "}\n}\n";
+		header << namespaceEnd << "\n#endif\n";
+		source << namespaceEnd;
+
+		const std::wstring fileName = utility::decodeFromUtf8(getModuleName(i));
+		writeFile(sourceDirectory.getConcatenated(fileName + L".h"), header.str());
+		writeFile(sourceDirectory.getConcatenated(fileName + L".cpp"), source.str());
+	}
+
+	const std::string sourceGroup = "source_group_" + utility::getUuidString();
+
+	std::stringstream project;
+	project << "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n";
+	project << "<config>\n";
+	project << "    <source_groups>\n";
+	project << "        <" << sourceGroup << ">\n";
+	project << "            <cpp_standard>c++17</cpp_standard>\n";
+	project << "            <name>Synthetic Source Group</name>\n";
+	project << "            <source_extensions>\n";
+	project << "                <source_extension>.cpp</source_extension>\n";
+	project << "            </source_extensions>\n";
+	project << "            <source_paths>\n";
+	project << "                <source_path>./src</source_path>\n";
+	project << "            </source_paths>\n";
+	project << "            <status>enabled</status>\n";
+	project << "            <type>C++ Source Group</type>\n";
+	project << "        </" << sourceGroup << ">\n";
+	project << "    </source_groups>\n";
+	project << "    <version>8</version>\n";
+	project << "</config>\n";
+
+	const FilePath projectFilePath = projectDirectory.getConcatenated(projectName + L".srctrlprj");
+	writeFile(projectFilePath, project.str());
+	return projectFilePath;
+}
@@ -0,0 +1,26 @@
+#ifndef SYNTHETIC_CXX_PROJECT_GENERATOR_H
+#define SYNTHETIC_CXX_PROJECT_GENERATOR_H
+
+#include <string>
+
+#include "FilePath.h"
+
+// Writes a C++ project of configurable size for indexing benchmarks. Every module consists of a
+// header and a source file with classes that derive from, and call into, classes of the modules it
+// includes, so the index gets a realistic mix of includes, inheritance, calls and usages. The same
+// seed always produces the same project.
+class SyntheticCxxProjectGenerator
+{
+public:
+	SyntheticCxxProjectGenerator(size_t moduleCount, size_t classesPerModule, unsigned int seed);
+
+	// returns the project file, the sources are written to the src directory next to it
+	FilePath generate(const FilePath& projectDirectory, const std::wstring& projectName) const;
+
+private:
+	const size_t m_moduleCount;
+	const size_t m_classesPerModule;
+	const unsigned int m_seed;
+};
+
+#endif	  // SYNTHETIC_CXX_PROJECT_GENERATOR_H
@@ -0,0 +1,368 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <boost/program_options.hpp>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "language_packages.h"
+
+#include "ConsoleLogger.h"
+#include "FilePath.h"
+#include "FileSystem.h"
+#include "LatencyRecorder.h"
+#include "logging.h"
+#include "LogManager.h"
+#include "PersistentStorage.h"
+#include "ProjectSettings.h"
+#include "QueryBenchmark.h"
+#include "SqliteIndexStorage.h"
+#include "SyntheticCxxProjectGenerator.h"
+#include "SyntheticIndexGenerator.h"
+#include "utilityApp.h"
+#include "utilityString.h"
+
+namespace po = boost::program_options;
+
+struct BenchmarkOptions
+{
+	size_t queryCount = 0;
+	size_t repetitions = 0;
+	unsigned int seed = 0;
+	FilePath queryScriptPath;
+};
+
+void setupLogging()
+{
+	// the benchmark results go to stdout, so only problems get logged
+	std::shared_ptr<ConsoleLogger> consoleLogger = std::make_shared<ConsoleLogger>();
+	consoleLogger->setLogLevel(Logger::LOG_WARNINGS | Logger::LOG_ERRORS);
+	LogManager::getInstance()->addLogger(consoleLogger);
+}
+
+QJsonObject benchmarkQueries(const FilePath& dbFilePath, const BenchmarkOptions& options)
+{
+	QJsonObject result;
+	result["database"] = QString::fromStdWString(dbFilePath.wstr());
+
+	if (!dbFilePath.exists())
+	{
+		LOG_ERROR(L"Database does not exist: " + dbFilePath.wstr());
+		result["error"] = "database does not exist";
+		return result;
+	}
+
+	LatencyRecorder loadTime;
+	std::shared_ptr<PersistentStorage> storage;
+	{
+		LatencyRecorder::ScopedSample sample(&loadTime);
+		storage = std::make_shared<PersistentStorage>(
+			dbFilePath, dbFilePath.replaceExtension(ProjectSettings::BOOKMARK_DB_FILE_EXTENSION));
+		storage->setup();
+		storage->buildCaches();
+	}
+	result["load_ms"] = loadTime.getPercentileMs(100);
+	result["database_bytes"] = double(FileSystem::getFileByteSize(dbFilePath));
+
+	const std::string indexingReport = storage->getIndexingReport();
+	if (!indexingReport.empty())
+	{
+		result["indexing_report"] =
+			QJsonDocument::fromJson(QByteArray::fromStdString(indexingReport)).object();
+	}
+
+	QueryBenchmark benchmark(storage);
+	if (!options.queryScriptPath.empty())
+	{
+		if (!benchmark.addScriptedQueries(options.queryScriptPath))
+		{
+			result["error"] = "invalid query script";
+			return result;
+		}
+	}
+	else
+	{
+		benchmark.addGeneratedQueries(options.queryCount, options.seed);
+	}
+
+	result["query_count"] = double(benchmark.getQueryCount());
+	result["queries"] = benchmark.run(options.repetitions);
+	return result;
+}
+
+QJsonObject benchmarkProject(
+	const FilePath& sourcetrailPath,
+	const FilePath& projectFilePath,
+	const BenchmarkOptions& options)
+{
+	// indexing runs in the headless app, so the indexer processes are set up like for users
+	const std::vector<std::wstring> args = {L"index", L"--full", projectFilePath.wstr()};
+
+	std::wstring errorMessage;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const int exitCode = utility::executeProcessAndGetExitCode(
+		sourcetrailPath.wstr(),
+		args,
+		projectFilePath.getParentDirectory(),
+		-1,
+		false,
+		&errorMessage);
+	const long long indexingTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+										 std::chrono::steady_clock::now() - start)
+										 .count();
+
+	QJsonObject result;
+	if (exitCode != 0)
+	{
+		LOG_ERROR(L"Indexing " + projectFilePath.wstr() + L" failed: " + errorMessage);
+		result["project"] = QString::fromStdWString(projectFilePath.wstr());
+		result["error"] = QString::fromStdWString(L"indexing failed: " + errorMessage);
+		return result;
+	}
+
+	result = benchmarkQueries(
+		projectFilePath.replaceExtension(ProjectSettings::INDEX_DB_FILE_EXTENSION), options);
+	result["project"] = QString::fromStdWString(projectFilePath.wstr());
+	result["indexing_ms"] = double(indexingTimeMs);
+	return result;
+}
+
+FilePath generateSyntheticIndex(const FilePath& dbFilePath, size_t fileCount, unsigned int seed)
+{
+	// written straight into the storage, so indexes much larger than any sample project are cheap
+	FileSystem::remove(dbFilePath);
+
+	SyntheticIndexGenerator::Parameters parameters;
+	parameters.fileCount = fileCount;
+	parameters.seed = seed;
+
+	SqliteIndexStorage storage(dbFilePath);
+	storage.setup();
+	SyntheticIndexGenerator(parameters).generate(
+		&storage, dbFilePath.withoutExtension().concatenate(L"_sources"));
+	return dbFilePath;
+}
+
+std::vector<FilePath> getSampleProjectFilePaths(const FilePath& projectsDirectory)
+{
+	std::vector<std::wstring> projectNames;
+#if BUILD_CXX_LANGUAGE_PACKAGE
+	projectNames.push_back(L"tutorial");
+	projectNames.push_back(L"tictactoe_cpp");
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+#if BUILD_JAVA_LANGUAGE_PACKAGE
+	projectNames.push_back(L"javaparser");
+#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
+#if BUILD_PYTHON_LANGUAGE_PACKAGE
+	projectNames.push_back(L"tictactoe_py");
+#endif	  // BUILD_PYTHON_LANGUAGE_PACKAGE
+
+	std::vector<FilePath> projectFilePaths;
+	for (const std::wstring& projectName: projectNames)
+	{
+		projectFilePaths.push_back(
+			projectsDirectory.getConcatenated(projectName + L"/" + projectName + L".srctrlprj"));
+	}
+	return projectFilePaths;
+}
+
+FilePath copySampleProject(const FilePath& projectFilePath, const FilePath& targetDirectory)
+{
+	// indexing writes the databases next to the project, so the installed samples stay untouched
+	const FilePath projectDirectory = projectFilePath.getParentDirectory();
+	const FilePath copyDirectory = targetDirectory.getConcatenated(projectDirectory.fileName());
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(projectDirectory))
+	{
+		const FilePath copyFilePath = copyDirectory.getConcatenated(
+			filePath.getRelativeTo(projectDirectory));
+		FileSystem::createDirectory(copyFilePath.getParentDirectory());
+		FileSystem::copyFile(filePath, copyFilePath);
+	}
+	return copyDirectory.getConcatenated(projectFilePath.fileName());
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	setupLogging();
+
+	po::options_description options("Options");
+	options.add_options()
+		("help,h", "Print this help message")
+		("sourcetrail", po::value<std::string>(), "Sourcetrail executable used for indexing")
+		("project,p", po::value<std::vector<std::string>>(),
+			"Project to index and query (.srctrlprj), defaults to the sample projects")
+		("database,d", po::value<std::vector<std::string>>(),
+			"Index to query without indexing (.srctrldb)")
+		("synthetic-modules", po::value<size_t>()->default_value(0),
+			"Also index a generated C++ project with this many modules")
+		("synthetic-classes", po::value<size_t>()->default_value(8),
+			"Classes per module of the generated C++ project")
+		("synthetic-directory", po::value<std::string>(),
+			"Directory for the generated C++ project")
+		("synthetic-index-files", po::value<size_t>()->default_value(0),
+			"Also query a generated index with this many files, without indexing")
+		("synthetic-index-path", po::value<std::string>(),
+			"Database file for the generated index (.srctrldb)")
+		("queries,q", po::value<std::string>(),
+			"Script of queries to replay, one \"<type> <term>\" per line")
+		("query-count", po::value<size_t>()->default_value(100),
+			"Generated queries per query type")
+		("repetitions", po::value<size_t>()->default_value(3),
+			"Number of times all queries are replayed")
+		("seed", po::value<unsigned int>()->default_value(42),
+			"Seed for generated projects and queries")
+		("output,o", po::value<std::string>(),
+			"Write the results as JSON to this file instead of stdout");
+
+	po::variables_map vm;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), vm);
+		po::notify(vm);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << options << std::endl;
+		return 1;
+	}
+
+	if (vm.count("help"))
+	{
+		std::cout << options << std::endl;
+		return 0;
+	}
+
+	BenchmarkOptions benchmarkOptions;
+	benchmarkOptions.queryCount = vm["query-count"].as<size_t>();
+	benchmarkOptions.repetitions = vm["repetitions"].as<size_t>();
+	benchmarkOptions.seed = vm["seed"].as<unsigned int>();
+	if (vm.count("queries"))
+	{
+		benchmarkOptions.queryScriptPath = FilePath(vm["queries"].as<std::string>()).getAbsolute();
+	}
+
+	// the bench directory is next to the app directory, which links in the sample projects
+	const FilePath benchDirectory(QCoreApplication::applicationDirPath().toStdWString());
+	const FilePath appDirectory = benchDirectory.getConcatenated(L"../app").getCanonical();
+
+	FilePath sourcetrailPath = appDirectory.getConcatenated(
+		utility::getOsType() == OS_WINDOWS ? L"Sourcetrail.exe" : L"Sourcetrail");
+	if (vm.count("sourcetrail"))
+	{
+		sourcetrailPath = FilePath(vm["sourcetrail"].as<std::string>()).getAbsolute();
+	}
+
+	std::vector<FilePath> projectFilePaths;
+	std::vector<FilePath> dbFilePaths;
+	if (vm.count("project"))
+	{
+		for (const std::string& project: vm["project"].as<std::vector<std::string>>())
+		{
+			projectFilePaths.push_back(FilePath(project).getAbsolute());
+		}
+	}
+	if (vm.count("database"))
+	{
+		for (const std::string& database: vm["database"].as<std::vector<std::string>>())
+		{
+			dbFilePaths.push_back(FilePath(database).getAbsolute());
+		}
+	}
+	// removed with all copied sample projects and their indexes when the benchmark is done
+	QTemporaryDir sampleProjectsDirectory;
+	if (projectFilePaths.empty() && dbFilePaths.empty())
+	{
+		if (!sampleProjectsDirectory.isValid())
+		{
+			std::cerr << "ERROR: Could not create a directory for the sample projects" << std::endl;
+			return 1;
+		}
+
+		for (const FilePath& projectFilePath:
+			 getSampleProjectFilePaths(appDirectory.getConcatenated(L"user/projects")))
+		{
+			projectFilePaths.push_back(copySampleProject(
+				projectFilePath, FilePath(sampleProjectsDirectory.path().toStdWString())));
+		}
+	}
+
+	const size_t syntheticModuleCount = vm["synthetic-modules"].as<size_t>();
+	if (syntheticModuleCount > 0)
+	{
+		FilePath syntheticDirectory = benchDirectory.getConcatenated(L"synthetic");
+		if (vm.count("synthetic-directory"))
+		{
+			syntheticDirectory =
+				FilePath(vm["synthetic-directory"].as<std::string>()).getAbsolute();
+		}
+
+		const SyntheticCxxProjectGenerator generator(
+			syntheticModuleCount, vm["synthetic-classes"].as<size_t>(), benchmarkOptions.seed);
+		projectFilePaths.push_back(generator.generate(syntheticDirectory, L"synthetic"));
+	}
+
+	const size_t syntheticIndexFileCount = vm["synthetic-index-files"].as<size_t>();
+	if (syntheticIndexFileCount > 0)
+	{
+		FilePath syntheticIndexPath = benchDirectory.getConcatenated(L"synthetic_index.srctrldb");
+		if (vm.count("synthetic-index-path"))
+		{
+			syntheticIndexPath =
+				FilePath(vm["synthetic-index-path"].as<std::string>()).getAbsolute();
+		}
+
+		std::cerr << "generating " << syntheticIndexPath.str() << std::endl;
+		dbFilePaths.push_back(generateSyntheticIndex(
+			syntheticIndexPath, syntheticIndexFileCount, benchmarkOptions.seed));
+	}
+
+	QJsonArray results;
+	for (const FilePath& projectFilePath: projectFilePaths)
+	{
+		std::cerr << "benchmarking " << projectFilePath.str() << std::endl;
+		results.append(benchmarkProject(sourcetrailPath, projectFilePath, benchmarkOptions));
+	}
+	for (const FilePath& dbFilePath: dbFilePaths)
+	{
+		std::cerr << "benchmarking " << dbFilePath.str() << std::endl;
+		results.append(benchmarkQueries(dbFilePath, benchmarkOptions));
+	}
+
+	QJsonObject output;
+	output["seed"] = double(benchmarkOptions.seed);
+	output["repetitions"] = double(benchmarkOptions.repetitions);
+	output["results"] = results;
+
+	const std::string json = QJsonDocument(output).toJson(QJsonDocument::Indented).toStdString();
+	if (vm.count("output"))
+	{
+		std::ofstream outputFile(vm["output"].as<std::string>());
+		if (outputFile.fail())
+		{
+			std::cerr << "ERROR: Could not write " << vm["output"].as<std::string>() << std::endl;
+			return 1;
+		}
+		outputFile << json;
+	}
+	else
+	{
+		std::cout << json;
+	}
+
+	for (const QJsonValue& result: results)
+	{
+		if (result.toObject().contains("error"))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -1219,6 +1219,20 @@ void CppSQLite3DB::open(const char* szFile)
 }
 
 
+void CppSQLite3DB::open(const char* szFile, int nFlags)
+{
+	int nRet = sqlite3_open_v2(szFile, &mpDB, nFlags, 0);
+
+	if (nRet != SQLITE_OK)
+	{
+		const char* szError = sqlite3_errmsg(mpDB);
+		throw CppSQLite3Exception(nRet, (char*)szError, DONT_DELETE_MSG);
+	}
+
+	setBusyTimeout(mnBusyTimeoutMs);
+}
+
+
 void CppSQLite3DB::close()
 {
 	if (mpDB)
@@ -10,6 +10,8 @@
 #include "FileLogger.h"
 #include "logging.h"
 #include "LogManager.h"
+#include "ScopedFunctor.h"
+#include "tracing.h"
 
 #if BUILD_CXX_LANGUAGE_PACKAGE
 #include "LanguagePackageCxx.h"
@@ -100,8 +102,31 @@ int main(int argc, char *argv[])
 	LanguagePackageManager::getInstance()->addPackage(std::make_shared<LanguagePackageJava>());
 #endif // BUILD_JAVA_LANGUAGE_PACKAGE
 
-	InterprocessIndexer indexer(instanceUuid, processId);
-	indexer.work();
+	InterprocessIndexer indexer(instanceUuid, processId, true);
+	if (indexer.getTracingEnabled())
+	{
+		Tracer::getInstance()->setProcess(
+			processId, "Sourcetrail Indexer " + std::to_string(processId));
+		Tracer::getInstance()->setEnabled(true);
+	}
+
+	try
+	{
+		// the trace is also written when indexing got interrupted or failed with an error
+		ScopedFunctor traceExporter([&indexer]() {
+			if (Tracer::isEnabled())
+			{
+				indexer.exportTrace();
+			}
+		});
+
+		indexer.work();
+	}
+	catch (...)
+	{
+		// the error was logged by the indexer, the app restarts processes that did not return 0
+		return 1;
+	}
 
 	return 0;
 }
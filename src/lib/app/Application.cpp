@@ -7,6 +7,7 @@
 #include "FileSystem.h"
 #include "GraphViewStyle.h"
 #include "IDECommunicationController.h"
+#include "IndexingReport.h"
 #include "LogManager.h"
 #include "MainView.h"
 #include "MessageFilterErrorCountUpdate.h"
@@ -33,6 +34,10 @@
 
 std::shared_ptr<Application> Application::s_instance;
 std::string Application::s_uuid;
+FilePath Application::s_traceFilePath;
+FilePath Application::s_indexingReportFilePath;
+size_t Application::s_indexingShardIndex = 0;
+size_t Application::s_indexingShardCount = 1;
 
 void Application::createInstance(
 	const Version& version, ViewFactory* viewFactory, NetworkFactory* networkFactory)
@@ -92,6 +97,18 @@ void Application::destroyInstance()
 	TaskManager::destroyScheduler(TabId::app());
 
 	s_instance.reset();
+
+	if (Tracer::isEnabled())
+	{
+		FilePath traceFilePath = s_traceFilePath;
+		if (traceFilePath.empty())
+		{
+			FileSystem::createDirectory(UserPaths::getLogPath());
+			traceFilePath = UserPaths::getLogPath().concatenate(
+				L"trace_" + utility::decodeFromUtf8(getUUID()) + L".json");
+		}
+		Tracer::getInstance()->exportTrace(traceFilePath);
+	}
 }
 
 std::string Application::getUUID()
@@ -112,10 +129,28 @@ void Application::loadSettings()
 	settings->load(UserPaths::getAppSettingsPath());
 
 	LogManager::getInstance()->setLoggingEnabled(settings->getLoggingEnabled());
+	Tracer::getInstance()->setEnabled(settings->getTracingEnabled() || !s_traceFilePath.empty());
 
 	loadStyle(settings->getColorSchemePath());
 }
 
+void Application::setTraceFilePath(const FilePath& traceFilePath)
+{
+	s_traceFilePath = traceFilePath;
+	Tracer::getInstance()->setEnabled(true);
+}
+
+void Application::setIndexingReportFilePath(const FilePath& reportFilePath)
+{
+	s_indexingReportFilePath = reportFilePath;
+}
+
+void Application::setIndexingShard(size_t shardIndex, size_t shardCount)
+{
+	s_indexingShardIndex = shardIndex;
+	s_indexingShardCount = shardCount;
+}
+
 void Application::loadStyle(const FilePath& colorSchemePath)
 {
 	ColorScheme::getInstance()->load(colorSchemePath);
@@ -218,13 +253,34 @@ void Application::handleMessage(MessageCloseProject* message)
 	m_mainView->clear();
 }
 
+void Application::handleMessage(MessageIndexingFilesChanged* message)
+{
+	if (m_project)
+	{
+		m_project->refreshChangedFiles(message->filePaths);
+	}
+}
+
 void Application::handleMessage(MessageIndexingFinished* message)
 {
+	m_storageCache->clearQueryResults();
+
 	logStorageStats();
 
+	if (!s_indexingReportFilePath.empty() && m_project && m_project->getIndexingReport())
+	{
+		m_project->getIndexingReport()->exportJson(s_indexingReportFilePath);
+	}
+
 	if (m_hasGUI)
 	{
 		MessageRefreshUI().afterIndexing().dispatch();
+
+		// files changed while indexing get indexed in the background now
+		if (m_project)
+		{
+			m_project->refreshChangedFiles({});
+		}
 	}
 	else
 	{
@@ -285,6 +341,7 @@ void Application::handleMessage(MessageLoadProject* message)
 
 			if (m_project)
 			{
+				m_project->setIndexingShard(s_indexingShardIndex, s_indexingShardCount);
 				m_project->load(getDialogView(DialogView::UseCase::GENERAL));
 			}
 			else
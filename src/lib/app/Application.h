@@ -6,6 +6,7 @@
 #include "DialogView.h"
 #include "MessageActivateWindow.h"
 #include "MessageCloseProject.h"
+#include "MessageIndexingFilesChanged.h"
 #include "MessageIndexingFinished.h"
 #include "MessageListener.h"
 #include "MessageLoadProject.h"
@@ -27,6 +28,7 @@ class ViewFactory;
 class Application
 	: public MessageListener<MessageActivateWindow>
 	, public MessageListener<MessageCloseProject>
+	, public MessageListener<MessageIndexingFilesChanged>
 	, public MessageListener<MessageIndexingFinished>
 	, public MessageListener<MessageLoadProject>
 	, public MessageListener<MessageRefresh>
@@ -45,6 +47,15 @@ public:
 	static void loadSettings();
 	static void loadStyle(const FilePath& colorSchemePath);
 
+	// enables tracing and writes the trace to this file instead of the log directory
+	static void setTraceFilePath(const FilePath& traceFilePath);
+
+	// writes the report of every finished indexing run to this file
+	static void setIndexingReportFilePath(const FilePath& reportFilePath);
+
+	// indexes only this part of the source files of loaded projects, shardIndex starts at 0
+	static void setIndexingShard(size_t shardIndex, size_t shardCount);
+
 	~Application();
 
 	std::shared_ptr<const Project> getCurrentProject() const;
@@ -63,11 +74,16 @@ public:
 private:
 	static std::shared_ptr<Application> s_instance;
 	static std::string s_uuid;
+	static FilePath s_traceFilePath;
+	static FilePath s_indexingReportFilePath;
+	static size_t s_indexingShardIndex;
+	static size_t s_indexingShardCount;
 
 	Application(bool withGUI = true);
 
 	void handleMessage(MessageActivateWindow* message) override;
 	void handleMessage(MessageCloseProject* message) override;
+	void handleMessage(MessageIndexingFilesChanged* message) override;
 	void handleMessage(MessageIndexingFinished* message) override;
 	void handleMessage(MessageLoadProject* message) override;
 	void handleMessage(MessageRefresh* message) override;
@@ -12,6 +12,7 @@
 #include "ErrorView.h"
 #include "GraphController.h"
 #include "GraphView.h"
+#include "PrefetchController.h"
 #include "RefreshController.h"
 #include "RefreshView.h"
 #include "ScreenSearchController.h"
@@ -94,6 +95,15 @@ std::shared_ptr<Component> ComponentFactory::createGraphComponent(ViewLayout* vi
 	return std::make_shared<Component>(view, controller);
 }
 
+std::shared_ptr<Component> ComponentFactory::createPrefetchComponent(
+	const GraphController* graphController)
+{
+	std::shared_ptr<Controller> controller = std::make_shared<PrefetchController>(
+		m_storageAccess, graphController);
+
+	return std::make_shared<Component>(nullptr, controller);
+}
+
 std::shared_ptr<Component> ComponentFactory::createRefreshComponent(ViewLayout* viewLayout)
 {
 	std::shared_ptr<View> view = m_viewFactory->createRefreshView(viewLayout);
@@ -6,6 +6,7 @@
 #include "StorageAccess.h"
 
 class Component;
+class GraphController;
 class ViewFactory;
 class ViewLayout;
 class ScreenSearchSender;
@@ -24,6 +25,7 @@ public:
 	std::shared_ptr<Component> createCustomTrailComponent(ViewLayout* viewLayout);
 	std::shared_ptr<Component> createErrorComponent(ViewLayout* viewLayout);
 	std::shared_ptr<Component> createGraphComponent(ViewLayout* viewLayout);
+	std::shared_ptr<Component> createPrefetchComponent(const GraphController* graphController);
 	std::shared_ptr<Component> createRefreshComponent(ViewLayout* viewLayout);
 	std::shared_ptr<Component> createScreenSearchComponent(ViewLayout* viewLayout);
 	std::shared_ptr<Component> createSearchComponent(ViewLayout* viewLayout);
@@ -6,6 +6,7 @@
 #include "CompositeView.h"
 #include "Controller.h"
 #include "DialogView.h"
+#include "GraphController.h"
 #include "GraphView.h"
 #include "RefreshView.h"
 #include "ScreenSearchController.h"
@@ -165,6 +166,12 @@ void ComponentManager::setupTab(ViewLayout* viewLayout, Id tabId, ScreenSearchSe
 	codeComponent->setTabId(tabId);
 	m_components.push_back(codeComponent);
 
+	// created after the graph, so it handles activations after the graph got rebuilt
+	std::shared_ptr<Component> prefetchComponent = m_componentFactory.createPrefetchComponent(
+		graphComponent->getController<GraphController>());
+	prefetchComponent->setTabId(tabId);
+	m_components.push_back(prefetchComponent);
+
 	screenSearchSender->addResponder(graphComponent->getView<GraphView>());
 	screenSearchSender->addResponder(codeComponent->getView<CodeView>());
 }
@@ -58,6 +58,8 @@ public:
 
 	Id getSchedulerId() const override;
 
+	std::vector<Id> getExpandedNodeIds() const;
+
 private:
 	void handleMessage(MessageActivateErrors* message) override;
 	void handleMessage(MessageActivateFullTextSearch* message) override;
@@ -90,7 +92,6 @@ private:
 
 	void updateDummyNodeNamesAndAddQualifiers(const std::vector<std::shared_ptr<DummyNode>>& dummyNodes);
 
-	std::vector<Id> getExpandedNodeIds() const;
 	void setExpandedNodeIds(const std::vector<Id>& nodeIds);
 	void autoExpandActiveNode(const std::vector<Id>& activeTokenIds);
 
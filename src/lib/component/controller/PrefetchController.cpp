@@ -0,0 +1,212 @@
+#include "PrefetchController.h"
+
+#include <algorithm>
+#include <set>
+
+#include "CancellationToken.h"
+#include "Graph.h"
+#include "GraphController.h"
+#include "StorageAccess.h"
+#include "StorageCache.h"
+#include "ThreadPool.h"
+
+namespace
+{
+// neighbors are prefetched one after another, so only the first few are worth the queries
+const size_t s_maxNeighborCount = 5;
+
+// runs the same queries as the graph and the code view do for activated nodes
+void prefetchActivation(
+	const StorageAccess* storageAccess,
+	const std::vector<Id>& tokenIds,
+	std::shared_ptr<CancellationToken> token)
+{
+	storageAccess->getGraphForActiveTokenIds(tokenIds, {});
+
+	std::vector<Id> activeTokenIds;
+	for (const Id tokenId: tokenIds)
+	{
+		if (token->isCancelled())
+		{
+			return;
+		}
+
+		Id declarationId = 0;
+		const std::vector<Id> ids = storageAccess->getActiveTokenIdsForId(tokenId, &declarationId);
+		activeTokenIds.insert(activeTokenIds.end(), ids.begin(), ids.end());
+	}
+
+	if (!token->isCancelled())
+	{
+		storageAccess->getSourceLocationsForTokenIds(activeTokenIds);
+	}
+}
+
+std::vector<Id> getNeighborIds(std::shared_ptr<Graph> graph, const std::vector<Id>& activeTokenIds)
+{
+	const std::set<Id> activeIds(activeTokenIds.begin(), activeTokenIds.end());
+
+	std::vector<Id> neighborIds;
+	graph->forEachEdge([&activeIds, &neighborIds](Edge* edge) {
+		if (edge->isType(Edge::EDGE_MEMBER))
+		{
+			return;
+		}
+
+		// the neighbor is the side of the edge outside of the active symbols
+		for (Node* node: {edge->getFrom(), edge->getTo()})
+		{
+			if (neighborIds.size() < s_maxNeighborCount && !activeIds.count(node->getId()) &&
+				!activeIds.count(node->getLastParentNode()->getId()) &&
+				std::find(neighborIds.begin(), neighborIds.end(), node->getId()) ==
+					neighborIds.end())
+			{
+				neighborIds.push_back(node->getId());
+			}
+		}
+	});
+	return neighborIds;
+}
+}	 // namespace
+
+PrefetchController::PrefetchController(
+	StorageAccess* storageAccess, const GraphController* graphController)
+	: m_storageAccess(storageAccess), m_graphController(graphController)
+{
+}
+
+PrefetchController::~PrefetchController()
+{
+	clear();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_runningFinished.wait(lock, [this]() { return !m_isRunning; });
+}
+
+Id PrefetchController::getSchedulerId() const
+{
+	return Controller::getTabId();
+}
+
+void PrefetchController::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_cancellationToken)
+	{
+		m_cancellationToken->cancel();
+		m_cancellationToken.reset();
+	}
+	m_pendingPrefetch = nullptr;
+}
+
+void PrefetchController::handleMessage(MessageActivateTokens* message)
+{
+	clear();
+
+	if (message->isEdge || message->isAggregation || message->isReplayed() ||
+		message->tokenIds.empty() || hasExpandedNodes())
+	{
+		return;
+	}
+
+	const StorageAccess* storageAccess = m_storageAccess;
+	const std::vector<Id> activeTokenIds = message->tokenIds;
+	runInBackground([storageAccess, activeTokenIds](std::shared_ptr<CancellationToken> token) {
+		// usually answered by the cache, the graph view just asked for the same graph
+		std::shared_ptr<Graph> graph = storageAccess->getGraphForActiveTokenIds(
+			activeTokenIds, {});
+		if (!graph)
+		{
+			return;
+		}
+
+		for (const Id neighborId: getNeighborIds(graph, activeTokenIds))
+		{
+			if (token->isCancelled())
+			{
+				return;
+			}
+
+			prefetchActivation(storageAccess, {neighborId}, token);
+		}
+	});
+}
+
+void PrefetchController::handleMessage(MessageFocusIn* message)
+{
+	if (message->tokenIds.empty() || hasExpandedNodes())
+	{
+		return;
+	}
+
+	const StorageAccess* storageAccess = m_storageAccess;
+	const std::vector<Id> tokenIds = message->tokenIds;
+	runInBackground([storageAccess, tokenIds](std::shared_ptr<CancellationToken> token) {
+		// edges get activated without these queries
+		if (tokenIds.size() == 1 && storageAccess->getEdgeById(tokenIds[0]).id)
+		{
+			return;
+		}
+
+		prefetchActivation(storageAccess, tokenIds, token);
+	});
+}
+
+void PrefetchController::handleMessage(MessageIndexingFinished* message)
+{
+	clear();
+}
+
+void PrefetchController::handleMessage(MessageIndexingStarted* message)
+{
+	clear();
+}
+
+bool PrefetchController::hasExpandedNodes() const
+{
+	return m_graphController && !m_graphController->getExpandedNodeIds().empty();
+}
+
+void PrefetchController::runInBackground(PrefetchFunction prefetch)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_cancellationToken)
+	{
+		m_cancellationToken->cancel();
+	}
+	m_cancellationToken = std::make_shared<CancellationToken>();
+	m_pendingPrefetch = prefetch;
+
+	if (!m_isRunning)
+	{
+		m_isRunning = true;
+		ThreadPool::getInstance()->execute(
+			[this]() { runPendingPrefetches(); }, ThreadPool::PRIORITY_LOW);
+	}
+}
+
+void PrefetchController::runPendingPrefetches()
+{
+	// only the latest prefetch is pending, the ones replaced while a job ran are never started
+	while (true)
+	{
+		PrefetchFunction prefetch;
+		std::shared_ptr<CancellationToken> token;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_pendingPrefetch)
+			{
+				m_isRunning = false;
+				m_runningFinished.notify_all();
+				return;
+			}
+
+			prefetch = std::move(m_pendingPrefetch);
+			m_pendingPrefetch = nullptr;
+			token = m_cancellationToken;
+		}
+
+		StorageCache::ScopedPrefetch scopedPrefetch(token);
+		prefetch(token);
+	}
+}
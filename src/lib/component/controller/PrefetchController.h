@@ -0,0 +1,66 @@
+#ifndef PREFETCH_CONTROLLER_H
+#define PREFETCH_CONTROLLER_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "Controller.h"
+#include "MessageActivateTokens.h"
+#include "MessageFocusIn.h"
+#include "MessageIndexingFinished.h"
+#include "MessageIndexingStarted.h"
+#include "MessageListener.h"
+
+class CancellationToken;
+class GraphController;
+class StorageAccess;
+
+// Runs the queries of the likely next activation in the background while the user hovers tokens,
+// so their results are already in the StorageCache when the token gets clicked. After an
+// activation the first neighbors of the active symbols are prepared the same way. Pending
+// prefetches are cancelled as soon as the focus moves on. Each tab has its own prefetcher, which
+// runs at most one job at a time, so prefetches that outlived their cancellation don't pile up.
+class PrefetchController
+	: public Controller
+	, public MessageListener<MessageActivateTokens>
+	, public MessageListener<MessageFocusIn>
+	, public MessageListener<MessageIndexingFinished>
+	, public MessageListener<MessageIndexingStarted>
+{
+public:
+	PrefetchController(StorageAccess* storageAccess, const GraphController* graphController);
+	~PrefetchController();
+
+	Id getSchedulerId() const override;
+
+	void clear() override;
+
+private:
+	void handleMessage(MessageActivateTokens* message) override;
+	void handleMessage(MessageFocusIn* message) override;
+	void handleMessage(MessageIndexingFinished* message) override;
+	void handleMessage(MessageIndexingStarted* message) override;
+
+	// the graph of the next activation keeps the nodes expanded by the user, so a prefetch without
+	// them would never be used
+	bool hasExpandedNodes() const;
+
+	typedef std::function<void(std::shared_ptr<CancellationToken>)> PrefetchFunction;
+
+	// cancels the previous prefetch, the new one starts once the running job finished its query
+	void runInBackground(PrefetchFunction prefetch);
+	void runPendingPrefetches();
+
+	StorageAccess* m_storageAccess;
+	const GraphController* m_graphController;
+
+	std::shared_ptr<CancellationToken> m_cancellationToken;
+	PrefetchFunction m_pendingPrefetch;
+	bool m_isRunning = false;
+	std::mutex m_mutex;
+	std::condition_variable m_runningFinished;
+};
+
+#endif	  // PREFETCH_CONTROLLER_H
@@ -4,6 +4,7 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FilePath.h"
+#include "IndexingReport.h"
 #include "PersistentStorage.h"
 
 TaskCleanStorage::TaskCleanStorage(
@@ -58,6 +59,12 @@ void TaskCleanStorage::doExit(std::shared_ptr<Blackboard> blackboard)
 {
 	blackboard->set("clear_time", TimeStamp::durationSeconds(m_start));
 
+	std::shared_ptr<IndexingReport> report;
+	if (blackboard->get("indexing_report", report) && report)
+	{
+		report->addPhaseTime("clean", TimeStamp::now().deltaMS(m_start) * 1000);
+	}
+
 	m_dialogView->hideProgressDialog();
 }
 
@@ -2,6 +2,7 @@
 
 #include "Blackboard.h"
 #include "DialogView.h"
+#include "IndexingReport.h"
 #include "MessageIndexingFinished.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
@@ -32,8 +33,22 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 {
 	TimeStamp start = TimeStamp::now();
 
+	std::shared_ptr<IndexingReport> report;
+	blackboard->get("indexing_report", report);
+
+	bool interruptedIndexing = false;
+	blackboard->get("interrupted_indexing", interruptedIndexing);
+
 	m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Optimizing database");
-	m_storage->optimizeMemory();
+	{
+		IndexingReport::ScopedPhase phase(report.get(), "optimize database");
+		m_storage->optimizeMemory();
+	}
+	if (!interruptedIndexing)
+	{
+		// an interrupted run keeps its checkpoint, so the next refresh can continue it
+		m_storage->setIndexingCheckpoint("");
+	}
 	m_dialogView->hideUnknownProgressDialog();
 
 	float time = TimeStamp::durationSeconds(start);
@@ -50,6 +65,11 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 		float indexTime = 0;
 		blackboard->get("index_time", indexTime);
 		time += indexTime;
+
+		if (report)
+		{
+			report->addPhaseTime("index", (long long)(indexTime * 1000000));
+		}
 	}
 
 	int indexedSourceFileCount = 0;
@@ -58,9 +78,6 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 	int sourceFileCount = 0;
 	blackboard->get("source_file_count", sourceFileCount);
 
-	bool interruptedIndexing = false;
-	blackboard->get("interrupted_indexing", interruptedIndexing);
-
 	bool shallowIndexing = false;
 	blackboard->get("shallow_indexing", shallowIndexing);
 
@@ -79,6 +96,15 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
 	}
 	MessageStatus(status, false, false).dispatch();
 
+	if (report)
+	{
+		report->setValue("total_time_ms", size_t(time * 1000));
+		report->setValue("indexed_source_file_count", indexedSourceFileCount);
+		report->setValue("error_count", errorInfo.total);
+		report->setValue("fatal_error_count", errorInfo.fatal);
+		report->setValue("interrupted", interruptedIndexing);
+	}
+
 	StorageStats stats = m_storage->getStorageStats();
 	DatabasePolicy policy = m_dialogView->finishedIndexingDialog(
 		indexedSourceFileCount,
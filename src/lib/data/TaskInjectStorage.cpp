@@ -1,7 +1,10 @@
 #include "TaskInjectStorage.h"
 
+#include "Blackboard.h"
+#include "IndexingReport.h"
 #include "Storage.h"
 #include "StorageProvider.h"
+#include "tracing.h"
 
 TaskInjectStorage::TaskInjectStorage(
 	std::shared_ptr<StorageProvider> storageProvider, std::weak_ptr<Storage> target)
@@ -20,7 +23,13 @@ Task::TaskState TaskInjectStorage::doUpdate(std::shared_ptr<Blackboard> blackboa
 		{
 			if (std::shared_ptr<Storage> target = m_target.lock())
 			{
-				target->inject(source.get());
+				TRACE("inject storage");
+
+				std::shared_ptr<IndexingReport> report;
+				blackboard->get("indexing_report", report);
+
+				IndexingReport::ScopedPhase phase(report.get(), "inject");
+				target->inject(source.get(), report.get());
 				return STATE_SUCCESS;
 			}
 		}
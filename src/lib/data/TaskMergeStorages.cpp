@@ -1,6 +1,9 @@
 #include "TaskMergeStorages.h"
 
+#include "Blackboard.h"
+#include "IndexingReport.h"
 #include "StorageProvider.h"
+#include "tracing.h"
 
 TaskMergeStorages::TaskMergeStorages(std::shared_ptr<StorageProvider> storageProvider)
 	: m_storageProvider(storageProvider)
@@ -11,12 +14,24 @@ void TaskMergeStorages::doEnter(std::shared_ptr<Blackboard> blackboard) {}
 
 Task::TaskState TaskMergeStorages::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
+	// merging doesn't free any memory, so leave the queued storages to injection instead
+	if (m_storageProvider->isMemoryBudgetExceeded())
+	{
+		return STATE_FAILURE;
+	}
+
 	if (m_storageProvider->getStorageCount() > 2)	 // largest storage won't be touched here
 	{
 		std::shared_ptr<IntermediateStorage> target = m_storageProvider->consumeSecondLargestStorage();
 		std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeSecondLargestStorage();
 		if (target && source)
 		{
+			TRACE("merge storages");
+
+			std::shared_ptr<IndexingReport> report;
+			blackboard->get("indexing_report", report);
+
+			IndexingReport::ScopedPhase phase(report.get(), "merge");
 			target->inject(source.get());
 			m_storageProvider->insert(target);
 			return STATE_SUCCESS;
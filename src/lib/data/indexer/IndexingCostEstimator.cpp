@@ -0,0 +1,98 @@
+#include "IndexingCostEstimator.h"
+
+#include <algorithm>
+
+#include "FileSystem.h"
+#include "logging.h"
+
+namespace
+{
+// number of history entries used to calibrate the estimate for files without history
+const size_t s_calibrationSampleCount = 64;
+}	 // namespace
+
+IndexingCostEstimator::IndexingCostEstimator(const std::vector<StorageIndexingCost>& history)
+	: m_msPerFallbackWeight(1.0)
+{
+	for (const StorageIndexingCost& cost: history)
+	{
+		m_wallTimesMs[FilePath(cost.filePath)] = cost.wallTimeMs;
+	}
+
+	size_t sampledTimeMs = 0;
+	size_t sampledWeight = 0;
+	size_t sampleCount = 0;
+	for (const StorageIndexingCost& cost: history)
+	{
+		if (sampleCount >= s_calibrationSampleCount)
+		{
+			break;
+		}
+
+		const size_t weight = getFallbackWeight(FilePath(cost.filePath));
+		if (weight > 0)
+		{
+			sampledTimeMs += cost.wallTimeMs;
+			sampledWeight += weight;
+			sampleCount++;
+		}
+	}
+
+	if (sampledWeight > 0 && sampledTimeMs > 0)
+	{
+		m_msPerFallbackWeight = double(sampledTimeMs) / sampledWeight;
+	}
+
+	LOG_INFO(
+		"Estimating indexing cost from " + std::to_string(m_wallTimesMs.size()) +
+		" recorded source files");
+}
+
+double IndexingCostEstimator::getEstimatedCost(const FilePath& sourceFilePath) const
+{
+	std::map<FilePath, size_t>::const_iterator it = m_wallTimesMs.find(sourceFilePath);
+	if (it != m_wallTimesMs.end())
+	{
+		return it->second;
+	}
+
+	return getFallbackWeight(sourceFilePath) * m_msPerFallbackWeight;
+}
+
+std::vector<FilePath> IndexingCostEstimator::sortByEstimatedCost(
+	const std::vector<FilePath>& sourceFilePaths) const
+{
+	typedef std::pair<double, FilePath> PairType;
+	std::vector<PairType> costsToPaths;
+	costsToPaths.reserve(sourceFilePaths.size());
+
+	for (const FilePath& path: sourceFilePaths)
+	{
+		costsToPaths.emplace_back(getEstimatedCost(path), path);
+	}
+
+	std::stable_sort(
+		costsToPaths.begin(), costsToPaths.end(), [](const PairType& p, const PairType& q) {
+			return p.first > q.first;
+		});
+
+	std::vector<FilePath> sortedPaths;
+	sortedPaths.reserve(costsToPaths.size());
+	for (const PairType& pair: costsToPaths)
+	{
+		sortedPaths.push_back(pair.second);
+	}
+	return sortedPaths;
+}
+
+size_t IndexingCostEstimator::getFallbackWeight(const FilePath& sourceFilePath)
+{
+	// only the file size is used, reading the files would be an extra pass over the whole source
+	// tree before the first translation unit gets indexed
+	if (!sourceFilePath.exists())
+	{
+		return 1;
+	}
+
+	return size_t(FileSystem::getFileByteSize(sourceFilePath));
+}
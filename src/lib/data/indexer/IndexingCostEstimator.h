@@ -0,0 +1,30 @@
+#ifndef INDEXING_COST_ESTIMATOR_H
+#define INDEXING_COST_ESTIMATOR_H
+
+#include <map>
+#include <vector>
+
+#include "FilePath.h"
+#include "StorageIndexingCost.h"
+
+// Estimates how long indexing a source file will take, based on the wall times recorded during
+// previous indexing runs. Files without history are estimated from their size.
+class IndexingCostEstimator
+{
+public:
+	IndexingCostEstimator(const std::vector<StorageIndexingCost>& history);
+
+	double getEstimatedCost(const FilePath& sourceFilePath) const;
+
+	// returns the paths ordered by descending estimated cost, so that the slowest translation
+	// units are handed to the indexers first and don't end up running alone at the end
+	std::vector<FilePath> sortByEstimatedCost(const std::vector<FilePath>& sourceFilePaths) const;
+
+private:
+	static size_t getFallbackWeight(const FilePath& sourceFilePath);
+
+	std::map<FilePath, size_t> m_wallTimesMs;
+	double m_msPerFallbackWeight;
+};
+
+#endif	  // INDEXING_COST_ESTIMATOR_H
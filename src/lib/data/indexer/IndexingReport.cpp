@@ -0,0 +1,161 @@
+#include "IndexingReport.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "FilePath.h"
+#include "logging.h"
+#include "utility.h"
+
+IndexingReport::ScopedPhase::ScopedPhase(IndexingReport* report, const char* phaseName)
+	: m_report(report), m_phaseName(phaseName), m_start(std::chrono::steady_clock::now())
+{
+}
+
+IndexingReport::ScopedPhase::~ScopedPhase()
+{
+	if (m_report)
+	{
+		m_report->addPhaseTime(
+			m_phaseName,
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - m_start)
+				.count());
+	}
+}
+
+void IndexingReport::addPhaseTime(const std::string& phaseName, long long microseconds)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Phase& phase = m_phases[phaseName];
+	phase.microseconds += microseconds;
+	phase.count++;
+}
+
+void IndexingReport::addValue(const std::string& name, size_t value)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_values[name] += value;
+}
+
+void IndexingReport::setValue(const std::string& name, size_t value)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_values[name] = value;
+}
+
+void IndexingReport::setMaxValue(const std::string& name, size_t value)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t& maxValue = m_values[name];
+	maxValue = std::max(maxValue, value);
+}
+
+void IndexingReport::addProcessValue(int processId, const std::string& name, size_t value)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_processValues[processId][name] += value;
+}
+
+void IndexingReport::setMaxProcessValue(int processId, const std::string& name, size_t value)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t& maxValue = m_processValues[processId][name];
+	maxValue = std::max(maxValue, value);
+}
+
+void IndexingReport::addTranslationUnits(const std::vector<StorageIndexingCost>& costs)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	utility::append(m_translationUnits, costs);
+}
+
+std::string IndexingReport::toJson() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	QJsonObject phases;
+	for (const auto& p: m_phases)
+	{
+		QJsonObject phase;
+		phase["time_ms"] = double(p.second.microseconds) / 1000.0;
+		phase["count"] = double(p.second.count);
+		phases[QString::fromStdString(p.first)] = phase;
+	}
+
+	QJsonObject values;
+	for (const auto& p: m_values)
+	{
+		values[QString::fromStdString(p.first)] = double(p.second);
+	}
+
+	QJsonObject processes;
+	for (const auto& p: m_processValues)
+	{
+		QJsonObject process;
+		for (const auto& value: p.second)
+		{
+			process[QString::fromStdString(value.first)] = double(value.second);
+		}
+		processes[QString::number(p.first)] = process;
+	}
+
+	// slowest translation units first, which are the interesting ones when tuning
+	std::vector<StorageIndexingCost> translationUnits = m_translationUnits;
+	std::sort(
+		translationUnits.begin(),
+		translationUnits.end(),
+		[](const StorageIndexingCost& a, const StorageIndexingCost& b) {
+			return a.wallTimeMs > b.wallTimeMs;
+		});
+
+	size_t parseTimeMs = 0;
+	QJsonArray translationUnitArray;
+	for (const StorageIndexingCost& cost: translationUnits)
+	{
+		QJsonObject translationUnit;
+		translationUnit["path"] = QString::fromStdWString(cost.filePath);
+		translationUnit["time_ms"] = double(cost.wallTimeMs);
+		if (cost.peakMemoryBytes)
+		{
+			// not measured for indexers running as threads of the app
+			translationUnit["peak_memory_bytes"] = double(cost.peakMemoryBytes);
+		}
+		translationUnit["storage_bytes"] = double(cost.storageByteSize);
+		translationUnitArray.append(translationUnit);
+
+		parseTimeMs += cost.wallTimeMs;
+	}
+
+	QJsonObject parse;
+	parse["time_ms"] = double(parseTimeMs);
+	parse["count"] = double(translationUnits.size());
+	phases["parse"] = parse;
+
+	QJsonObject report;
+	report["phases"] = phases;
+	report["values"] = values;
+	report["processes"] = processes;
+	report["translation_units"] = translationUnitArray;
+
+	return QJsonDocument(report).toJson(QJsonDocument::Indented).toStdString();
+}
+
+bool IndexingReport::exportJson(const FilePath& filePath) const
+{
+	std::ofstream reportFile(filePath.str());
+	if (reportFile.fail())
+	{
+		LOG_ERROR(L"Could not write indexing report " + filePath.wstr());
+		return false;
+	}
+
+	reportFile << toJson();
+
+	LOG_INFO(L"Wrote indexing report " + filePath.wstr());
+	return true;
+}
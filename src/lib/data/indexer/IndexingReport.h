@@ -0,0 +1,62 @@
+#ifndef INDEXING_REPORT_H
+#define INDEXING_REPORT_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "StorageIndexingCost.h"
+
+class FilePath;
+
+// Timings and statistics of a single indexing run. Phases accumulate the time of all their
+// executions, values hold counters, byte sizes and queue depths. Process values are kept per
+// indexer process, with process id 0 being the app. All methods can be called from any thread.
+class IndexingReport
+{
+public:
+	// measures the time until destruction, does nothing if no report is passed
+	class ScopedPhase
+	{
+	public:
+		ScopedPhase(IndexingReport* report, const char* phaseName);
+		~ScopedPhase();
+
+	private:
+		IndexingReport* const m_report;
+		const char* const m_phaseName;
+		const std::chrono::steady_clock::time_point m_start;
+	};
+
+	void addPhaseTime(const std::string& phaseName, long long microseconds);
+
+	void addValue(const std::string& name, size_t value);
+	void setValue(const std::string& name, size_t value);
+	void setMaxValue(const std::string& name, size_t value);
+
+	void addProcessValue(int processId, const std::string& name, size_t value);
+	void setMaxProcessValue(int processId, const std::string& name, size_t value);
+
+	void addTranslationUnits(const std::vector<StorageIndexingCost>& costs);
+
+	std::string toJson() const;
+	bool exportJson(const FilePath& filePath) const;
+
+private:
+	struct Phase
+	{
+		long long microseconds = 0;
+		size_t count = 0;
+	};
+
+	std::map<std::string, Phase> m_phases;
+	std::map<std::string, size_t> m_values;
+	std::map<int, std::map<std::string, size_t>> m_processValues;
+	std::vector<StorageIndexingCost> m_translationUnits;
+
+	mutable std::mutex m_mutex;
+};
+
+#endif	  // INDEXING_REPORT_H
@@ -4,14 +4,19 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FileLogger.h"
+#include "IndexingReport.h"
 #include "InterprocessIndexer.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
 #include "ParserClientImpl.h"
 #include "StorageProvider.h"
 #include "TimeStamp.h"
+#include "FileSystem.h"
 #include "UserPaths.h"
+#include "tracing.h"
 #include "utilityApp.h"
+#include "utilityMemory.h"
+#include "utilityString.h"
 
 
 #if _WIN32
@@ -34,6 +39,7 @@ TaskBuildIndex::TaskBuildIndex(
 	, m_indexerCommandQueueStopped(false)
 	, m_processCount(processCount)
 	, m_interrupted(false)
+	, m_indexingPaused(false)
 	, m_indexingFileCount(0)
 	, m_runningThreadCount(0)
 {
@@ -42,6 +48,11 @@ TaskBuildIndex::TaskBuildIndex(
 void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
 	m_interprocessIndexingStatusManager.setIndexingInterrupted(false);
+	m_interprocessIndexingStatusManager.setIndexingPaused(false);
+	m_interprocessIndexingStatusManager.setTracingEnabled(Tracer::isEnabled());
+	m_indexingPaused = false;
+
+	blackboard->get("indexing_report", m_report);
 
 	m_indexingFileCount = 0;
 	updateIndexingDialog(blackboard, std::vector<FilePath>());
@@ -98,6 +109,16 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 		updateIndexingDialog(blackboard, indexingFiles);
 	}
 
+	m_storageProvider->insertIndexingCosts(m_interprocessIndexingStatusManager.getIndexingCosts());
+
+	if (m_report)
+	{
+		// indexer threads run within the app process when multi process indexing is disabled
+		m_report->setMaxProcessValue(0, "peak_memory_bytes", utility::getResidentMemoryUsage());
+	}
+
+	updateIndexingPaused();
+
 	if (m_indexerCommandQueueStopped && runningThreadCount == 0)
 	{
 		LOG_INFO_STREAM(<< "command queue stopped and no running threads. done.");
@@ -129,12 +150,39 @@ void TaskBuildIndex::doExit(std::shared_ptr<Blackboard> blackboard)
 	}
 	m_processThreads.clear();
 
+	if (m_multiProcessIndexing && Tracer::isEnabled())
+	{
+		importIndexerTraces();
+	}
+
 	if (!m_interrupted)
 	{
 		while (fetchIntermediateStorages(blackboard))
 			;
 	}
 
+	m_storageProvider->insertIndexingCosts(m_interprocessIndexingStatusManager.getIndexingCosts());
+
+	if (m_report)
+	{
+		for (const auto& p: m_interprocessIndexingStatusManager.getIndexerProcessStatistics())
+		{
+			const int processId = static_cast<int>(p.first);
+			const IndexerProcessStatistics& statistics = p.second;
+			m_report->addProcessValue(
+				processId, "pushed_storage_count", statistics.pushedStorageCount);
+			m_report->addProcessValue(
+				processId, "pushed_storage_bytes", statistics.pushedStorageByteSize);
+			m_report->addProcessValue(processId, "push_time_ms", statistics.pushTimeMs);
+			if (statistics.peakMemoryBytes)
+			{
+				m_report->setMaxProcessValue(
+					processId, "peak_memory_bytes", statistics.peakMemoryBytes);
+			}
+			m_report->addValue("shared_memory_bytes", statistics.pushedStorageByteSize);
+		}
+	}
+
 	std::vector<FilePath> crashedFiles =
 		m_interprocessIndexingStatusManager.getCrashedSourceFilePaths();
 	if (!crashedFiles.empty())
@@ -225,7 +273,7 @@ void TaskBuildIndex::runIndexerThread(int processId)
 {
 	do
 	{
-		InterprocessIndexer indexer(m_appUUID, processId);
+		InterprocessIndexer indexer(m_appUUID, processId, false);
 		indexer.work();	   // this will only return if there are no indexer commands left in the queue
 		if (!m_interrupted)
 		{
@@ -241,6 +289,20 @@ void TaskBuildIndex::runIndexerThread(int processId)
 	}
 }
 
+void TaskBuildIndex::importIndexerTraces()
+{
+	const std::wstring prefix = InterprocessIndexer::getTraceFileNamePrefix(m_appUUID);
+	for (const FilePath& traceFilePath:
+		 FileSystem::getFilePathsFromDirectory(UserPaths::getLogPath(), {L".json"}))
+	{
+		if (utility::isPrefix<std::wstring>(prefix, traceFilePath.fileName()))
+		{
+			Tracer::getInstance()->importTrace(traceFilePath);
+			FileSystem::remove(traceFilePath);
+		}
+	}
+}
+
 bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard)
 {
 	int poppedStorageCount = 0;
@@ -255,6 +317,19 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 		return true;
 	}
 
+	if (m_storageProvider->isMemoryBudgetExceeded())
+	{
+		// storages remain in the shared memory of the indexers, which stop producing new ones
+		// when they have too many of them queued up
+		LOG_INFO_STREAM(
+			<< "waiting, queued storages exceed memory budget: "
+			<< m_storageProvider->getByteSize() / 1048576 << " MB");
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		return true;
+	}
+
 	TimeStamp t = TimeStamp::now();
 	do
 	{
@@ -275,7 +350,10 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 		}
 
 		LOG_INFO_STREAM(<< storageManager->getProcessId() << " - storage count: " << storageCount);
-		m_storageProvider->insert(storageManager->popIntermediateStorage());
+		{
+			IndexingReport::ScopedPhase phase(m_report.get(), "pop intermediate storage");
+			m_storageProvider->insert(storageManager->popIntermediateStorage());
+		}
 		poppedStorageCount++;
 	} while (TimeStamp::now().deltaMS(t) <
 			 500);	  // don't process all storages at once to allow for status updates in-between
@@ -290,6 +368,29 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 	return false;
 }
 
+void TaskBuildIndex::updateIndexingPaused()
+{
+	const size_t memoryBudget = m_storageProvider->getMemoryBudget();
+	if (!memoryBudget)
+	{
+		return;
+	}
+
+	// resume below the budget to not toggle the indexers for every single injected storage
+	const size_t byteSize = m_storageProvider->getByteSize();
+	const bool paused = m_indexingPaused ? byteSize > memoryBudget / 4 * 3
+										 : byteSize >= memoryBudget;
+	if (paused != m_indexingPaused)
+	{
+		LOG_INFO_STREAM(
+			<< (paused ? "pausing" : "resuming") << " indexers, queued storages use "
+			<< byteSize / 1048576 << " MB of " << memoryBudget / 1048576 << " MB");
+
+		m_interprocessIndexingStatusManager.setIndexingPaused(paused);
+		m_indexingPaused = paused;
+	}
+}
+
 void TaskBuildIndex::updateIndexingDialog(
 	std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths)
 {
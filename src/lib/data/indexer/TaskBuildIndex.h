@@ -12,6 +12,7 @@
 #include "InterprocessIntermediateStorageManager.h"
 
 class DialogView;
+class IndexingReport;
 class StorageProvider;
 class IndexerCommandList;
 
@@ -38,7 +39,9 @@ protected:
 
 	void runIndexerProcess(int processId, const std::wstring& logFilePath);
 	void runIndexerThread(int processId);
+	void importIndexerTraces();
 	bool fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard);
+	void updateIndexingPaused();
 	void updateIndexingDialog(
 		std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths);
 
@@ -47,6 +50,7 @@ protected:
 	std::shared_ptr<IndexerCommandList> m_indexerCommandList;
 	std::shared_ptr<StorageProvider> m_storageProvider;
 	std::shared_ptr<DialogView> m_dialogView;
+	std::shared_ptr<IndexingReport> m_report;
 	const std::string m_appUUID;
 	bool m_multiProcessIndexing;
 
@@ -54,6 +58,7 @@ protected:
 	bool m_indexerCommandQueueStopped;
 	size_t m_processCount;
 	bool m_interrupted;
+	bool m_indexingPaused;
 	size_t m_indexingFileCount;
 
 	// store as plain pointers to avoid deallocation issues when closing app during indexing
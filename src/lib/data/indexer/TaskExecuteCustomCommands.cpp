@@ -111,15 +111,9 @@ Task::TaskState TaskExecuteCustomCommands::doUpdate(std::shared_ptr<Blackboard>
 		PersistentStorage targetStorage(m_targetDatabaseFilePath, FilePath());
 		targetStorage.setup();
 		targetStorage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
-		targetStorage.buildCaches();
 		for (const FilePath& sourceDatabaseFilePath: m_sourceDatabaseFilePaths)
 		{
-			{
-				PersistentStorage sourceStorage(sourceDatabaseFilePath, FilePath());
-				sourceStorage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
-				sourceStorage.buildCaches();
-				targetStorage.inject(&sourceStorage);
-			}
+			targetStorage.injectDatabase(sourceDatabaseFilePath);
 			FileSystem::remove(sourceDatabaseFilePath);
 		}
 
@@ -201,7 +195,6 @@ void TaskExecuteCustomCommands::executeParallelIndexerCommands(
 				PersistentStorage sourceStorage(databaseFilePath, FilePath());
 				sourceStorage.setup();
 				sourceStorage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
-				sourceStorage.buildCaches();
 			}
 
 			indexerCommand->setDatabaseFilePath(databaseFilePath);
@@ -3,25 +3,32 @@
 #include "Blackboard.h"
 #include "FileSystem.h"
 #include "IndexerCommandProvider.h"
+#include "IndexingCostEstimator.h"
 #include "logging.h"
-#include "utilityFile.h"
 
 TaskFillIndexerCommandsQueue::TaskFillIndexerCommandsQueue(
 	const std::string& appUUID,
 	std::unique_ptr<IndexerCommandProvider> indexerCommandProvider,
-	size_t maximumQueueSize)
+	size_t maximumQueueSize,
+	std::vector<StorageIndexingCost> indexingCostHistory)
 	: m_indexerCommandProvider(std::move(indexerCommandProvider))
 	, m_indexerCommandManager(appUUID, 0, true)
 	, m_maximumQueueSize(maximumQueueSize)
+	, m_indexingCostHistory(std::move(indexingCostHistory))
 {
 }
 
 void TaskFillIndexerCommandsQueue::doEnter(std::shared_ptr<Blackboard> blackboard)
 {
 	{
+		// schedule the translation units that took longest during previous runs first, since the
+		// indexer processes pull their commands from a shared queue this also balances the load
+		const IndexingCostEstimator estimator(m_indexingCostHistory);
+		m_indexingCostHistory.clear();
+
 		std::lock_guard<std::mutex> lock(m_commandsMutex);
 		for (const FilePath& filePath:
-			 utility::partitionFilePathsBySize(m_indexerCommandProvider->getAllSourceFilePaths(), 2))
+			 estimator.sortByEstimatedCost(m_indexerCommandProvider->getAllSourceFilePaths()))
 		{
 			m_filePathQueue.emplace(filePath);
 		}
@@ -8,6 +8,7 @@
 #include "Task.h"
 
 #include "InterprocessIndexerCommandManager.h"
+#include "StorageIndexingCost.h"
 
 class IndexerCommandProvider;
 
@@ -19,7 +20,8 @@ public:
 	TaskFillIndexerCommandsQueue(
 		const std::string& appUUID,
 		std::unique_ptr<IndexerCommandProvider> indexerCommandProvider,
-		size_t maximumQueueSize);
+		size_t maximumQueueSize,
+		std::vector<StorageIndexingCost> indexingCostHistory = std::vector<StorageIndexingCost>());
 
 protected:
 	void doEnter(std::shared_ptr<Blackboard> blackboard) override;
@@ -37,6 +39,7 @@ private:
 	InterprocessIndexerCommandManager m_indexerCommandManager;
 
 	const size_t m_maximumQueueSize;
+	std::vector<StorageIndexingCost> m_indexingCostHistory;
 
 	std::queue<FilePath> m_filePathQueue;
 	std::mutex m_commandsMutex;
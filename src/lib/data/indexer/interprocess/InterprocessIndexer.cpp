@@ -3,16 +3,29 @@
 #include "FileRegister.h"
 #include "IndexerCommand.h"
 #include "IndexerComposite.h"
+#include "IntermediateStorage.h"
 #include "LanguagePackageManager.h"
 #include "ScopedFunctor.h"
+#include "TimeStamp.h"
+#include "UserPaths.h"
 #include "logging.h"
+#include "tracing.h"
+#include "utilityMemory.h"
+#include "utilityString.h"
 
-InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId)
+std::wstring InterprocessIndexer::getTraceFileNamePrefix(const std::string& uuid)
+{
+	return L"trace_" + utility::decodeFromUtf8(uuid) + L"_";
+}
+
+InterprocessIndexer::InterprocessIndexer(
+	const std::string& uuid, Id processId, bool runsInOwnProcess)
 	: m_interprocessIndexerCommandManager(uuid, processId, false)
 	, m_interprocessIndexingStatusManager(uuid, processId, false)
 	, m_interprocessIntermediateStorageManager(uuid, processId, false)
 	, m_uuid(uuid)
 	, m_processId(processId)
+	, m_runsInOwnProcess(runsInOwnProcess)
 {
 }
 
@@ -53,9 +66,26 @@ void InterprocessIndexer::work()
 			}
 		});
 
-		while (std::shared_ptr<IndexerCommand> indexerCommand =
-				   m_interprocessIndexerCommandManager.popIndexerCommand())
+		while (updaterThreadRunning)
 		{
+			if (m_interprocessIndexingStatusManager.getIndexingPaused())
+			{
+				LOG_INFO_STREAM(<< m_processId << " waits, indexing paused due to memory budget");
+				while (updaterThreadRunning &&
+					   m_interprocessIndexingStatusManager.getIndexingPaused())
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(200));
+				}
+				continue;
+			}
+
+			std::shared_ptr<IndexerCommand> indexerCommand =
+				m_interprocessIndexerCommandManager.popIndexerCommand();
+			if (!indexerCommand)
+			{
+				break;
+			}
+
 			LOG_INFO_STREAM(
 				<< m_processId << " fetched indexer command for \""
 				<< indexerCommand->getSourceFilePath().str() << "\"");
@@ -87,12 +117,41 @@ void InterprocessIndexer::work()
 				indexerCommand->getSourceFilePath());
 
 			LOG_INFO_STREAM(<< m_processId << " starting to index current file");
-			std::shared_ptr<IntermediateStorage> result = indexer->index(indexerCommand);
+			if (m_runsInOwnProcess)
+			{
+				utility::resetPeakMemoryUsage();
+			}
+			const TimeStamp indexingStart = TimeStamp::now();
+
+			std::shared_ptr<IntermediateStorage> result;
+			{
+				TRACE("index source file");
+				result = indexer->index(indexerCommand);
+			}
 
 			if (result)
 			{
+				// peak memory is tracked per process, so it would include the whole app and all
+				// other indexer threads when multi process indexing is disabled
+				const size_t peakMemoryBytes =
+					m_runsInOwnProcess ? utility::getPeakMemoryUsage() : 0;
+				const size_t storageByteSize = result->getByteSize(sizeof(std::string));
+				m_interprocessIndexingStatusManager.addIndexingCost(StorageIndexingCost(
+					indexerCommand->getSourceFilePath().wstr(),
+					TimeStamp::now().deltaMS(indexingStart),
+					peakMemoryBytes,
+					storageByteSize));
+
 				LOG_INFO_STREAM(<< m_processId << " pushing index to shared memory");
+				const TimeStamp pushStart = TimeStamp::now();
 				m_interprocessIntermediateStorageManager.pushIntermediateStorage(result);
+
+				IndexerProcessStatistics statistics;
+				statistics.pushedStorageCount = 1;
+				statistics.pushedStorageByteSize = storageByteSize;
+				statistics.pushTimeMs = TimeStamp::now().deltaMS(pushStart);
+				statistics.peakMemoryBytes = peakMemoryBytes;
+				m_interprocessIndexingStatusManager.addIndexerProcessStatistics(statistics);
 			}
 
 			LOG_INFO_STREAM(<< m_processId << " finalizing indexer status for current file");
@@ -118,3 +177,16 @@ void InterprocessIndexer::work()
 
 	LOG_INFO_STREAM(<< m_processId << " shutting down indexer");
 }
+
+bool InterprocessIndexer::getTracingEnabled()
+{
+	return m_interprocessIndexingStatusManager.getTracingEnabled();
+}
+
+void InterprocessIndexer::exportTrace() const
+{
+	// processes get restarted after crashes, so every run writes its own file
+	Tracer::getInstance()->exportTrace(UserPaths::getLogPath().concatenate(
+		getTraceFileNamePrefix(m_uuid) + std::to_wstring(m_processId) + L"_" +
+		std::to_wstring(Tracer::getMicroseconds()) + L".json"));
+}
@@ -8,10 +8,17 @@
 class InterprocessIndexer
 {
 public:
-	InterprocessIndexer(const std::string& uuid, Id processId);
+	// indexer processes write their traces to the log directory, where the app picks them up
+	static std::wstring getTraceFileNamePrefix(const std::string& uuid);
+
+	// indexers running as threads of the app share its process, so their memory can't be measured
+	InterprocessIndexer(const std::string& uuid, Id processId, bool runsInOwnProcess);
 
 	void work();
 
+	bool getTracingEnabled();
+	void exportTrace() const;
+
 private:
 	InterprocessIndexerCommandManager m_interprocessIndexerCommandManager;
 	InterprocessIndexingStatusManager m_interprocessIndexingStatusManager;
@@ -19,6 +26,7 @@ private:
 
 	const std::string m_uuid;
 	const Id m_processId;
+	const bool m_runsInOwnProcess;
 };
 
 #endif	  // INTERPROCESS_INDEXER_H
@@ -1,5 +1,8 @@
 #include "InterprocessIndexingStatusManager.h"
 
+#include <algorithm>
+
+#include "SharedStorageTypes.h"
 #include "logging.h"
 #include "utilityString.h"
 
@@ -11,6 +14,10 @@ const char* InterprocessIndexingStatusManager::s_crashedFilesKeyName = "crashed_
 const char* InterprocessIndexingStatusManager::s_finishedProcessIdsKeyName = "finished_process_ids";
 const char* InterprocessIndexingStatusManager::s_indexingInterruptedKeyName =
 	"indexing_interrupted_flag";
+const char* InterprocessIndexingStatusManager::s_indexingPausedKeyName = "indexing_paused_flag";
+const char* InterprocessIndexingStatusManager::s_tracingEnabledKeyName = "tracing_enabled_flag";
+const char* InterprocessIndexingStatusManager::s_indexingCostsKeyName = "indexing_costs";
+const char* InterprocessIndexingStatusManager::s_processStatisticsKeyName = "process_statistics";
 
 InterprocessIndexingStatusManager::InterprocessIndexingStatusManager(
 	const std::string& instanceUuid, Id processId, bool isOwner)
@@ -107,6 +114,89 @@ void InterprocessIndexingStatusManager::finishIndexingSourceFile()
 	}
 }
 
+void InterprocessIndexingStatusManager::addIndexingCost(const StorageIndexingCost& cost)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t estimatedSize = (sizeof(SharedStorageIndexingCost) + cost.filePath.size() * 4) * 2;
+	if (access.getFreeMemorySize() < estimatedSize)
+	{
+		access.growMemory(access.getMemorySize());
+	}
+
+	SharedMemory::Queue<SharedStorageIndexingCost>* indexingCostsPtr =
+		access.accessValueWithAllocator<SharedMemory::Queue<SharedStorageIndexingCost>>(
+			s_indexingCostsKeyName);
+	if (indexingCostsPtr)
+	{
+		indexingCostsPtr->push_back(toShared(cost, access.getAllocator()));
+	}
+}
+
+std::vector<StorageIndexingCost> InterprocessIndexingStatusManager::getIndexingCosts()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	std::vector<StorageIndexingCost> costs;
+
+	SharedMemory::Queue<SharedStorageIndexingCost>* indexingCostsPtr =
+		access.accessValueWithAllocator<SharedMemory::Queue<SharedStorageIndexingCost>>(
+			s_indexingCostsKeyName);
+	if (indexingCostsPtr)
+	{
+		while (indexingCostsPtr->size())
+		{
+			costs.push_back(fromShared(indexingCostsPtr->front()));
+			indexingCostsPtr->pop_front();
+		}
+	}
+
+	return costs;
+}
+
+void InterprocessIndexingStatusManager::addIndexerProcessStatistics(
+	const IndexerProcessStatistics& statistics)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t estimatedSize = sizeof(IndexerProcessStatistics) * 4;
+	if (access.getFreeMemorySize() < estimatedSize)
+	{
+		access.growMemory(access.getMemorySize());
+	}
+
+	SharedMemory::Map<Id, IndexerProcessStatistics>* processStatisticsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<Id, IndexerProcessStatistics>>(
+			s_processStatisticsKeyName);
+	if (processStatisticsPtr)
+	{
+		IndexerProcessStatistics& accumulated = (*processStatisticsPtr)[getProcessId()];
+		accumulated.pushedStorageCount += statistics.pushedStorageCount;
+		accumulated.pushedStorageByteSize += statistics.pushedStorageByteSize;
+		accumulated.pushTimeMs += statistics.pushTimeMs;
+		accumulated.peakMemoryBytes = std::max(
+			accumulated.peakMemoryBytes, statistics.peakMemoryBytes);
+	}
+}
+
+std::map<Id, IndexerProcessStatistics> InterprocessIndexingStatusManager::
+	getIndexerProcessStatistics()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	std::map<Id, IndexerProcessStatistics> processStatistics;
+
+	SharedMemory::Map<Id, IndexerProcessStatistics>* processStatisticsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<Id, IndexerProcessStatistics>>(
+			s_processStatisticsKeyName);
+	if (processStatisticsPtr)
+	{
+		processStatistics.insert(processStatisticsPtr->begin(), processStatisticsPtr->end());
+	}
+
+	return processStatistics;
+}
+
 void InterprocessIndexingStatusManager::setIndexingInterrupted(bool interrupted)
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
@@ -131,6 +221,54 @@ bool InterprocessIndexingStatusManager::getIndexingInterrupted()
 	return false;
 }
 
+void InterprocessIndexingStatusManager::setIndexingPaused(bool paused)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* indexingPausedPtr = access.accessValue<bool>(s_indexingPausedKeyName);
+	if (indexingPausedPtr)
+	{
+		*indexingPausedPtr = paused;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getIndexingPaused()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* indexingPausedPtr = access.accessValue<bool>(s_indexingPausedKeyName);
+	if (indexingPausedPtr)
+	{
+		return *indexingPausedPtr;
+	}
+
+	return false;
+}
+
+void InterprocessIndexingStatusManager::setTracingEnabled(bool enabled)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* tracingEnabledPtr = access.accessValue<bool>(s_tracingEnabledKeyName);
+	if (tracingEnabledPtr)
+	{
+		*tracingEnabledPtr = enabled;
+	}
+}
+
+bool InterprocessIndexingStatusManager::getTracingEnabled()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	bool* tracingEnabledPtr = access.accessValue<bool>(s_tracingEnabledKeyName);
+	if (tracingEnabledPtr)
+	{
+		return *tracingEnabledPtr;
+	}
+
+	return false;
+}
+
 Id InterprocessIndexingStatusManager::getNextFinishedProcessId()
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
@@ -1,10 +1,21 @@
 #ifndef INTERPROCESS_INDEXING_STATUS_MANAGER_H
 #define INTERPROCESS_INDEXING_STATUS_MANAGER_H
 
+#include <map>
 #include <set>
 
 #include "BaseInterprocessDataManager.h"
 #include "FilePath.h"
+#include "StorageIndexingCost.h"
+
+// accumulated over all source files an indexer process has indexed during the current run
+struct IndexerProcessStatistics
+{
+	size_t pushedStorageCount = 0;
+	size_t pushedStorageByteSize = 0;
+	size_t pushTimeMs = 0;
+	size_t peakMemoryBytes = 0;
+};
 
 class InterprocessIndexingStatusManager: public BaseInterprocessDataManager
 {
@@ -15,9 +26,23 @@ public:
 	void startIndexingSourceFile(const FilePath& filePath);
 	void finishIndexingSourceFile();
 
+	void addIndexingCost(const StorageIndexingCost& cost);
+	std::vector<StorageIndexingCost> getIndexingCosts();
+
+	void addIndexerProcessStatistics(const IndexerProcessStatistics& statistics);
+	std::map<Id, IndexerProcessStatistics> getIndexerProcessStatistics();
+
 	void setIndexingInterrupted(bool interrupted);
 	bool getIndexingInterrupted();
 
+	// indexers don't fetch new indexer commands while paused
+	void setIndexingPaused(bool paused);
+	bool getIndexingPaused();
+
+	// indexer processes record traces while tracing is enabled in the app
+	void setTracingEnabled(bool enabled);
+	bool getTracingEnabled();
+
 	Id getNextFinishedProcessId();
 
 	std::vector<FilePath> getCurrentlyIndexedSourceFilePaths();
@@ -31,6 +56,10 @@ private:
 	static const char* s_crashedFilesKeyName;
 	static const char* s_finishedProcessIdsKeyName;
 	static const char* s_indexingInterruptedKeyName;
+	static const char* s_indexingPausedKeyName;
+	static const char* s_tracingEnabledKeyName;
+	static const char* s_indexingCostsKeyName;
+	static const char* s_processStatisticsKeyName;
 };
 
 #endif	  // INTERPROCESS_INDEXING_STATUS_MANAGER_H
@@ -6,6 +6,7 @@
 #include "StorageEdge.h"
 #include "StorageError.h"
 #include "StorageFile.h"
+#include "StorageIndexingCost.h"
 #include "StorageLocalSymbol.h"
 #include "StorageNode.h"
 #include "StorageOccurrence.h"
@@ -179,4 +180,46 @@ inline StorageError fromShared(const SharedStorageError& error)
 		error.indexed);
 }
 
+
+struct SharedStorageIndexingCost
+{
+	SharedStorageIndexingCost(
+		const std::string& filePath,
+		size_t wallTimeMs,
+		size_t peakMemoryBytes,
+		size_t storageByteSize,
+		SharedMemory::Allocator* allocator)
+		: filePath(filePath.c_str(), allocator)
+		, wallTimeMs(wallTimeMs)
+		, peakMemoryBytes(peakMemoryBytes)
+		, storageByteSize(storageByteSize)
+	{
+	}
+
+	SharedMemory::String filePath;
+	size_t wallTimeMs;
+	size_t peakMemoryBytes;
+	size_t storageByteSize;
+};
+
+inline SharedStorageIndexingCost toShared(
+	const StorageIndexingCost& cost, SharedMemory::Allocator* allocator)
+{
+	return SharedStorageIndexingCost(
+		utility::encodeToUtf8(cost.filePath),
+		cost.wallTimeMs,
+		cost.peakMemoryBytes,
+		cost.storageByteSize,
+		allocator);
+}
+
+inline StorageIndexingCost fromShared(const SharedStorageIndexingCost& cost)
+{
+	return StorageIndexingCost(
+		utility::decodeFromUtf8(cost.filePath.c_str()),
+		cost.wallTimeMs,
+		cost.peakMemoryBytes,
+		cost.storageByteSize);
+}
+
 #endif	  // SHARED_STORAGE_TYPES_H
@@ -3,10 +3,18 @@
 #include <algorithm>
 #include <ctype.h>
 #include <iterator>
+#include <numeric>
 
 #include "utility.h"
 #include "utilityString.h"
 
+namespace
+{
+// paths of the last query are only kept for the next one if there are not more than this, since
+// each of them holds a copy of its text. Short queries of large indices match far more.
+const size_t s_maxLastPathCount = 10000;
+}	 // namespace
+
 SearchIndex::SearchIndex()
 {
 	clear();
@@ -81,6 +89,9 @@ void SearchIndex::finishSetup()
 	{
 		populateEdgeGate(p.second);
 	}
+
+	std::lock_guard<std::mutex> lock(m_lastSearchMutex);
+	m_lastPaths.reset();
 }
 
 void SearchIndex::clear()
@@ -91,6 +102,9 @@ void SearchIndex::clear()
 	m_nodes.push_back(std::make_unique<SearchNode>(NodeTypeSet()));
 
 	m_root = m_nodes.back().get();
+
+	std::lock_guard<std::mutex> lock(m_lastSearchMutex);
+	m_lastPaths.reset();
 }
 
 std::vector<SearchResult> SearchIndex::search(
@@ -100,48 +114,82 @@ std::vector<SearchResult> SearchIndex::search(
 	size_t maxBestScoredResultsLength) const
 {
 	// find paths containing query
-	std::vector<SearchPath> paths;
-	searchRecursive(
-		SearchPath(L"", {}, m_root), utility::toLowerCase(query), acceptedNodeTypes, &paths);
+	const std::shared_ptr<const std::vector<SearchPath>> paths = findPaths(
+		utility::toLowerCase(query), acceptedNodeTypes);
 
 	// create scored search results
-	std::multiset<SearchResult> searchResults = createScoredResults(
-		paths, acceptedNodeTypes, maxResultCount * 3);
+	const std::vector<SearchResult> searchResults = createScoredResults(
+		*paths, acceptedNodeTypes, maxResultCount * 3);
 
 	// find maximum length for best scores
-	std::multiset<size_t> resultLengths;
-	for (const SearchResult& result: searchResults)
-	{
-		resultLengths.insert(result.text.size());
-	}
 	size_t maxResultLength = 0;
-	if (resultLengths.size() > 1000)
+	if (searchResults.size() > 1000)
 	{
-		auto it = resultLengths.begin();
-		std::advance(it, 1000);
-		maxResultLength = *it;
+		std::vector<size_t> resultLengths;
+		resultLengths.reserve(searchResults.size());
+		for (const SearchResult& result: searchResults)
+		{
+			resultLengths.push_back(result.text.size());
+		}
+
+		std::nth_element(resultLengths.begin(), resultLengths.begin() + 1000, resultLengths.end());
+		maxResultLength = resultLengths[1000];
 	}
 
 	// find best scores
 	std::map<std::wstring, SearchResult> scoresCache;
-	std::multiset<SearchResult> bestResults;
+	std::vector<SearchResult> bestResults;
 	for (const SearchResult& result: searchResults)
 	{
 		if (!maxResultLength || result.text.size() <= maxResultLength)
 		{
-			bestResults.insert(bestScoredResult(result, &scoresCache, maxBestScoredResultsLength));
+			bestResults.push_back(
+				bestScoredResult(result, &scoresCache, maxBestScoredResultsLength));
 		}
 	}
 
-	// narrow down to max result count
-	auto it = bestResults.end();
-	if (maxResultCount && bestResults.size() > maxResultCount)
+	// narrow down to max result count, only the kept results get sorted
+	size_t resultCount = bestResults.size();
+	if (maxResultCount && resultCount > maxResultCount)
 	{
-		it = bestResults.begin();
-		std::advance(it, maxResultCount);
+		resultCount = maxResultCount;
 	}
 
-	return std::vector<SearchResult>(bestResults.begin(), it);
+	std::vector<size_t> order(bestResults.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::partial_sort(
+		order.begin(),
+		order.begin() + resultCount,
+		order.end(),
+		[&bestResults](size_t a, size_t b) {
+			return bestResults[a].score > bestResults[b].score ||
+				(bestResults[a].score == bestResults[b].score && a < b);
+		});
+
+	std::vector<SearchResult> results;
+	results.reserve(resultCount);
+	for (size_t i = 0; i < resultCount; i++)
+	{
+		results.push_back(std::move(bestResults[order[i]]));
+	}
+	return results;
+}
+
+void SearchIndex::CharacterMask::add(wchar_t c)
+{
+	const size_t bit = std::min<size_t>(c, 127);
+	bits[bit / 64] |= uint64_t(1) << (bit % 64);
+}
+
+void SearchIndex::CharacterMask::add(const CharacterMask& other)
+{
+	bits[0] |= other.bits[0];
+	bits[1] |= other.bits[1];
+}
+
+bool SearchIndex::CharacterMask::containsAll(const CharacterMask& other) const
+{
+	return !(other.bits[0] & ~bits[0]) && !(other.bits[1] & ~bits[1]);
 }
 
 void SearchIndex::populateEdgeGate(SearchEdge* e)
@@ -150,87 +198,182 @@ void SearchIndex::populateEdgeGate(SearchEdge* e)
 	{
 		SearchEdge* targetEdge = p.second;
 		populateEdgeGate(targetEdge);
-		utility::append(e->gate, targetEdge->gate);
+		e->gate.add(targetEdge->gate);
 	}
 
 	for (const wchar_t& c: e->s)
 	{
-		e->gate.insert(towlower(c));
+		e->gate.add(towlower(c));
 	}
 }
 
-void SearchIndex::searchRecursive(
+std::shared_ptr<const std::vector<SearchIndex::SearchPath>> SearchIndex::findPaths(
+	const std::wstring& lowerQuery, NodeTypeSet acceptedNodeTypes) const
+{
+	std::shared_ptr<const std::vector<SearchPath>> lastPaths;
+	std::wstring lastQuery;
+	{
+		std::lock_guard<std::mutex> lock(m_lastSearchMutex);
+		if (m_lastPaths && !m_lastQuery.empty() && m_lastAcceptedNodeTypes == acceptedNodeTypes &&
+			utility::isPrefix(m_lastQuery, lowerQuery))
+		{
+			lastPaths = m_lastPaths;
+			lastQuery = m_lastQuery;
+		}
+	}
+
+	std::shared_ptr<std::vector<SearchPath>> paths = std::make_shared<std::vector<SearchPath>>();
+	if (lastPaths)
+	{
+		// characters are matched greedily, so every match of the longer query continues a match of
+		// the shorter one and the paths in between never need to be visited again
+		const std::wstring remainingQuery = lowerQuery.substr(lastQuery.size());
+		for (const SearchPath& path: *lastPaths)
+		{
+			continuePath(path, remainingQuery, acceptedNodeTypes, paths.get());
+		}
+	}
+	else
+	{
+		std::wstring text;
+		std::vector<size_t> indices;
+		searchRecursive(m_root, lowerQuery, 0, acceptedNodeTypes, &text, &indices, paths.get());
+	}
+
+	std::lock_guard<std::mutex> lock(m_lastSearchMutex);
+	m_lastQuery = lowerQuery;
+	m_lastAcceptedNodeTypes = acceptedNodeTypes;
+	if (paths->size() <= s_maxLastPathCount)
+	{
+		m_lastPaths = paths;
+	}
+	else
+	{
+		m_lastPaths.reset();
+	}
+	return paths;
+}
+
+void SearchIndex::continuePath(
 	const SearchPath& path,
 	const std::wstring& remainingQuery,
 	NodeTypeSet acceptedNodeTypes,
 	std::vector<SearchIndex::SearchPath>* results) const
 {
-	for (const auto& p: path.node->edges)
-	{
-		const SearchEdge* currentEdge = p.second;
+	// the last edge of the path may still contain characters behind its last match
+	SearchPath currentPath = path;
 
-		if (!acceptedNodeTypes.intersectsWith(currentEdge->target->containedTypes))
+	size_t j = 0;
+	for (size_t i = path.indices.back() + 1; i < path.text.size() && j < remainingQuery.size(); i++)
+	{
+		if (towlower(path.text[i]) == remainingQuery[j])
 		{
-			continue;
+			currentPath.indices.push_back(i);
+			j++;
 		}
+	}
 
-		// test if s passes the edge's gate.
-		bool passesGate = true;
-		for (const wchar_t& c: remainingQuery)
-		{
-			if (currentEdge->gate.find(c) == currentEdge->gate.end())
-			{
-				passesGate = false;
-				break;
-			}
-		}
+	if (j == remainingQuery.size())
+	{
+		results->push_back(std::move(currentPath));
+	}
+	else
+	{
+		searchRecursive(
+			currentPath.node,
+			remainingQuery,
+			j,
+			acceptedNodeTypes,
+			&currentPath.text,
+			&currentPath.indices,
+			results);
+	}
+}
+
+void SearchIndex::searchRecursive(
+	const SearchNode* node,
+	const std::wstring& lowerQuery,
+	size_t queryPos,
+	const NodeTypeSet& acceptedNodeTypes,
+	std::wstring* text,
+	std::vector<size_t>* indices,
+	std::vector<SearchIndex::SearchPath>* results) const
+{
+	// an edge passes its gate if all remaining query characters occur behind it
+	CharacterMask queryMask;
+	for (size_t j = queryPos; j < lowerQuery.size(); j++)
+	{
+		queryMask.add(lowerQuery[j]);
+	}
 
-		if (!passesGate)
+	const size_t textSize = text->size();
+	const size_t indicesSize = indices->size();
+
+	for (const auto& p: node->edges)
+	{
+		const SearchEdge* currentEdge = p.second;
+
+		if (!acceptedNodeTypes.intersectsWith(currentEdge->target->containedTypes) ||
+			!currentEdge->gate.containsAll(queryMask))
 		{
 			continue;
 		}
 
 		// consume characters for edge
 		const std::wstring& edgeString = currentEdge->s;
-		SearchPath currentPath {path.text + edgeString, path.indices, currentEdge->target};
+		text->append(edgeString);
 
-		size_t j = 0;
-		for (size_t i = 0; i < edgeString.size() && j < remainingQuery.size(); i++)
+		size_t j = queryPos;
+		for (size_t i = 0; i < edgeString.size() && j < lowerQuery.size(); i++)
 		{
-			if (towlower(edgeString[i]) == remainingQuery[j])
+			if (towlower(edgeString[i]) == lowerQuery[j])
 			{
-				currentPath.indices.push_back(path.text.size() + i);
+				indices->push_back(textSize + i);
 				j++;
 			}
 		}
 
-		if (j == remainingQuery.size())
+		if (j == lowerQuery.size())
 		{
-			results->push_back(std::move(currentPath));
+			results->emplace_back(*text, *indices, currentEdge->target);
 		}
 		else
 		{
-			searchRecursive(currentPath, remainingQuery.substr(j), acceptedNodeTypes, results);
+			searchRecursive(
+				currentEdge->target, lowerQuery, j, acceptedNodeTypes, text, indices, results);
 		}
+
+		text->resize(textSize);
+		indices->resize(indicesSize);
 	}
 }
 
-std::multiset<SearchResult> SearchIndex::createScoredResults(
+std::vector<SearchResult> SearchIndex::createScoredResults(
 	const std::vector<SearchPath>& paths, NodeTypeSet acceptedNodeTypes, size_t maxResultCount) const
 {
-	// score and order initial paths
-	std::multimap<int, SearchPath, std::greater<int>> scoredPaths;
-	for (const SearchPath& path: paths)
+	// score initial paths, they are taken from a heap best scored first and equally scored ones in
+	// the order they were found, so paths not needed for max result count never get sorted
+	std::vector<std::pair<int, size_t>> scoredPaths;
+	scoredPaths.reserve(paths.size());
+	for (size_t i = 0; i < paths.size(); i++)
 	{
-		scoredPaths.emplace(scoreText(path.text, path.indices), path);
+		scoredPaths.emplace_back(scoreText(paths[i].text, paths[i].indices), i);
 	}
 
+	auto isScoredLower = [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) {
+		return a.first < b.first || (a.first == b.first && a.second > b.second);
+	};
+	std::make_heap(scoredPaths.begin(), scoredPaths.end(), isScoredLower);
+
 	// score paths and subpaths
-	std::multiset<SearchResult> searchResults;
-	for (const std::pair<int, SearchPath>& p: scoredPaths)
+	std::vector<SearchResult> searchResults;
+	while (!scoredPaths.empty() && (!maxResultCount || searchResults.size() < maxResultCount))
 	{
+		std::pop_heap(scoredPaths.begin(), scoredPaths.end(), isScoredLower);
+
 		std::vector<SearchPath> currentPaths;
-		currentPaths.push_back(p.second);
+		currentPaths.push_back(paths[scoredPaths.back().second]);
+		scoredPaths.pop_back();
 
 		while (!currentPaths.empty())
 		{
@@ -252,7 +395,7 @@ std::multiset<SearchResult> SearchIndex::createScoredResults(
 
 					if (!elementIds.empty())
 					{
-						searchResults.emplace(
+						searchResults.emplace_back(
 							path.text,
 							std::move(elementIds),
 							path.indices,
@@ -260,7 +403,7 @@ std::multiset<SearchResult> SearchIndex::createScoredResults(
 
 						if (maxResultCount && searchResults.size() >= maxResultCount)
 						{
-							return searchResults;
+							break;
 						}
 					}
 				}
@@ -272,10 +415,17 @@ std::multiset<SearchResult> SearchIndex::createScoredResults(
 				}
 			}
 
+			if (maxResultCount && searchResults.size() >= maxResultCount)
+			{
+				break;
+			}
+
 			currentPaths = std::move(nextPaths);
 		}
 	}
 
+	// SearchResults compare by score only, so equally scored ones keep their order
+	std::stable_sort(searchResults.begin(), searchResults.end());
 	return searchResults;
 }
 
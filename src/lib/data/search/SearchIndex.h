@@ -1,8 +1,10 @@
 #ifndef SEARCH_INDEX_H
 #define SEARCH_INDEX_H
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -53,6 +55,17 @@ public:
 private:
 	struct SearchEdge;
 
+	// set of lowercase characters kept as bits, exact for ASCII while all other characters share
+	// the last bit, so it may let non-ASCII queries pass but never rejects a matching one
+	struct CharacterMask
+	{
+		void add(wchar_t c);
+		void add(const CharacterMask& other);
+		bool containsAll(const CharacterMask& other) const;
+
+		uint64_t bits[2] = {0, 0};
+	};
+
 	struct SearchNode
 	{
 		SearchNode(NodeTypeSet containedTypes): containedTypes(containedTypes) {}
@@ -68,7 +81,7 @@ private:
 
 		SearchNode* target;
 		std::wstring s;
-		std::set<wchar_t> gate;
+		CharacterMask gate;
 	};
 
 	struct SearchPath
@@ -84,13 +97,29 @@ private:
 	};
 
 	void populateEdgeGate(SearchEdge* e);
-	void searchRecursive(
+
+	// reuses the paths of the previous query if the query extends it, like it does while typing.
+	// They are only kept if there are few enough of them.
+	std::shared_ptr<const std::vector<SearchPath>> findPaths(
+		const std::wstring& lowerQuery, NodeTypeSet acceptedNodeTypes) const;
+	void continuePath(
 		const SearchPath& path,
 		const std::wstring& remainingQuery,
 		NodeTypeSet acceptedNodeTypes,
 		std::vector<SearchIndex::SearchPath>* results) const;
+	// matches lowerQuery from queryPos on, text and indices are extended while descending and
+	// restored afterwards, so they only get copied for the found paths
+	void searchRecursive(
+		const SearchNode* node,
+		const std::wstring& lowerQuery,
+		size_t queryPos,
+		const NodeTypeSet& acceptedNodeTypes,
+		std::wstring* text,
+		std::vector<size_t>* indices,
+		std::vector<SearchIndex::SearchPath>* results) const;
 
-	std::multiset<SearchResult> createScoredResults(
+	// results are ordered by score, equally scored ones in the order they were found
+	std::vector<SearchResult> createScoredResults(
 		const std::vector<SearchPath>& paths,
 		NodeTypeSet acceptedNodeTypes,
 		size_t maxResultCount) const;
@@ -122,6 +151,11 @@ private:
 	std::vector<std::unique_ptr<SearchNode>> m_nodes;
 	std::vector<std::unique_ptr<SearchEdge>> m_edges;
 	SearchNode* m_root;
+
+	mutable std::mutex m_lastSearchMutex;
+	mutable std::wstring m_lastQuery;
+	mutable NodeTypeSet m_lastAcceptedNodeTypes;
+	mutable std::shared_ptr<const std::vector<SearchPath>> m_lastPaths;
 };
 
 #endif	  // SEARCH_INDEX_H
@@ -33,7 +33,7 @@ void IntermediateStorage::clear()
 
 size_t IntermediateStorage::getByteSize(size_t stringSize) const
 {
-	unsigned int byteSize = 0;
+	size_t byteSize = 0;
 
 	for (const StorageFile& storageFile: getStorageFiles())
 	{
@@ -118,10 +118,10 @@ void IntermediateStorage::setFilesWithErrorsIncomplete()
 
 std::pair<Id, bool> IntermediateStorage::addNode(const StorageNodeData& nodeData)
 {
-	auto it = m_nodesIndex.find(nodeData);
-	if (it != m_nodesIndex.end())
+	const size_t position = m_nodesIndex.find(nodeData, m_nodes);
+	if (position != m_nodesIndex.s_notFound)
 	{
-		StorageNode& storedNode = m_nodes[it->second];
+		StorageNode& storedNode = m_nodes[position];
 		if (storedNode.type < nodeData.type)
 		{
 			storedNode.type = nodeData.type;
@@ -131,7 +131,7 @@ std::pair<Id, bool> IntermediateStorage::addNode(const StorageNodeData& nodeData
 
 	Id nodeId = m_nextId++;
 	m_nodes.emplace_back(nodeId, nodeData);
-	m_nodesIndex.emplace(nodeData, m_nodes.size() - 1);
+	m_nodesIndex.insert(m_nodes.size() - 1, m_nodes);
 	m_nodeIdIndex.emplace(nodeId, m_nodes.size() - 1);
 	return std::make_pair(nodeId, true);
 }
@@ -140,6 +140,7 @@ std::vector<Id> IntermediateStorage::addNodes(const std::vector<StorageNode>& no
 {
 	std::vector<Id> nodeIds;
 	nodeIds.reserve(nodes.size());
+	m_nodes.reserve(m_nodes.size() + nodes.size());
 	for (const StorageNode& node: nodes)
 	{
 		nodeIds.emplace_back(addNode(node).first);
@@ -168,10 +169,10 @@ void IntermediateStorage::addSymbols(const std::vector<StorageSymbol>& symbols)
 
 void IntermediateStorage::addFile(const StorageFile& file)
 {
-	auto it = m_filesIndex.find(file);
-	if (it != m_filesIndex.end())
+	const size_t position = m_filesIndex.find(file, m_files);
+	if (position != m_filesIndex.s_notFound)
 	{
-		StorageFile& storedFile = m_files[it->second];
+		StorageFile& storedFile = m_files[position];
 
 		if (file.indexed)
 		{
@@ -190,9 +191,9 @@ void IntermediateStorage::addFile(const StorageFile& file)
 	}
 	else
 	{
-		m_filesIndex.emplace(file, m_files.size());
-		m_filesIdIndex.emplace(file.id, m_files.size());
 		m_files.emplace_back(file);
+		m_filesIndex.insert(m_files.size() - 1, m_files);
+		m_filesIdIndex.emplace(file.id, m_files.size() - 1);
 	}
 }
 
@@ -207,15 +208,15 @@ void IntermediateStorage::setFileLanguage(Id fileId, const std::wstring& languag
 
 Id IntermediateStorage::addEdge(const StorageEdgeData& edgeData)
 {
-	auto it = m_edgesIndex.find(edgeData);
-	if (it != m_edgesIndex.end())
+	const size_t position = m_edgesIndex.find(edgeData, m_edges);
+	if (position != m_edgesIndex.s_notFound)
 	{
-		return m_edges[it->second].id;
+		return m_edges[position].id;
 	}
 
 	Id edgeId = m_nextId++;
 	m_edges.emplace_back(edgeId, edgeData);
-	m_edgesIndex.emplace(edgeData, m_edges.size() - 1);
+	m_edgesIndex.insert(m_edges.size() - 1, m_edges);
 	return edgeId;
 }
 
@@ -223,6 +224,7 @@ std::vector<Id> IntermediateStorage::addEdges(const std::vector<StorageEdge>& ed
 {
 	std::vector<Id> edgeIds;
 	edgeIds.reserve(edges.size());
+	m_edges.reserve(m_edges.size() + edges.size());
 	for (const StorageEdge& edge: edges)
 	{
 		edgeIds.emplace_back(addEdge(edge));
@@ -376,11 +378,10 @@ void IntermediateStorage::setStorageNodes(std::vector<StorageNode> storageNodes)
 {
 	m_nodes = std::move(storageNodes);
 
-	m_nodesIndex.clear();
+	m_nodesIndex.rebuild(m_nodes);
 	m_nodeIdIndex.clear();
 	for (size_t i = 0; i < m_nodes.size(); i++)
 	{
-		m_nodesIndex.emplace(m_nodes[i], i);
 		m_nodeIdIndex.emplace(m_nodes[i].id, i);
 	}
 }
@@ -389,11 +390,10 @@ void IntermediateStorage::setStorageFiles(std::vector<StorageFile> storageFiles)
 {
 	m_files = std::move(storageFiles);
 
-	m_filesIndex.clear();
+	m_filesIndex.rebuild(m_files);
 	m_filesIdIndex.clear();
 	for (size_t i = 0; i < m_files.size(); i++)
 	{
-		m_filesIndex.emplace(m_files[i], i);
 		m_filesIdIndex.emplace(m_files[i].id, i);
 	}
 }
@@ -407,11 +407,7 @@ void IntermediateStorage::setStorageEdges(std::vector<StorageEdge> storageEdges)
 {
 	m_edges = std::move(storageEdges);
 
-	m_edgesIndex.clear();
-	for (size_t i = 0; i < m_edges.size(); i++)
-	{
-		m_edgesIndex.emplace(m_edges[i], i);
-	}
+	m_edgesIndex.rebuild(m_edges);
 }
 
 void IntermediateStorage::setStorageLocalSymbols(std::set<StorageLocalSymbol> storageLocalSymbols)
@@ -459,3 +455,38 @@ void IntermediateStorage::setNextId(const Id nextId)
 {
 	m_nextId = nextId;
 }
+
+size_t IntermediateStorage::NodeHash::operator()(const StorageNodeData& node) const
+{
+	return std::hash<std::wstring>()(node.serializedName);
+}
+
+bool IntermediateStorage::NodeEqual::operator()(
+	const StorageNodeData& a, const StorageNodeData& b) const
+{
+	return a.serializedName == b.serializedName;
+}
+
+size_t IntermediateStorage::FileHash::operator()(const StorageFile& file) const
+{
+	return std::hash<std::wstring>()(file.filePath);
+}
+
+bool IntermediateStorage::FileEqual::operator()(const StorageFile& a, const StorageFile& b) const
+{
+	return a.filePath == b.filePath;
+}
+
+size_t IntermediateStorage::EdgeHash::operator()(const StorageEdgeData& edge) const
+{
+	size_t hash = std::hash<Id>()(edge.sourceNodeId);
+	hash = hash * 31 + std::hash<Id>()(edge.targetNodeId);
+	return hash * 31 + std::hash<int>()(edge.type);
+}
+
+bool IntermediateStorage::EdgeEqual::operator()(
+	const StorageEdgeData& a, const StorageEdgeData& b) const
+{
+	return a.type == b.type && a.sourceNodeId == b.sourceNodeId &&
+		a.targetNodeId == b.targetNodeId;
+}
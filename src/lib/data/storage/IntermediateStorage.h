@@ -4,7 +4,9 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 
+#include "HashIndex.h"
 #include "Storage.h"
 
 class IntermediateStorage: public Storage
@@ -68,17 +70,44 @@ public:
 	void setNextId(const Id nextId);
 
 private:
-	std::map<StorageNodeData, size_t> m_nodesIndex;
-	std::map<Id, size_t> m_nodeIdIndex;
+	struct NodeHash
+	{
+		size_t operator()(const StorageNodeData& node) const;
+	};
+	struct NodeEqual
+	{
+		bool operator()(const StorageNodeData& a, const StorageNodeData& b) const;
+	};
+	struct FileHash
+	{
+		size_t operator()(const StorageFile& file) const;
+	};
+	struct FileEqual
+	{
+		bool operator()(const StorageFile& a, const StorageFile& b) const;
+	};
+	struct EdgeHash
+	{
+		size_t operator()(const StorageEdgeData& edge) const;
+	};
+	struct EdgeEqual
+	{
+		bool operator()(const StorageEdgeData& a, const StorageEdgeData& b) const;
+	};
+
+	// the indices refer to the records by position, so names are only stored once
+	HashIndex<StorageNodeData, NodeHash, NodeEqual> m_nodesIndex;
+	std::unordered_map<Id, size_t> m_nodeIdIndex;
 	std::vector<StorageNode> m_nodes;
 
-	std::map<StorageFile, size_t> m_filesIndex;	   // this is used to prevent duplicates (unique)
-	std::map<Id, size_t> m_filesIdIndex;
+	// this is used to prevent duplicates (unique)
+	HashIndex<StorageFile, FileHash, FileEqual> m_filesIndex;
+	std::unordered_map<Id, size_t> m_filesIdIndex;
 	std::vector<StorageFile> m_files;
 
 	std::vector<StorageSymbol> m_symbols;
 
-	std::map<StorageEdgeData, size_t> m_edgesIndex;
+	HashIndex<StorageEdgeData, EdgeHash, EdgeEqual> m_edgesIndex;
 	std::vector<StorageEdge> m_edges;
 
 	std::set<StorageLocalSymbol> m_localSymbols;
@@ -1,7 +1,10 @@
 #include "PersistentStorage.h"
 
+#include <algorithm>
+#include <limits>
 #include <queue>
 #include <sstream>
+#include <unordered_map>
 
 #include "AccessKind.h"
 #include "ApplicationSettings.h"
@@ -9,6 +12,7 @@
 #include "FileInfo.h"
 #include "FilePath.h"
 #include "Graph.h"
+#include "IndexingReport.h"
 #include "MessageErrorCountUpdate.h"
 #include "MessageStatus.h"
 #include "NodeTypeSet.h"
@@ -17,6 +21,7 @@
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "TextCodec.h"
+#include "ThreadPool.h"
 #include "TimeStamp.h"
 #include "TokenComponentAccess.h"
 #include "TokenComponentAggregation.h"
@@ -27,10 +32,37 @@
 #include "logging.h"
 #include "tracing.h"
 #include "utility.h"
-#include "utilityApp.h"
 
-PersistentStorage::PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath)
-	: m_sqliteIndexStorage(dbPath), m_sqliteBookmarkStorage(bookmarkPath)
+namespace
+{
+// passes the rows of a table on in batches, so the whole table is never held in memory
+template <typename StorageType>
+void forEachBatch(
+	const SqliteIndexStorage& storage, std::function<void(std::vector<StorageType>&)> func)
+{
+	const size_t batchSize = 10000;
+
+	std::vector<StorageType> batch;
+	batch.reserve(batchSize);
+	storage.forEach<StorageType>([&](StorageType&& element) {
+		batch.emplace_back(std::move(element));
+		if (batch.size() == batchSize)
+		{
+			func(batch);
+			batch.clear();
+		}
+	});
+
+	if (!batch.empty())
+	{
+		func(batch);
+	}
+}
+}	 // namespace
+
+PersistentStorage::PersistentStorage(
+	const FilePath& dbPath, const FilePath& bookmarkPath, bool readOnly)
+	: m_sqliteIndexStorage(dbPath, readOnly), m_sqliteBookmarkStorage(bookmarkPath)
 {
 	m_commandIndex.addNode(0, SearchMatch::getCommandName(SearchMatch::COMMAND_ALL));
 	m_commandIndex.addNode(0, SearchMatch::getCommandName(SearchMatch::COMMAND_ERROR));
@@ -260,6 +292,238 @@ void PersistentStorage::rollbackInjection()
 	afterErrorRecording();
 }
 
+void PersistentStorage::injectDatabase(const FilePath& dbFilePath, IndexingReport* report)
+{
+	TRACE();
+
+	const SqliteIndexStorage injected(dbFilePath);
+
+	// only the ids are kept for remapping, the rows are dropped after each batch
+	std::unordered_map<Id, Id> injectedIdToOwnElementId;
+	std::unordered_map<Id, Id> injectedIdToOwnSourceLocationId;
+
+	startInjection();
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject errors");
+
+		injected.forEach<StorageError>([&](StorageError&& error) {
+			injectedIdToOwnElementId.emplace(error.id, addError(error));
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject nodes");
+
+		forEachBatch<StorageNode>(injected, [&](std::vector<StorageNode>& nodes) {
+			const std::vector<Id> nodeIds = addNodes(nodes);
+			for (size_t i = 0; i < nodes.size(); i++)
+			{
+				if (nodeIds[i])
+				{
+					injectedIdToOwnElementId.emplace(nodes[i].id, nodeIds[i]);
+				}
+			}
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject files");
+
+		injected.forEach<StorageFile>([&](StorageFile&& file) {
+			auto it = injectedIdToOwnElementId.find(file.id);
+			if (it != injectedIdToOwnElementId.end())
+			{
+				addFile(StorageFile(
+					it->second,
+					file.filePath,
+					file.languageIdentifier,
+					file.modificationTime,
+					file.indexed,
+					file.complete));
+			}
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject symbols");
+
+		forEachBatch<StorageSymbol>(injected, [&](std::vector<StorageSymbol>& injectedSymbols) {
+			std::vector<StorageSymbol> symbols;
+			symbols.reserve(injectedSymbols.size());
+			for (const StorageSymbol& symbol: injectedSymbols)
+			{
+				auto it = injectedIdToOwnElementId.find(symbol.id);
+				if (it != injectedIdToOwnElementId.end())
+				{
+					symbols.emplace_back(it->second, symbol.definitionKind);
+				}
+				else
+				{
+					LOG_WARNING("New symbol id could not be found.");
+				}
+			}
+			addSymbols(symbols);
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject edges");
+
+		forEachBatch<StorageEdge>(injected, [&](std::vector<StorageEdge>& injectedEdges) {
+			std::vector<StorageEdge> edges;
+			edges.reserve(injectedEdges.size());
+			for (const StorageEdge& edge: injectedEdges)
+			{
+				auto sourceIt = injectedIdToOwnElementId.find(edge.sourceNodeId);
+				auto targetIt = injectedIdToOwnElementId.find(edge.targetNodeId);
+				if (sourceIt != injectedIdToOwnElementId.end() &&
+					targetIt != injectedIdToOwnElementId.end())
+				{
+					edges.emplace_back(edge.id, edge.type, sourceIt->second, targetIt->second);
+				}
+				else
+				{
+					LOG_WARNING("New edge source or target id could not be found.");
+				}
+			}
+
+			const std::vector<Id> edgeIds = addEdges(edges);
+			for (size_t i = 0; i < edgeIds.size(); i++)
+			{
+				if (edgeIds[i])
+				{
+					injectedIdToOwnElementId.emplace(edges[i].id, edgeIds[i]);
+				}
+			}
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject local symbols");
+
+		forEachBatch<StorageLocalSymbol>(injected, [&](std::vector<StorageLocalSymbol>& batch) {
+			const std::set<StorageLocalSymbol> symbols(batch.begin(), batch.end());
+			const std::vector<Id> symbolIds = addLocalSymbols(symbols);
+
+			auto it = symbols.begin();
+			for (size_t i = 0; i < symbolIds.size(); i++, it++)
+			{
+				if (symbolIds[i])
+				{
+					injectedIdToOwnElementId.emplace(it->id, symbolIds[i]);
+				}
+			}
+		});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject locations");
+
+		forEachBatch<StorageSourceLocation>(
+			injected, [&](std::vector<StorageSourceLocation>& injectedLocations) {
+				std::vector<StorageSourceLocation> locations;
+				locations.reserve(injectedLocations.size());
+				for (const StorageSourceLocation& location: injectedLocations)
+				{
+					auto it = injectedIdToOwnElementId.find(location.fileNodeId);
+					if (it != injectedIdToOwnElementId.end())
+					{
+						locations.emplace_back(
+							location.id,
+							it->second,
+							location.startLine,
+							location.startCol,
+							location.endLine,
+							location.endCol,
+							location.type);
+					}
+				}
+
+				const std::vector<Id> locationIds = addSourceLocations(locations);
+				for (size_t i = 0; i < locationIds.size(); i++)
+				{
+					if (locationIds[i])
+					{
+						injectedIdToOwnSourceLocationId.emplace(locations[i].id, locationIds[i]);
+					}
+				}
+			});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject occurrences");
+
+		forEachBatch<StorageOccurrence>(
+			injected, [&](std::vector<StorageOccurrence>& injectedOccurrences) {
+				std::vector<StorageOccurrence> occurrences;
+				occurrences.reserve(injectedOccurrences.size());
+				for (const StorageOccurrence& occurrence: injectedOccurrences)
+				{
+					auto elementIt = injectedIdToOwnElementId.find(occurrence.elementId);
+					auto locationIt = injectedIdToOwnSourceLocationId.find(
+						occurrence.sourceLocationId);
+					if (elementIt == injectedIdToOwnElementId.end())
+					{
+						LOG_WARNING("New occurrence element id could not be found.");
+					}
+					else if (locationIt == injectedIdToOwnSourceLocationId.end())
+					{
+						LOG_WARNING("New occurrence location id could not be found.");
+					}
+					else
+					{
+						occurrences.emplace_back(elementIt->second, locationIt->second);
+					}
+				}
+				addOccurrences(occurrences);
+			});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject element components");
+
+		forEachBatch<StorageElementComponent>(
+			injected, [&](std::vector<StorageElementComponent>& injectedComponents) {
+				std::vector<StorageElementComponent> components;
+				components.reserve(injectedComponents.size());
+				for (const StorageElementComponent& component: injectedComponents)
+				{
+					auto it = injectedIdToOwnElementId.find(component.elementId);
+					if (it != injectedIdToOwnElementId.end())
+					{
+						components.emplace_back(it->second, component.type, component.data);
+					}
+				}
+				addElementComponents(components);
+			});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject accesses");
+
+		forEachBatch<StorageComponentAccess>(
+			injected, [&](std::vector<StorageComponentAccess>& injectedAccesses) {
+				std::vector<StorageComponentAccess> accesses;
+				accesses.reserve(injectedAccesses.size());
+				for (const StorageComponentAccess& access: injectedAccesses)
+				{
+					auto it = injectedIdToOwnElementId.find(access.nodeId);
+					if (it != injectedIdToOwnElementId.end())
+					{
+						accesses.emplace_back(it->second, access.type);
+					}
+				}
+				addComponentAccesses(accesses);
+			});
+	}
+
+	{
+		IndexingReport::ScopedPhase phase(report, "inject commit");
+		finishInjection();
+	}
+}
+
 void PersistentStorage::beforeErrorRecording()
 {
 	m_preInjectionErrorCount = m_sqliteIndexStorage.getErrorCount();
@@ -319,6 +583,26 @@ void PersistentStorage::setProjectSettingsText(std::string text)
 	m_sqliteIndexStorage.setProjectSettingsText(text);
 }
 
+std::string PersistentStorage::getIndexingReport() const
+{
+	return m_sqliteIndexStorage.getIndexingReport();
+}
+
+void PersistentStorage::setIndexingReport(const std::string& report)
+{
+	m_sqliteIndexStorage.setIndexingReport(report);
+}
+
+std::string PersistentStorage::getIndexingCheckpoint() const
+{
+	return m_sqliteIndexStorage.getIndexingCheckpoint();
+}
+
+void PersistentStorage::setIndexingCheckpoint(const std::string& checkpoint)
+{
+	m_sqliteIndexStorage.setIndexingCheckpoint(checkpoint);
+}
+
 void PersistentStorage::setup()
 {
 	m_sqliteIndexStorage.setup();
@@ -357,7 +641,9 @@ void PersistentStorage::clearCaches()
 	m_symbolDefinitionKinds.clear();
 
 	m_hierarchyCache.clear();
-	m_fullTextSearchIndex.clear();
+
+	std::lock_guard<std::mutex> lock(m_fullTextSearchMutex);
+	m_fullTextSearchIndex.reset();
 	m_fullTextSearchCodec = "";
 }
 
@@ -446,6 +732,21 @@ std::set<FilePath> PersistentStorage::getIncompleteFiles() const
 	return incompleteFiles;
 }
 
+std::set<FilePath> PersistentStorage::getIndexedFiles() const
+{
+	TRACE();
+
+	std::set<FilePath> indexedFiles;
+	m_sqliteIndexStorage.forEach<StorageFile>([&](StorageFile&& file) {
+		if (file.indexed)
+		{
+			indexedFiles.insert(FilePath(file.filePath));
+		}
+	});
+
+	return indexedFiles;
+}
+
 bool PersistentStorage::getFilePathIndexed(const FilePath& path) const
 {
 	Id fileId = getFileNodeId(path);
@@ -457,18 +758,42 @@ bool PersistentStorage::getFilePathIndexed(const FilePath& path) const
 	return false;
 }
 
-void PersistentStorage::buildCaches()
+void PersistentStorage::addIndexingCosts(const std::vector<StorageIndexingCost>& costs)
 {
 	TRACE();
 
+	m_sqliteIndexStorage.beginTransaction();
+	m_sqliteIndexStorage.addIndexingCosts(costs);
+	m_sqliteIndexStorage.commitTransaction();
+}
+
+std::vector<StorageIndexingCost> PersistentStorage::getIndexingCosts() const
+{
+	return m_sqliteIndexStorage.getIndexingCosts();
+}
+
+void PersistentStorage::buildCaches(IndexingReport* report)
+{
+	TRACE();
+
+	IndexingReport::ScopedPhase phase(report, "build caches");
+
 	clearCaches();
 
 	buildFilePathMaps();
-	buildSearchIndex();
+	{
+		IndexingReport::ScopedPhase searchIndexPhase(report, "build search index");
+		buildSearchIndex();
+	}
 	buildMemberEdgeIdOrderMap();
 	buildHierarchyCache();
 }
 
+void PersistentStorage::setConcurrentReadsEnabled(bool enabled)
+{
+	m_sqliteIndexStorage.setConcurrentReadsEnabled(enabled);
+}
+
 void PersistentStorage::optimizeMemory()
 {
 	TRACE();
@@ -594,14 +919,18 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 	}
 
 	const TextCodec codec(ApplicationSettings::getInstance()->getTextEncoding());
+	std::shared_ptr<const FullTextSearchIndex> fullTextSearchIndex;
 	{
 		std::lock_guard<std::mutex> lock(m_fullTextSearchMutex);
 
-		if (m_fullTextSearchCodec != codec.getName())
+		if (!m_fullTextSearchIndex || m_fullTextSearchCodec != codec.getName())
 		{
 			MessageStatus(L"Building fulltext search index", false, true).dispatch();
-			buildFullTextSearchIndex();
+			m_fullTextSearchIndex = buildFullTextSearchIndex(codec);
+			m_fullTextSearchCodec = codec.getName();
 		}
+
+		fullTextSearchIndex = m_fullTextSearchIndex;
 	}
 
 	MessageStatus(
@@ -612,81 +941,63 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 		.dispatch();
 
 	{
-		std::vector<std::shared_ptr<std::thread>> threads;
 		std::mutex collectionMutex;
-		for (std::vector<FullTextSearchResult> fileResults: utility::splitToEqualySizedParts(
-				 m_fullTextSearchIndex.searchForTerm(searchTerm), utility::getIdealThreadCount()))
-		{
-			std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-				[this,
-				 &searchTerm,
-				 &caseSensitive,
-				 &codec,
-				 /*no ref here!*/ fileResults,
-				 &collection,
-				 &collectionMutex]() {
-					const int termLength = searchTerm.length();
-					for (const FullTextSearchResult& fileResult: fileResults)
+		ThreadPool::getInstance()->forEach<FullTextSearchResult>(
+			fullTextSearchIndex->searchForTerm(searchTerm),
+			[this, &searchTerm, &caseSensitive, &codec, &collection, &collectionMutex](
+				const FullTextSearchResult& fileResult) {
+				const int termLength = searchTerm.length();
+				const FilePath filePath = getFileNodePath(fileResult.fileId);
+				std::shared_ptr<TextAccess> fileContent = getFileContent(filePath, false);
+
+				int charsTotal = 0;
+				int lineNumber = 1;
+				std::wstring line = codec.decode(fileContent->getLine(lineNumber));
+
+				for (int pos: fileResult.positions)
+				{
+					while (charsTotal + (int)line.length() <= pos)
 					{
-						const FilePath filePath = getFileNodePath(fileResult.fileId);
-						std::shared_ptr<TextAccess> fileContent = getFileContent(filePath, false);
-
-						int charsTotal = 0;
-						int lineNumber = 1;
-						std::wstring line = codec.decode(fileContent->getLine(lineNumber));
-
-						for (int pos: fileResult.positions)
-						{
-							while (charsTotal + (int)line.length() <= pos)
-							{
-								charsTotal += line.length();
-								lineNumber++;
-								line = codec.decode(fileContent->getLine(lineNumber));
-							}
+						charsTotal += line.length();
+						lineNumber++;
+						line = codec.decode(fileContent->getLine(lineNumber));
+					}
 
-							ParseLocation location;
-							location.startLineNumber = lineNumber;
-							location.startColumnNumber = pos - charsTotal + 1;
+					ParseLocation location;
+					location.startLineNumber = lineNumber;
+					location.startColumnNumber = pos - charsTotal + 1;
 
-							if (caseSensitive &&
-								line.substr(location.startColumnNumber - 1, termLength) != searchTerm)
-							{
-								continue;
-							}
-							while ((charsTotal + (int)line.length()) < pos + termLength)
-							{
-								charsTotal += line.length();
-								lineNumber++;
-								line = codec.decode(fileContent->getLine(lineNumber));
-							}
-							location.endLineNumber = lineNumber;
-							location.endColumnNumber = pos + termLength - charsTotal;
-
-							{
-								std::lock_guard<std::mutex> lock(collectionMutex);
-								// Set first bit to 1 to avoid collisions
-								const Id locationId = ~(~Id(0) >> 1) +
-									collection->getSourceLocationCount() + 1;
-								collection->addSourceLocation(
-									LOCATION_FULLTEXT_SEARCH,
-									locationId,
-									std::vector<Id>(),
-									filePath,
-									location.startLineNumber,
-									location.startColumnNumber,
-									location.endLineNumber,
-									location.endColumnNumber);
-							}
-						}
+					if (caseSensitive &&
+						line.substr(location.startColumnNumber - 1, termLength) != searchTerm)
+					{
+						continue;
 					}
-				});
-			threads.push_back(thread);
-		}
+					while ((charsTotal + (int)line.length()) < pos + termLength)
+					{
+						charsTotal += line.length();
+						lineNumber++;
+						line = codec.decode(fileContent->getLine(lineNumber));
+					}
+					location.endLineNumber = lineNumber;
+					location.endColumnNumber = pos + termLength - charsTotal;
 
-		for (std::shared_ptr<std::thread> thread: threads)
-		{
-			thread->join();
-		}
+					{
+						std::lock_guard<std::mutex> lock(collectionMutex);
+						// Set first bit to 1 to avoid collisions
+						const Id locationId = ~(~Id(0) >> 1) +
+							collection->getSourceLocationCount() + 1;
+						collection->addSourceLocation(
+							LOCATION_FULLTEXT_SEARCH,
+							locationId,
+							std::vector<Id>(),
+							filePath,
+							location.startLineNumber,
+							location.startColumnNumber,
+							location.endLineNumber,
+							location.endColumnNumber);
+					}
+				}
+			});
 	}
 
 	addCompleteFlagsToSourceLocationCollection(collection.get());
@@ -708,8 +1019,11 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 {
 	TRACE();
 
-	// search in indices
-	const size_t maxResultsCount = std::pow(3, query.size() + 3);
+	// search in indices, longer queries match less and may look at more results. The count is only
+	// bounded so it does not overflow for long queries, the search index multiplies it by 3.
+	const size_t maxResultsCount = static_cast<size_t>(std::min(
+		std::pow(3.0, double(query.size() + 3)),
+		double(std::numeric_limits<size_t>::max() / 4)));
 	const size_t maxBestScoredResultsLength = 100;
 	const size_t maxMatchesReturned = 1000;
 
@@ -735,10 +1049,7 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 	}
 
 	// Rescore search matches to check if better score is achieved with higher indices
-	std::vector<SearchMatch> rescoredMatches;
-	rescoredMatches.reserve(matches.size());
-
-	for (SearchMatch match: matches)
+	for (SearchMatch& match: matches)
 	{
 		// rescore match
 		if (!match.subtext.empty() && match.indices.size())
@@ -749,15 +1060,14 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 			match.score = newResult.score;
 			match.indices = std::move(newResult.indices);
 		}
-
-		rescoredMatches.emplace_back(match);
 	}
 
 	// Score child symbol matches with same score as parent lower
 	const SearchMatch* lastMatch = nullptr;
-	std::set<SearchMatch> matchesSet;
+	std::vector<SearchMatch> scoredMatches;
+	scoredMatches.reserve(matches.size());
 
-	for (SearchMatch match: rescoredMatches)
+	for (SearchMatch match: matches)
 	{
 		if (lastMatch == nullptr || !utility::isPrefix(lastMatch->name, match.name))
 		{
@@ -776,19 +1086,23 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 			}
 		}
 
-		matchesSet.insert(match);
+		scoredMatches.push_back(match);
 	}
 
-	if (matchesSet.size() > maxMatchesReturned)
-	{
-		auto it = matchesSet.begin();
-		std::advance(it, maxMatchesReturned);
-		matches = std::vector<SearchMatch>(matchesSet.begin(), it);
-	}
-	else
+	// sort and drop equivalent matches like a std::set would, but without a node per match
+	std::stable_sort(scoredMatches.begin(), scoredMatches.end());
+	scoredMatches.erase(
+		std::unique(
+			scoredMatches.begin(),
+			scoredMatches.end(),
+			[](const SearchMatch& a, const SearchMatch& b) { return !(a < b) && !(b < a); }),
+		scoredMatches.end());
+
+	if (scoredMatches.size() > maxMatchesReturned)
 	{
-		matches = utility::toVector(matchesSet);
+		scoredMatches.resize(maxMatchesReturned);
 	}
+	matches = std::move(scoredMatches);
 
 	// for (auto a : matches)
 	// {
@@ -3311,46 +3625,30 @@ void PersistentStorage::buildSearchIndex()
 	m_fileIndex.finishSetup();
 }
 
-void PersistentStorage::buildFullTextSearchIndex() const
+std::shared_ptr<const FullTextSearchIndex> PersistentStorage::buildFullTextSearchIndex(
+	const TextCodec& codec) const
 {
 	TRACE();
 
-	TextCodec codec(ApplicationSettings::getInstance()->getTextEncoding());
+	std::shared_ptr<FullTextSearchIndex> fullTextSearchIndex =
+		std::make_shared<FullTextSearchIndex>();
 
-	m_fullTextSearchCodec = codec.getName();
-
-	m_fullTextSearchIndex.clear();
-
-	std::vector<std::shared_ptr<std::thread>> threads;
+	std::vector<StorageFile> indexedFiles;
+	for (const StorageFile& file: m_sqliteIndexStorage.getAll<StorageFile>())
 	{
-		std::vector<StorageFile> indexedFiles;
-		for (const StorageFile& file: m_sqliteIndexStorage.getAll<StorageFile>())
+		if (file.indexed)
 		{
-			if (file.indexed)
-			{
-				indexedFiles.push_back(file);
-			}
+			indexedFiles.push_back(file);
 		}
-		for (std::vector<StorageFile> part:
-			 utility::splitToEqualySizedParts(indexedFiles, utility::getIdealThreadCount()))
-		{
-			std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-				[&](const std::vector<StorageFile>& files) {
-					for (const StorageFile& file: files)
-					{
-						m_fullTextSearchIndex.addFile(
-							file.id,
-							codec.decode(m_sqliteIndexStorage.getFileContentById(file.id)->getText()));
-					}
-				},
-				part);
-			threads.push_back(thread);
-		}
-	}
-	for (std::shared_ptr<std::thread> thread: threads)
-	{
-		thread->join();
 	}
+
+	// file sizes vary a lot, so files are handed out one by one instead of in fixed parts
+	ThreadPool::getInstance()->forEach<StorageFile>(indexedFiles, [&](const StorageFile& file) {
+		fullTextSearchIndex->addFile(
+			file.id, codec.decode(m_sqliteIndexStorage.getFileContentById(file.id)->getText()));
+	});
+
+	return fullTextSearchIndex;
 }
 
 void PersistentStorage::buildMemberEdgeIdOrderMap()
@@ -12,12 +12,16 @@
 #include "Storage.h"
 #include "StorageAccess.h"
 
+class IndexingReport;
+class TextCodec;
+
 class PersistentStorage
 	: public Storage
 	, public StorageAccess
 {
 public:
-	PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath);
+	// a read-only storage only reads the existing index database, it must not be set up
+	PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath, bool readOnly = false);
 
 	std::pair<Id, bool> addNode(const StorageNodeData& data) override;
 	std::vector<Id> addNodes(const std::vector<StorageNode>& nodes) override;
@@ -59,6 +63,10 @@ public:
 	void finishInjection() override;
 	void rollbackInjection();
 
+	// merges the index database at the path into this storage by streaming its tables in batches,
+	// so neither storage needs to build caches or load whole tables
+	void injectDatabase(const FilePath& dbFilePath, IndexingReport* report = nullptr);
+
 	void beforeErrorRecording();
 	void afterErrorRecording();
 
@@ -72,6 +80,14 @@ public:
 	std::string getProjectSettingsText() const;
 	void setProjectSettingsText(std::string text);
 
+	// json report of the indexing run that created this database
+	std::string getIndexingReport() const;
+	void setIndexingReport(const std::string& report);
+
+	// files of an indexing run that is still writing to this database, empty once it finished
+	std::string getIndexingCheckpoint() const;
+	void setIndexingCheckpoint(const std::string& checkpoint);
+
 	void setup();
 	void updateVersion();
 	void clear();
@@ -86,12 +102,22 @@ public:
 
 	std::vector<FileInfo> getFileInfoForAllFiles() const;
 	std::set<FilePath> getIncompleteFiles() const;
+	// reads the database directly, so it also works without built caches
+	std::set<FilePath> getIndexedFiles() const;
 	bool getFilePathIndexed(const FilePath& path) const;
 
-	void buildCaches();
+	void addIndexingCosts(const std::vector<StorageIndexingCost>& costs);
+	std::vector<StorageIndexingCost> getIndexingCosts() const;
+
+	// the report receives the time spent building the caches, if passed
+	void buildCaches(IndexingReport* report = nullptr);
 
 	void optimizeMemory();
 
+	// lets views, tooltips and prefetches on different threads query the index in parallel once
+	// it is only read anymore, see SqliteStorage::setConcurrentReadsEnabled
+	void setConcurrentReadsEnabled(bool enabled);
+
 	// StorageAccess implementation
 	Id getNodeIdForFileNode(const FilePath& filePath) const override;
 	Id getNodeIdForNameHierarchy(const NameHierarchy& nameHierarchy) const override;
@@ -253,7 +279,8 @@ private:
 
 	void buildFilePathMaps();
 	void buildSearchIndex();
-	void buildFullTextSearchIndex() const;
+	std::shared_ptr<const FullTextSearchIndex> buildFullTextSearchIndex(
+		const TextCodec& codec) const;
 	void buildMemberEdgeIdOrderMap();
 	void buildHierarchyCache();
 
@@ -265,7 +292,8 @@ private:
 	SearchIndex m_symbolIndex;
 	SearchIndex m_fileIndex;
 
-	mutable FullTextSearchIndex m_fullTextSearchIndex;
+	// built on first use and replaced as a whole, so running searches keep their index
+	mutable std::shared_ptr<const FullTextSearchIndex> m_fullTextSearchIndex;
 	mutable std::string m_fullTextSearchCodec;
 	mutable std::mutex m_fullTextSearchMutex;
 
@@ -1,11 +1,12 @@
 #include "Storage.h"
 
+#include "IndexingReport.h"
 #include "logging.h"
 #include "tracing.h"
 
 Storage::Storage() {}
 
-void Storage::inject(Storage* injected)
+void Storage::inject(Storage* injected, IndexingReport* report)
 {
 	std::lock_guard<std::mutex> lock(m_dataMutex);
 
@@ -16,7 +17,7 @@ void Storage::inject(Storage* injected)
 	startInjection();
 
 	{
-		// TRACE("inject errors");
+		IndexingReport::ScopedPhase phase(report, "inject errors");
 
 		for (const StorageError& error: injected->getErrors())
 		{
@@ -26,7 +27,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject nodes");
+		IndexingReport::ScopedPhase phase(report, "inject nodes");
 
 		const std::vector<StorageNode>& nodes = injected->getStorageNodes();
 
@@ -42,7 +43,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject files");
+		IndexingReport::ScopedPhase phase(report, "inject files");
 
 		for (const StorageFile& file: injected->getStorageFiles())
 		{
@@ -61,7 +62,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject symbols");
+		IndexingReport::ScopedPhase phase(report, "inject symbols");
 
 		std::vector<StorageSymbol> symbols = injected->getStorageSymbols();
 		for (size_t i = 0; i < symbols.size(); i++)
@@ -83,7 +84,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject edges");
+		IndexingReport::ScopedPhase phase(report, "inject edges");
 
 		std::vector<StorageEdge> edges = injected->getStorageEdges();
 		for (size_t i = 0; i < edges.size(); i++)
@@ -132,7 +133,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject local symbols");
+		IndexingReport::ScopedPhase phase(report, "inject local symbols");
 
 		const std::set<StorageLocalSymbol>& symbols = injected->getStorageLocalSymbols();
 		std::vector<Id> symbolIds = addLocalSymbols(symbols);
@@ -149,7 +150,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject locations");
+		IndexingReport::ScopedPhase phase(report, "inject locations");
 
 		const std::set<StorageSourceLocation>& oldLocations = injected->getStorageSourceLocations();
 		std::vector<StorageSourceLocation> locations;
@@ -191,7 +192,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject occurrences");
+		IndexingReport::ScopedPhase phase(report, "inject occurrences");
 
 		const std::set<StorageOccurrence>& oldOccurences = injected->getStorageOccurrences();
 
@@ -233,7 +234,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject element components");
+		IndexingReport::ScopedPhase phase(report, "inject element components");
 
 		const std::set<StorageElementComponent>& oldComponents = injected->getElementComponents();
 		std::vector<StorageElementComponent> components;
@@ -252,7 +253,7 @@ void Storage::inject(Storage* injected)
 	}
 
 	{
-		// TRACE("inject accesses");
+		IndexingReport::ScopedPhase phase(report, "inject accesses");
 
 		const std::set<StorageComponentAccess>& oldAccesses = injected->getComponentAccesses();
 		std::vector<StorageComponentAccess> accesses;
@@ -270,7 +271,10 @@ void Storage::inject(Storage* injected)
 		addComponentAccesses(accesses);
 	}
 
-	finishInjection();
+	{
+		IndexingReport::ScopedPhase phase(report, "inject commit");
+		finishInjection();
+	}
 }
 
 void Storage::startInjection()
@@ -18,6 +18,8 @@
 #include "StorageSymbol.h"
 #include "types.h"
 
+class IndexingReport;
+
 class Storage
 {
 public:
@@ -54,7 +56,8 @@ public:
 	virtual const std::set<StorageElementComponent>& getElementComponents() const = 0;
 	virtual const std::vector<StorageError>& getErrors() const = 0;
 
-	void inject(Storage* injected);
+	// the report receives the time spent per table, if passed
+	void inject(Storage* injected, IndexingReport* report = nullptr);
 
 private:
 	virtual void startInjection();
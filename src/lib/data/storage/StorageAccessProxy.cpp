@@ -11,15 +11,46 @@
 
 void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 {
+	std::lock_guard<std::mutex> lock(m_subjectMutex);
 	m_subject = subject;
 }
 
+std::shared_ptr<StorageAccess> StorageAccessProxy::getSubject() const
+{
+	std::lock_guard<std::mutex> lock(m_subjectMutex);
+	std::shared_ptr<StorageAccess> subject = m_subject.lock();
+	if (!subject)
+	{
+		return subject;
+	}
+
+	// the returned pointer counts as a reader until the query drops it
+	m_readerCount++;
+	StorageAccess* rawSubject = subject.get();
+	return std::shared_ptr<StorageAccess>(rawSubject, [this, subject](StorageAccess*) mutable {
+		subject.reset();
+
+		std::lock_guard<std::mutex> lock(m_subjectMutex);
+		m_readerCount--;
+		if (m_readerCount == 0)
+		{
+			m_readersFinished.notify_all();
+		}
+	});
+}
+
+void StorageAccessProxy::waitForReaders() const
+{
+	std::unique_lock<std::mutex> lock(m_subjectMutex);
+	m_readersFinished.wait(lock, [this]() { return m_readerCount == 0; });
+}
+
 #define UNWRAP(...) __VA_ARGS__
 
 #define DEF_GETTER_0(_METHOD_NAME_, _RETURN_TYPE_, _DEFAULT_VALUE_)                                \
 	UNWRAP(_RETURN_TYPE_) StorageAccessProxy::_METHOD_NAME_() const                                \
 	{                                                                                              \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                             \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                 \
 		{                                                                                          \
 			return subject->_METHOD_NAME_();                                                       \
 		}                                                                                          \
@@ -29,7 +60,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 #define DEF_GETTER_1(_METHOD_NAME_, _PARAM_1_TYPE_, _RETURN_TYPE_, _DEFAULT_VALUE_)                \
 	UNWRAP(_RETURN_TYPE_) StorageAccessProxy::_METHOD_NAME_(_PARAM_1_TYPE_ p1) const               \
 	{                                                                                              \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                             \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                 \
 		{                                                                                          \
 			return subject->_METHOD_NAME_(p1);                                                     \
 		}                                                                                          \
@@ -40,7 +71,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 	UNWRAP(_RETURN_TYPE_)                                                                           \
 	StorageAccessProxy::_METHOD_NAME_(_PARAM_1_TYPE_ p1, _PARAM_2_TYPE_ p2) const                   \
 	{                                                                                               \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                              \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                  \
 		{                                                                                           \
 			return subject->_METHOD_NAME_(p1, p2);                                                  \
 		}                                                                                           \
@@ -52,7 +83,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 	UNWRAP(_RETURN_TYPE_)                                                                            \
 	StorageAccessProxy::_METHOD_NAME_(_PARAM_1_TYPE_ p1, _PARAM_2_TYPE_ p2, _PARAM_3_TYPE_ p3) const \
 	{                                                                                                \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                               \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                   \
 		{                                                                                            \
 			return subject->_METHOD_NAME_(p1, p2, p3);                                               \
 		}                                                                                            \
@@ -71,7 +102,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 	StorageAccessProxy::_METHOD_NAME_(                                                             \
 		_PARAM_1_TYPE_ p1, _PARAM_2_TYPE_ p2, _PARAM_3_TYPE_ p3, _PARAM_4_TYPE_ p4) const          \
 	{                                                                                              \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                             \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                 \
 		{                                                                                          \
 			return subject->_METHOD_NAME_(p1, p2, p3, p4);                                         \
 		}                                                                                          \
@@ -92,7 +123,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 		_PARAM_1_TYPE_ p1, _PARAM_2_TYPE_ p2, _PARAM_3_TYPE_ p3, _PARAM_4_TYPE_ p4, _PARAM_5_TYPE_ p5) \
 		const                                                                                          \
 	{                                                                                                  \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                                 \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                     \
 		{                                                                                              \
 			return subject->_METHOD_NAME_(p1, p2, p3, p4, p5);                                         \
 		}                                                                                              \
@@ -118,7 +149,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 		_PARAM_5_TYPE_ p5,                                                                         \
 		_PARAM_6_TYPE_ p6) const                                                                   \
 	{                                                                                              \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                             \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                 \
 		{                                                                                          \
 			return subject->_METHOD_NAME_(p1, p2, p3, p4, p5, p6);                                 \
 		}                                                                                          \
@@ -146,7 +177,7 @@ void StorageAccessProxy::setSubject(std::weak_ptr<StorageAccess> subject)
 		_PARAM_6_TYPE_ p6,                                                                         \
 		_PARAM_7_TYPE_ p7) const                                                                   \
 	{                                                                                              \
-		if (std::shared_ptr<StorageAccess> subject = m_subject.lock())                             \
+		if (std::shared_ptr<StorageAccess> subject = getSubject())                                 \
 		{                                                                                          \
 			return subject->_METHOD_NAME_(p1, p2, p3, p4, p5, p6, p7);                             \
 		}                                                                                          \
@@ -251,7 +282,7 @@ DEF_GETTER_1(
 
 Id StorageAccessProxy::addNodeBookmark(const NodeBookmark& bookmark)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		return subject->addNodeBookmark(bookmark);
 	}
@@ -261,7 +292,7 @@ Id StorageAccessProxy::addNodeBookmark(const NodeBookmark& bookmark)
 
 Id StorageAccessProxy::addEdgeBookmark(const EdgeBookmark& bookmark)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		return subject->addEdgeBookmark(bookmark);
 	}
@@ -271,7 +302,7 @@ Id StorageAccessProxy::addEdgeBookmark(const EdgeBookmark& bookmark)
 
 Id StorageAccessProxy::addBookmarkCategory(const std::wstring& categoryName)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		return subject->addBookmarkCategory(categoryName);
 	}
@@ -285,7 +316,7 @@ void StorageAccessProxy::updateBookmark(
 	const std::wstring& comment,
 	const std::wstring& categoryName)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		subject->updateBookmark(bookmarkId, name, comment, categoryName);
 	}
@@ -293,7 +324,7 @@ void StorageAccessProxy::updateBookmark(
 
 void StorageAccessProxy::removeBookmark(const Id id)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		subject->removeBookmark(id);
 	}
@@ -301,7 +332,7 @@ void StorageAccessProxy::removeBookmark(const Id id)
 
 void StorageAccessProxy::removeBookmarkCategory(const Id id)
 {
-	if (std::shared_ptr<StorageAccess> subject = m_subject.lock())
+	if (std::shared_ptr<StorageAccess> subject = getSubject())
 	{
 		subject->removeBookmarkCategory(id);
 	}
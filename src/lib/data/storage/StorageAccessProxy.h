@@ -1,7 +1,9 @@
 #ifndef STORAGE_ACCESS_PROXY_H
 #define STORAGE_ACCESS_PROXY_H
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include "StorageAccess.h"
 
@@ -10,7 +12,13 @@ class StorageAccessProxy: public StorageAccess
 public:
 	StorageAccessProxy() = default;
 
-	void setSubject(std::weak_ptr<StorageAccess> subject);
+	// the subject is accessed by the threads running queries, so it is only read under the lock
+	virtual void setSubject(std::weak_ptr<StorageAccess> subject);
+	std::shared_ptr<StorageAccess> getSubject() const;
+
+	// blocks until all queries that got the subject from this proxy have finished, so the subject
+	// can be destroyed after it was replaced
+	void waitForReaders() const;
 
 	// StorageAccess implementation
 	Id getNodeIdForFileNode(const FilePath& filePath) const override;
@@ -107,6 +115,11 @@ public:
 
 private:
 	std::weak_ptr<StorageAccess> m_subject;
+	mutable std::mutex m_subjectMutex;
+
+	// number of subject pointers handed out by getSubject() that are still alive
+	mutable size_t m_readerCount = 0;
+	mutable std::condition_variable m_readersFinished;
 };
 
 #endif	  // STORAGE_ACCESS_PROXY_H
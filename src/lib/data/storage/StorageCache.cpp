@@ -1,42 +1,312 @@
 #include "StorageCache.h"
 
+#include <set>
+
+#include "CancellationToken.h"
+#include "Graph.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "utility.h"
 
+namespace
+{
+thread_local bool s_isPrefetching = false;
+
+std::mutex s_prefetchTokensMutex;
+std::set<std::shared_ptr<CancellationToken>> s_prefetchTokens;
+
+// a value only found in the prefetch cache is moved to the main cache once it is actually used
+template <typename KeyType, typename ValType>
+bool getCachedValue(
+	LruCache<KeyType, ValType>& cache,
+	LruCache<KeyType, ValType>& prefetchCache,
+	const KeyType& key,
+	ValType* value)
+{
+	if (cache.getValue(key, value))
+	{
+		return true;
+	}
+
+	if (prefetchCache.getValue(key, value))
+	{
+		if (!s_isPrefetching)
+		{
+			cache.setValue(key, *value);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+template <typename KeyType, typename ValType>
+void setCachedValue(
+	LruCache<KeyType, ValType>& cache,
+	LruCache<KeyType, ValType>& prefetchCache,
+	const KeyType& key,
+	const ValType& value)
+{
+	(s_isPrefetching ? prefetchCache : cache).setValue(key, value);
+}
+
+// callers modify the graphs and collections they get, so cached ones are only handed out as copies
+std::shared_ptr<Graph> copyGraph(std::shared_ptr<Graph> graph)
+{
+	if (!graph)
+	{
+		return graph;
+	}
+
+	std::shared_ptr<Graph> copy = std::make_shared<Graph>();
+	graph->forEachNode([&copy](Node* node) { copy->addNodeAsPlainCopy(node); });
+	graph->forEachEdge([&copy](Edge* edge) { copy->addEdgeAsPlainCopy(edge); });
+	copy->setTrailMode(graph->getTrailMode());
+	copy->setHasTrailOrigin(graph->hasTrailOrigin());
+	return copy;
+}
+
+std::shared_ptr<SourceLocationCollection> copyCollection(
+	std::shared_ptr<SourceLocationCollection> collection)
+{
+	if (!collection)
+	{
+		return collection;
+	}
+
+	std::shared_ptr<SourceLocationCollection> copy = std::make_shared<SourceLocationCollection>();
+	copy->addSourceLocationCopies(collection.get());
+	return copy;
+}
+}	 // namespace
+
+StorageCache::ScopedPrefetch::ScopedPrefetch(std::shared_ptr<CancellationToken> token)
+	: m_token(token)
+{
+	s_isPrefetching = true;
+
+	std::lock_guard<std::mutex> lock(s_prefetchTokensMutex);
+	s_prefetchTokens.insert(m_token);
+}
+
+StorageCache::ScopedPrefetch::~ScopedPrefetch()
+{
+	s_isPrefetching = false;
+
+	std::lock_guard<std::mutex> lock(s_prefetchTokensMutex);
+	s_prefetchTokens.erase(m_token);
+}
+
+void StorageCache::cancelPrefetches()
+{
+	std::lock_guard<std::mutex> lock(s_prefetchTokensMutex);
+	for (const std::shared_ptr<CancellationToken>& token: s_prefetchTokens)
+	{
+		token->cancel();
+	}
+}
+
+StorageCache::StorageCache()
+	: m_graphsForActiveTokenIds(20)
+	, m_activeTokenIds(100)
+	, m_sourceLocationsForTokenIds(20)
+	, m_tooltipInfos(50)
+	, m_tooltipInfosForLocations(50)
+	, m_prefetchedGraphs(10)
+	, m_prefetchedActiveTokenIds(20)
+	, m_prefetchedSourceLocations(10)
+{
+}
+
+void StorageCache::setSubject(std::weak_ptr<StorageAccess> subject)
+{
+	StorageAccessProxy::setSubject(subject);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_generation++;
+}
+
 void StorageCache::clear()
 {
-	m_graphForAll.reset();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_generation++;
+
+		m_graphForAll.reset();
+
+		m_storageStats = StorageStats();
+
+		m_useErrorCache = false;
+		m_cachedErrors.clear();
+		m_errorCount = ErrorCountInfo();
+	}
+
+	clearQueryResults();
+}
+
+void StorageCache::clearQueryResults()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_generation++;
 
-	m_storageStats = StorageStats();
+	m_graphsForActiveTokenIds.clear();
+	m_activeTokenIds.clear();
+	m_sourceLocationsForTokenIds.clear();
+	m_tooltipInfos.clear();
+	m_tooltipInfosForLocations.clear();
 
-	setUseErrorCache(false);
+	m_prefetchedGraphs.clear();
+	m_prefetchedActiveTokenIds.clear();
+	m_prefetchedSourceLocations.clear();
 }
 
 std::shared_ptr<Graph> StorageCache::getGraphForAll() const
 {
-	if (!m_graphForAll)
+	size_t generation = 0;
 	{
-		m_graphForAll = StorageAccessProxy::getGraphForAll();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_graphForAll)
+		{
+			return m_graphForAll;
+		}
+		generation = m_generation;
 	}
 
+	// computed without holding the lock, so other queries are not blocked meanwhile
+	std::shared_ptr<Graph> graph = StorageAccessProxy::getGraphForAll();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (generation != m_generation)
+	{
+		return graph;
+	}
+	if (!m_graphForAll)
+	{
+		m_graphForAll = graph;
+	}
 	return m_graphForAll;
 }
 
+std::shared_ptr<Graph> StorageCache::getGraphForActiveTokenIds(
+	const std::vector<Id>& tokenIds,
+	const std::vector<Id>& expandedNodeIds,
+	bool* isActiveNamespace) const
+{
+	const IdsPair key(tokenIds, expandedNodeIds);
+	std::pair<std::shared_ptr<Graph>, bool> result;
+	bool found = false;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		found = getCachedValue(m_graphsForActiveTokenIds, m_prefetchedGraphs, key, &result);
+		generation = m_generation;
+	}
+
+	if (!found)
+	{
+		bool isNamespace = false;
+		result.first = StorageAccessProxy::getGraphForActiveTokenIds(
+			tokenIds, expandedNodeIds, &isNamespace);
+		result.second = isNamespace;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (generation == m_generation)
+		{
+			setCachedValue(m_graphsForActiveTokenIds, m_prefetchedGraphs, key, result);
+		}
+	}
+
+	if (isActiveNamespace)
+	{
+		*isActiveNamespace = result.second;
+	}
+	return copyGraph(result.first);
+}
+
+std::vector<Id> StorageCache::getActiveTokenIdsForId(Id tokenId, Id* declarationId) const
+{
+	std::pair<std::vector<Id>, Id> result;
+	bool found = false;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		found = getCachedValue(m_activeTokenIds, m_prefetchedActiveTokenIds, tokenId, &result);
+		generation = m_generation;
+	}
+
+	if (!found)
+	{
+		result.second = 0;
+		result.first = StorageAccessProxy::getActiveTokenIdsForId(tokenId, &result.second);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (generation == m_generation)
+		{
+			setCachedValue(m_activeTokenIds, m_prefetchedActiveTokenIds, tokenId, result);
+		}
+	}
+
+	if (declarationId)
+	{
+		*declarationId = result.second;
+	}
+	return result.first;
+}
+
+std::shared_ptr<SourceLocationCollection> StorageCache::getSourceLocationsForTokenIds(
+	const std::vector<Id>& tokenIds) const
+{
+	std::shared_ptr<SourceLocationCollection> collection;
+	bool found = false;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		found = getCachedValue(
+			m_sourceLocationsForTokenIds, m_prefetchedSourceLocations, tokenIds, &collection);
+		generation = m_generation;
+	}
+
+	if (!found)
+	{
+		collection = StorageAccessProxy::getSourceLocationsForTokenIds(tokenIds);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (generation == m_generation)
+		{
+			setCachedValue(
+				m_sourceLocationsForTokenIds, m_prefetchedSourceLocations, tokenIds, collection);
+		}
+	}
+
+	return copyCollection(collection);
+}
+
 StorageStats StorageCache::getStorageStats() const
 {
-	if (!m_storageStats.nodeCount)
+	size_t generation = 0;
 	{
-		m_storageStats = StorageAccessProxy::getStorageStats();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_storageStats.nodeCount)
+		{
+			return m_storageStats;
+		}
+		generation = m_generation;
 	}
 
-	return m_storageStats;
+	const StorageStats stats = StorageAccessProxy::getStorageStats();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (generation == m_generation)
+	{
+		m_storageStats = stats;
+	}
+	return stats;
 }
 
 std::shared_ptr<TextAccess> StorageCache::getFileContent(const FilePath& filePath, bool showsErrors) const
 {
-	if (m_useErrorCache && showsErrors)
+	if (isErrorCacheUsed() && showsErrors)
 	{
 		return TextAccess::createFromFile(filePath);
 	}
@@ -46,33 +316,39 @@ std::shared_ptr<TextAccess> StorageCache::getFileContent(const FilePath& filePat
 
 ErrorCountInfo StorageCache::getErrorCount() const
 {
-	if (!m_useErrorCache)
 	{
-		return StorageAccessProxy::getErrorCount();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_useErrorCache)
+		{
+			return m_errorCount;
+		}
 	}
 
-	return m_errorCount;
+	return StorageAccessProxy::getErrorCount();
 }
 
 std::vector<ErrorInfo> StorageCache::getErrorsLimited(const ErrorFilter& filter) const
 {
-	if (!m_useErrorCache)
 	{
-		return StorageAccessProxy::getErrorsLimited(filter);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_useErrorCache)
+		{
+			return filter.filterErrors(m_cachedErrors);
+		}
 	}
 
-	return filter.filterErrors(m_cachedErrors);
+	return StorageAccessProxy::getErrorsLimited(filter);
 }
 
 std::vector<ErrorInfo> StorageCache::getErrorsForFileLimited(
 	const ErrorFilter& filter, const FilePath& filePath) const
 {
-	if (!m_useErrorCache)
+	if (isErrorCacheUsed())
 	{
-		return StorageAccessProxy::getErrorsForFileLimited(filter, filePath);
+		return {};
 	}
 
-	return {};
+	return StorageAccessProxy::getErrorsForFileLimited(filter, filePath);
 }
 
 std::shared_ptr<SourceLocationCollection> StorageCache::getErrorSourceLocations(
@@ -81,14 +357,19 @@ std::shared_ptr<SourceLocationCollection> StorageCache::getErrorSourceLocations(
 	std::shared_ptr<SourceLocationCollection> collection =
 		StorageAccessProxy::getErrorSourceLocations(errors);
 
-	if (m_useErrorCache)
+	bool useErrorCache = false;
+	std::map<std::wstring, bool> fileIndexed;
 	{
-		std::map<std::wstring, bool> fileIndexed;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		useErrorCache = m_useErrorCache;
 		for (const ErrorInfo& error: m_cachedErrors)
 		{
 			fileIndexed.emplace(error.filePath, error.indexed);
 		}
+	}
 
+	if (useErrorCache)
+	{
 		collection->forEachSourceLocationFile([&](std::shared_ptr<SourceLocationFile> file) {
 			file->setIsComplete(false);
 
@@ -107,9 +388,60 @@ std::shared_ptr<SourceLocationCollection> StorageCache::getErrorSourceLocations(
 	return collection;
 }
 
+TooltipInfo StorageCache::getTooltipInfoForTokenIds(
+	const std::vector<Id>& tokenIds, TooltipOrigin origin) const
+{
+	const std::pair<std::vector<Id>, TooltipOrigin> key(tokenIds, origin);
+	TooltipInfo info;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_tooltipInfos.getValue(key, &info))
+		{
+			return info;
+		}
+		generation = m_generation;
+	}
+
+	info = StorageAccessProxy::getTooltipInfoForTokenIds(tokenIds, origin);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (generation == m_generation)
+	{
+		m_tooltipInfos.setValue(key, info);
+	}
+	return info;
+}
+
+TooltipInfo StorageCache::getTooltipInfoForSourceLocationIdsAndLocalSymbolIds(
+	const std::vector<Id>& locationIds, const std::vector<Id>& localSymbolIds) const
+{
+	const IdsPair key(locationIds, localSymbolIds);
+	TooltipInfo info;
+	size_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_tooltipInfosForLocations.getValue(key, &info))
+		{
+			return info;
+		}
+		generation = m_generation;
+	}
+
+	info = StorageAccessProxy::getTooltipInfoForSourceLocationIdsAndLocalSymbolIds(
+		locationIds, localSymbolIds);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (generation == m_generation)
+	{
+		m_tooltipInfosForLocations.setValue(key, info);
+	}
+	return info;
+}
 
 void StorageCache::setUseErrorCache(bool enabled)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
 	m_useErrorCache = enabled;
 	m_cachedErrors.clear();
 	m_errorCount = ErrorCountInfo();
@@ -118,6 +450,13 @@ void StorageCache::setUseErrorCache(bool enabled)
 void StorageCache::addErrorsToCache(
 	const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
 	utility::append(m_cachedErrors, newErrors);
 	m_errorCount = errorCount;
 }
+
+bool StorageCache::isErrorCacheUsed() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_useErrorCache;
+}
@@ -2,16 +2,55 @@
 #define STORAGE_CACHE_H
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 
+#include "LruCache.h"
 #include "StorageAccessProxy.h"
 
+class CancellationToken;
+
 class StorageCache: public StorageAccessProxy
 {
 public:
+	// Marks the queries of the current thread as prefetches while alive. Their results are kept
+	// apart from the ones the user asked for, so guessing wrong does not evict those. The token
+	// gets cancelled by cancelPrefetches() while the prefetch runs.
+	class ScopedPrefetch
+	{
+	public:
+		ScopedPrefetch(std::shared_ptr<CancellationToken> token);
+		~ScopedPrefetch();
+
+	private:
+		std::shared_ptr<CancellationToken> m_token;
+	};
+
+	// cancels the prefetches running on any thread, e.g. before the storage gets replaced
+	static void cancelPrefetches();
+
+	StorageCache();
+
+	void setSubject(std::weak_ptr<StorageAccess> subject) override;
+
 	void clear();
 
+	// drops the cached query results, which become stale once indexing finished
+	void clearQueryResults();
+
 	std::shared_ptr<Graph> getGraphForAll() const override;
 
+	std::shared_ptr<Graph> getGraphForActiveTokenIds(
+		const std::vector<Id>& tokenIds,
+		const std::vector<Id>& expandedNodeIds,
+		bool* isActiveNamespace = nullptr) const override;
+
+	std::vector<Id> getActiveTokenIdsForId(Id tokenId, Id* declarationId) const override;
+
+	std::shared_ptr<SourceLocationCollection> getSourceLocationsForTokenIds(
+		const std::vector<Id>& tokenIds) const override;
+
 	StorageStats getStorageStats() const override;
 
 	std::shared_ptr<TextAccess> getFileContent(const FilePath& filePath, bool showsErrors) const override;
@@ -23,17 +62,48 @@ public:
 	std::shared_ptr<SourceLocationCollection> getErrorSourceLocations(
 		const std::vector<ErrorInfo>& errors) const override;
 
+	TooltipInfo getTooltipInfoForTokenIds(
+		const std::vector<Id>& tokenIds, TooltipOrigin origin) const override;
+	TooltipInfo getTooltipInfoForSourceLocationIdsAndLocalSymbolIds(
+		const std::vector<Id>& locationIds, const std::vector<Id>& localSymbolIds) const override;
+
 	void setUseErrorCache(bool enabled) override;
 	void addErrorsToCache(
 		const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount) override;
 
 private:
+	typedef std::pair<std::vector<Id>, std::vector<Id>> IdsPair;
+
+	bool isErrorCacheUsed() const;
+
+	// views, tooltips and prefetches may query the cache from different threads
+	mutable std::mutex m_mutex;
+
+	// incremented whenever cached results become stale. Queries run without holding the lock, so
+	// their results are only stored if the generation did not change in the meantime.
+	size_t m_generation = 0;
+
 	mutable std::shared_ptr<Graph> m_graphForAll;
 	mutable StorageStats m_storageStats;
 
 	bool m_useErrorCache = false;
 	ErrorCountInfo m_errorCount;
 	std::vector<ErrorInfo> m_cachedErrors;
+
+	// results of the queries run when activating a symbol, so navigating back and forth or
+	// replaying the history does not query the database again
+	mutable LruCache<IdsPair, std::pair<std::shared_ptr<Graph>, bool>> m_graphsForActiveTokenIds;
+	mutable LruCache<Id, std::pair<std::vector<Id>, Id>> m_activeTokenIds;
+	mutable LruCache<std::vector<Id>, std::shared_ptr<SourceLocationCollection>>
+		m_sourceLocationsForTokenIds;
+	mutable LruCache<std::pair<std::vector<Id>, TooltipOrigin>, TooltipInfo> m_tooltipInfos;
+	mutable LruCache<IdsPair, TooltipInfo> m_tooltipInfosForLocations;
+
+	// results of prefetched activations, moved to the caches above once they get used
+	mutable LruCache<IdsPair, std::pair<std::shared_ptr<Graph>, bool>> m_prefetchedGraphs;
+	mutable LruCache<Id, std::pair<std::vector<Id>, Id>> m_prefetchedActiveTokenIds;
+	mutable LruCache<std::vector<Id>, std::shared_ptr<SourceLocationCollection>>
+		m_prefetchedSourceLocations;
 };
 
 #endif	  // STORAGE_CACHE_H
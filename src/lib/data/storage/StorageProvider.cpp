@@ -1,64 +1,95 @@
 #include "StorageProvider.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "logging.h"
 
+StorageProvider::StorageProvider(size_t memoryBudgetBytes)
+	: m_memoryBudget(memoryBudgetBytes), m_byteSize(0), m_maxStorageCount(0), m_maxByteSize(0)
+{
+}
+
 int StorageProvider::getStorageCount() const
 {
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
 	return m_storages.size();
 }
 
+size_t StorageProvider::getByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_byteSize;
+}
+
+size_t StorageProvider::getMemoryBudget() const
+{
+	return m_memoryBudget;
+}
+
+bool StorageProvider::isMemoryBudgetExceeded() const
+{
+	return m_memoryBudget > 0 && getByteSize() >= m_memoryBudget;
+}
+
+int StorageProvider::getMaxStorageCount() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_maxStorageCount;
+}
+
+size_t StorageProvider::getMaxByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_maxByteSize;
+}
+
 void StorageProvider::clear()
 {
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
-	return m_storages.clear();
+	m_storages.clear();
+	m_byteSize = 0;
 }
 
 void StorageProvider::insert(std::shared_ptr<IntermediateStorage> storage)
 {
 	const std::size_t storageSize = storage->getSourceLocationCount();
-	std::list<std::shared_ptr<IntermediateStorage>>::iterator it;
+	const std::size_t byteSize = storage->getByteSize(sizeof(std::string));
+	std::list<QueuedStorage>::iterator it;
 
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
 	for (it = m_storages.begin(); it != m_storages.end(); it++)
 	{
-		if ((*it)->getSourceLocationCount() < storageSize)
+		if (it->storage->getSourceLocationCount() < storageSize)
 		{
 			break;
 		}
 	}
-	m_storages.insert(it, storage);
+	m_storages.insert(it, {storage, byteSize});
+	m_byteSize += byteSize;
+
+	m_maxStorageCount = std::max(m_maxStorageCount, m_storages.size());
+	m_maxByteSize = std::max(m_maxByteSize, m_byteSize);
 }
 
 std::shared_ptr<IntermediateStorage> StorageProvider::consumeSecondLargestStorage()
 {
-	std::shared_ptr<IntermediateStorage> ret;
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	if (m_storages.size() > 1)
 	{
-		std::lock_guard<std::mutex> lock(m_storagesMutex);
-		if (m_storages.size() > 1)
-		{
-			std::list<std::shared_ptr<IntermediateStorage>>::iterator it = m_storages.begin();
-			it++;
-			ret = *it;
-			m_storages.erase(it);
-		}
+		return consumeStorage(std::next(m_storages.begin()));
 	}
-	return ret;
+	return std::shared_ptr<IntermediateStorage>();
 }
 
 std::shared_ptr<IntermediateStorage> StorageProvider::consumeLargestStorage()
 {
-	std::shared_ptr<IntermediateStorage> ret;
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	if (!m_storages.empty())
 	{
-		std::lock_guard<std::mutex> lock(m_storagesMutex);
-		if (!m_storages.empty())
-		{
-			ret = m_storages.front();
-			m_storages.pop_front();
-		}
+		return consumeStorage(m_storages.begin());
 	}
-
-	return ret;
+	return std::shared_ptr<IntermediateStorage>();
 }
 
 void StorageProvider::logCurrentState() const
@@ -66,10 +97,38 @@ void StorageProvider::logCurrentState() const
 	std::string logString = "Storages waiting for injection:";
 	{
 		std::lock_guard<std::mutex> lock(m_storagesMutex);
-		for (const std::shared_ptr<IntermediateStorage>& storage: m_storages)
+		for (const QueuedStorage& queuedStorage: m_storages)
 		{
-			logString += " " + std::to_string(storage->getSourceLocationCount()) + ";";
+			logString += " " +
+				std::to_string(queuedStorage.storage->getSourceLocationCount()) + ";";
 		}
+		logString += " (" + std::to_string(m_byteSize / 1048576) + " MB)";
 	}
 	LOG_INFO(logString);
 }
+
+void StorageProvider::insertIndexingCosts(const std::vector<StorageIndexingCost>& costs)
+{
+	std::lock_guard<std::mutex> lock(m_indexingCostsMutex);
+	m_indexingCosts.insert(m_indexingCosts.end(), costs.begin(), costs.end());
+}
+
+std::vector<StorageIndexingCost> StorageProvider::consumeIndexingCosts()
+{
+	std::vector<StorageIndexingCost> costs;
+	{
+		std::lock_guard<std::mutex> lock(m_indexingCostsMutex);
+		std::swap(costs, m_indexingCosts);
+	}
+	return costs;
+}
+
+std::shared_ptr<IntermediateStorage> StorageProvider::consumeStorage(
+	std::list<QueuedStorage>::iterator it)
+{
+	// expects m_storagesMutex to be locked by the caller
+	std::shared_ptr<IntermediateStorage> ret = it->storage;
+	m_byteSize -= it->byteSize;
+	m_storages.erase(it);
+	return ret;
+}
@@ -2,15 +2,30 @@
 #define STORAGE_PROVIDER_H
 
 #include "IntermediateStorage.h"
+#include "StorageIndexingCost.h"
 #include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 class StorageProvider
 {
 public:
+	// a memory budget of 0 bytes means that the queued storages are not limited in size
+	StorageProvider(size_t memoryBudgetBytes = 0);
+
 	int getStorageCount() const;
 
+	// estimated memory used by all queued storages
+	size_t getByteSize() const;
+	size_t getMemoryBudget() const;
+
+	bool isMemoryBudgetExceeded() const;
+
+	// highest number and estimated memory of storages that were queued at the same time
+	int getMaxStorageCount() const;
+	size_t getMaxByteSize() const;
+
 	void clear();
 
 	void insert(std::shared_ptr<IntermediateStorage> storage);
@@ -23,9 +38,28 @@ public:
 
 	void logCurrentState() const;
 
+	void insertIndexingCosts(const std::vector<StorageIndexingCost>& costs);
+	std::vector<StorageIndexingCost> consumeIndexingCosts();
+
 private:
-	std::list<std::shared_ptr<IntermediateStorage>> m_storages;	   // larger storages are in front
+	struct QueuedStorage
+	{
+		std::shared_ptr<IntermediateStorage> storage;
+		size_t byteSize;
+	};
+
+	std::shared_ptr<IntermediateStorage> consumeStorage(std::list<QueuedStorage>::iterator it);
+
+	const size_t m_memoryBudget;
+
+	std::list<QueuedStorage> m_storages;	// larger storages are in front
+	size_t m_byteSize;
+	size_t m_maxStorageCount;
+	size_t m_maxByteSize;
 	mutable std::mutex m_storagesMutex;
+
+	std::vector<StorageIndexingCost> m_indexingCosts;
+	std::mutex m_indexingCostsMutex;
 };
 
 #endif	  // STORAGE_PROVIDER_H
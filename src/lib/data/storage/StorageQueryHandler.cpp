@@ -0,0 +1,264 @@
+#include "StorageQueryHandler.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "Graph.h"
+#include "NodeTypeSet.h"
+#include "SourceLocation.h"
+#include "SourceLocationCollection.h"
+#include "StorageAccess.h"
+
+namespace
+{
+QJsonArray toJson(const std::vector<Id>& ids)
+{
+	QJsonArray array;
+	for (const Id id: ids)
+	{
+		array.append(double(id));
+	}
+	return array;
+}
+
+std::vector<Id> toIds(const QJsonArray& array)
+{
+	std::vector<Id> ids;
+	for (const QJsonValue& value: array)
+	{
+		if (value.toDouble() > 0)
+		{
+			ids.push_back(Id(value.toDouble()));
+		}
+	}
+	return ids;
+}
+
+QString getLocationTypeName(LocationType type)
+{
+	switch (type)
+	{
+	case LOCATION_TOKEN:
+		return "token";
+	case LOCATION_SCOPE:
+		return "scope";
+	case LOCATION_QUALIFIER:
+		return "qualifier";
+	case LOCATION_LOCAL_SYMBOL:
+		return "local_symbol";
+	case LOCATION_SIGNATURE:
+		return "signature";
+	case LOCATION_COMMENT:
+		return "comment";
+	case LOCATION_ERROR:
+		return "error";
+	case LOCATION_FULLTEXT_SEARCH:
+		return "fulltext_search";
+	case LOCATION_SCREEN_SEARCH:
+		return "screen_search";
+	case LOCATION_UNSOLVED:
+		return "unsolved";
+	}
+	return "unknown";
+}
+
+QJsonObject toJson(std::shared_ptr<SourceLocationCollection> collection)
+{
+	QJsonArray locations;
+	if (collection)
+	{
+		collection->forEachSourceLocation([&locations](SourceLocation* location) {
+			if (!location->isStartLocation())
+			{
+				return;
+			}
+
+			const SourceLocation* end = location->getEndLocation();
+			if (!end)
+			{
+				end = location;
+			}
+
+			QJsonObject object;
+			object["filePath"] = QString::fromStdWString(location->getFilePath().wstr());
+			object["startLine"] = double(location->getLineNumber());
+			object["startColumn"] = double(location->getColumnNumber());
+			object["endLine"] = double(end->getLineNumber());
+			object["endColumn"] = double(end->getColumnNumber());
+			object["type"] = getLocationTypeName(location->getType());
+			object["tokenIds"] = toJson(location->getTokenIds());
+			locations.append(object);
+		});
+	}
+
+	QJsonObject result;
+	result["locations"] = locations;
+	return result;
+}
+
+QJsonObject toJson(std::shared_ptr<Graph> graph)
+{
+	QJsonArray nodes;
+	QJsonArray edges;
+	if (graph)
+	{
+		graph->forEachNode([&nodes](Node* node) {
+			QJsonObject object;
+			object["id"] = double(node->getId());
+			object["name"] = QString::fromStdWString(node->getFullName());
+			object["type"] = QString::fromStdString(node->getType().getUnderscoredTypeString());
+			object["defined"] = node->isDefined();
+			nodes.append(object);
+		});
+
+		graph->forEachEdge([&edges](Edge* edge) {
+			QJsonObject object;
+			object["id"] = double(edge->getId());
+			object["type"] = QString::fromStdWString(
+				Edge::getUnderscoredTypeString(edge->getType()));
+			object["sourceId"] = double(edge->getFrom()->getId());
+			object["targetId"] = double(edge->getTo()->getId());
+			edges.append(object);
+		});
+	}
+
+	QJsonObject result;
+	result["nodes"] = nodes;
+	result["edges"] = edges;
+	return result;
+}
+
+Edge::TypeMask getEdgeTypesForNames(const QJsonArray& names)
+{
+	Edge::TypeMask edgeTypes = 0;
+	for (const QJsonValue& name: names)
+	{
+		for (Edge::TypeMask type = 1; type <= Edge::EDGE_MAX_VALUE; type <<= 1)
+		{
+			if (name.toString().toStdWString() ==
+				Edge::getUnderscoredTypeString(Edge::EdgeType(type)))
+			{
+				edgeTypes |= type;
+			}
+		}
+	}
+	return edgeTypes;
+}
+
+// same edges as the trail buttons of the graph view
+Edge::TypeMask getDefaultTrailEdgeTypes(const NodeType& nodeType)
+{
+	if (nodeType.isInheritable())
+	{
+		return Edge::EDGE_INHERITANCE | Edge::EDGE_TEMPLATE_SPECIALIZATION;
+	}
+	else if (nodeType.isCallable())
+	{
+		return Edge::EDGE_CALL | Edge::EDGE_OVERRIDE;
+	}
+	else if (nodeType.isFile())
+	{
+		return Edge::EDGE_INCLUDE;
+	}
+	return 0;
+}
+}	 // namespace
+
+StorageQueryHandler::StorageQueryHandler(std::shared_ptr<const StorageAccess> storageAccess)
+	: m_storageAccess(storageAccess)
+{
+}
+
+std::string StorageQueryHandler::handleRequest(const std::string& request) const
+{
+	QJsonParseError parseError;
+	const QJsonDocument requestDocument = QJsonDocument::fromJson(
+		QByteArray::fromStdString(request), &parseError);
+
+	const QJsonObject requestObject = requestDocument.object();
+	const QString query = requestObject["query"].toString();
+
+	QJsonObject response;
+	response["id"] = requestObject["id"];
+
+	if (parseError.error != QJsonParseError::NoError || !requestDocument.isObject())
+	{
+		response["error"] = "Request is no valid JSON object: " + parseError.errorString();
+	}
+	else if (query == "autocomplete")
+	{
+		const std::vector<SearchMatch> matches = m_storageAccess->getAutocompletionMatches(
+			requestObject["text"].toString().toStdWString(), NodeTypeSet::all(), false);
+
+		const int limit = requestObject["limit"].toInt(20);
+
+		QJsonArray matchArray;
+		for (const SearchMatch& match: matches)
+		{
+			if (limit > 0 && matchArray.size() >= limit)
+			{
+				break;
+			}
+
+			QJsonObject object;
+			object["name"] = QString::fromStdWString(match.getFullName());
+			object["type"] = QString::fromStdString(match.nodeType.getUnderscoredTypeString());
+			object["tokenIds"] = toJson(match.tokenIds);
+			matchArray.append(object);
+		}
+
+		QJsonObject result;
+		result["matches"] = matchArray;
+		response["result"] = result;
+	}
+	else if (query == "trail")
+	{
+		const Id tokenId = Id(requestObject["tokenId"].toDouble());
+		const bool forward = requestObject["direction"].toString("forward") != "backward";
+		const size_t depth = size_t(std::max(requestObject["depth"].toInt(1), 0));
+
+		Edge::TypeMask edgeTypes = getEdgeTypesForNames(requestObject["edgeTypes"].toArray());
+		if (!edgeTypes && tokenId)
+		{
+			edgeTypes = getDefaultTrailEdgeTypes(
+				m_storageAccess->getNodeTypeForNodeWithId(tokenId));
+		}
+
+		if (!tokenId || !edgeTypes)
+		{
+			response["error"] = "Trail needs a tokenId of a node with trail edges or edgeTypes.";
+		}
+		else
+		{
+			response["result"] = toJson(m_storageAccess->getGraphForTrail(
+				forward ? tokenId : 0, forward ? 0 : tokenId, 0, edgeTypes, false, depth, true));
+		}
+	}
+	else if (query == "locations")
+	{
+		response["result"] = toJson(m_storageAccess->getSourceLocationsForTokenIds(
+			toIds(requestObject["tokenIds"].toArray())));
+	}
+	else if (query == "fulltext")
+	{
+		const std::wstring text = requestObject["text"].toString().toStdWString();
+		if (text.empty())
+		{
+			response["error"] = "Full text search needs a text.";
+		}
+		else
+		{
+			response["result"] = toJson(m_storageAccess->getFullTextSearchLocations(
+				text, requestObject["caseSensitive"].toBool(false)));
+		}
+	}
+	else
+	{
+		response["error"] = "Unknown query \"" + query + "\".";
+	}
+
+	return QJsonDocument(response).toJson(QJsonDocument::Compact).toStdString();
+}
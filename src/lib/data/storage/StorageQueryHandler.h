@@ -0,0 +1,30 @@
+#ifndef STORAGE_QUERY_HANDLER_H
+#define STORAGE_QUERY_HANDLER_H
+
+#include <memory>
+#include <string>
+
+class StorageAccess;
+
+// Answers the requests of the headless query server. Requests and responses are JSON objects
+// written on a single line each:
+//   {"id": 1, "query": "autocomplete", "text": "Foo", "limit": 20}
+//   {"id": 2, "query": "trail", "tokenId": 42, "direction": "backward", "depth": 2}
+//   {"id": 3, "query": "locations", "tokenIds": [42, 43]}
+//   {"id": 4, "query": "fulltext", "text": "TODO", "caseSensitive": false}
+// Trails follow the edge types the graph view uses for the token unless "edgeTypes" lists other
+// ones, a depth of 0 follows the trail to its end. Responses repeat the id of their request and
+// contain either a "result" or an "error". Requests can be handled from several threads at once if
+// the storage has concurrent reads enabled.
+class StorageQueryHandler
+{
+public:
+	StorageQueryHandler(std::shared_ptr<const StorageAccess> storageAccess);
+
+	std::string handleRequest(const std::string& request) const;
+
+private:
+	std::shared_ptr<const StorageAccess> m_storageAccess;
+};
+
+#endif	  // STORAGE_QUERY_HANDLER_H
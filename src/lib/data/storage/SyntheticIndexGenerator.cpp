@@ -0,0 +1,698 @@
+#include "SyntheticIndexGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cwctype>
+#include <fstream>
+#include <random>
+#include <set>
+
+#include "AccessKind.h"
+#include "DefinitionKind.h"
+#include "Edge.h"
+#include "FilePath.h"
+#include "FileSystem.h"
+#include "LocationType.h"
+#include "logging.h"
+#include "NameHierarchy.h"
+#include "NodeType.h"
+#include "SqliteIndexStorage.h"
+#include "utilityString.h"
+
+namespace
+{
+const std::vector<std::wstring> s_nouns = {
+	L"Buffer",	L"Cache",	  L"Channel", L"Clock",		 L"Color",	  L"Column",  L"Config",
+	L"Context", L"Controller", L"Edge",	   L"Entry",	 L"Event",	  L"File",	  L"Font",
+	L"Graph",	L"Handler",	   L"Image",   L"Index",	 L"Item",	  L"Layout",  L"Location",
+	L"Lock",	L"Logger",	   L"Matrix",  L"Message",	 L"Model",	  L"Module",  L"Name",
+	L"Node",	L"Package",	   L"Parser",  L"Path",		 L"Point",	  L"Position", L"Query",
+	L"Queue",	L"Range",	   L"Reader",  L"Record",	 L"Rect",	  L"Request", L"Response",
+	L"Result",	L"Row",		   L"Scope",   L"Setting",	 L"Shape",	  L"Socket",  L"Source",
+	L"State",	L"Stream",	   L"Symbol",  L"Table",	 L"Target",	  L"Task",	  L"Thread",
+	L"Timer",	L"Token",	   L"Type",	   L"Value",	 L"Vector",	  L"View",	  L"Widget",
+	L"Writer"};
+
+const std::vector<std::wstring> s_verbs = {
+	L"add",	   L"apply", L"build", L"check", L"clear",	 L"close",	 L"compute", L"create",
+	L"erase",  L"find",	 L"get",   L"handle", L"init",	 L"insert",	 L"load",	 L"merge",
+	L"open",   L"parse", L"process", L"read", L"remove", L"reset",	 L"resolve", L"save",
+	L"set",	   L"sort",	 L"split", L"start", L"stop",	 L"update",	 L"visit",	 L"write"};
+
+// files are written and injected in batches, which bounds the memory needed for huge indices
+const size_t s_filesPerBatch = 256;
+
+const double s_headerProbability = 0.5;
+const double s_topLevelNamespaceProbability = 0.25;
+const double s_methodProbability = 0.6;
+const double s_inheritanceProbability = 0.2;
+const double s_returnTypeUsageProbability = 0.3;
+
+const uint32_t s_none = UINT32_MAX;
+
+// The distributions of the standard library are implementation defined, these only rely on the
+// number sequence of the mersenne twister, so the same seed gives the same index everywhere.
+class Random
+{
+public:
+	Random(unsigned int seed): m_generator(seed) {}
+
+	double uniform()
+	{
+		return m_generator() / 4294967296.0;
+	}
+
+	uint32_t index(size_t count)
+	{
+		return static_cast<uint32_t>(uniform() * count);
+	}
+
+	bool chance(double probability)
+	{
+		return uniform() < probability;
+	}
+
+	// geometrically distributed, most values are small but some are several times the mean
+	uint32_t count(double mean)
+	{
+		if (mean <= 0.0)
+		{
+			return 0;
+		}
+		return static_cast<uint32_t>(std::log(1.0 - uniform()) / std::log(mean / (mean + 1.0)));
+	}
+
+private:
+	std::mt19937 m_generator;
+};
+
+// picks items with Zipf distributed frequency, so few items receive most of the references
+class ZipfSampler
+{
+public:
+	ZipfSampler(std::vector<uint32_t> items, double exponent, Random* random)
+	{
+		// popularity should not correlate with the position in the project
+		for (size_t i = items.size(); i > 1; i--)
+		{
+			std::swap(items[i - 1], items[random->index(i)]);
+		}
+		m_items = std::move(items);
+
+		double sum = 0.0;
+		m_cumulativeWeights.reserve(m_items.size());
+		for (size_t rank = 0; rank < m_items.size(); rank++)
+		{
+			sum += 1.0 / std::pow(double(rank + 1), exponent);
+			m_cumulativeWeights.push_back(sum);
+		}
+	}
+
+	bool empty() const
+	{
+		return m_items.empty();
+	}
+
+	uint32_t sample(Random* random) const
+	{
+		const double value = random->uniform() * m_cumulativeWeights.back();
+		const size_t rank =
+			std::upper_bound(m_cumulativeWeights.begin(), m_cumulativeWeights.end(), value) -
+			m_cumulativeWeights.begin();
+		return m_items[std::min(rank, m_items.size() - 1)];
+	}
+
+private:
+	std::vector<uint32_t> m_items;
+	std::vector<double> m_cumulativeWeights;
+};
+
+struct Namespace
+{
+	uint32_t parent;
+	size_t depth;
+	std::wstring name;
+	std::wstring path;
+};
+
+struct File
+{
+	uint32_t namespaceIndex;
+	uint32_t firstSymbol;
+	uint32_t symbolEnd;
+	uint32_t includeCount;
+	bool header;
+};
+
+// kept small, because huge indices have millions of them
+struct Symbol
+{
+	NodeType::Type type;
+	uint32_t parent;	// record of members, namespace otherwise
+	uint16_t firstWord;
+	uint16_t secondWord;
+	uint32_t suffix;	// makes the name unique, 0 for none
+	uint32_t callCount;
+	bool hasTypeUsage;	  // base of records, return type of callables, type of fields
+};
+
+struct Layout
+{
+	std::vector<Namespace> namespaces;
+	std::vector<File> files;
+	std::vector<Symbol> symbols;
+};
+
+std::wstring getSymbolName(const Symbol& symbol)
+{
+	const std::wstring suffix = symbol.suffix ? std::to_wstring(symbol.suffix) : L"";
+	switch (symbol.type)
+	{
+	case NodeType::NODE_CLASS:
+		return s_nouns[symbol.firstWord] + s_nouns[symbol.secondWord] + suffix;
+	case NodeType::NODE_FIELD:
+	{
+		std::wstring name = s_nouns[symbol.firstWord];
+		name[0] = std::towlower(name[0]);
+		return L"m_" + name + s_nouns[symbol.secondWord] + suffix;
+	}
+	default:
+		return s_verbs[symbol.firstWord] + s_nouns[symbol.secondWord] + suffix;
+	}
+}
+
+std::wstring getFileName(const Layout& layout, uint32_t fileIndex)
+{
+	const File& file = layout.files[fileIndex];
+	return layout.namespaces[file.namespaceIndex].path + L"/file_" + std::to_wstring(fileIndex) +
+		(file.header ? L".h" : L".cpp");
+}
+
+Layout createLayout(const SyntheticIndexGenerator::Parameters& parameters, Random* random)
+{
+	Layout layout;
+
+	const size_t namespaceCount = std::max<size_t>(
+		1, static_cast<size_t>(parameters.fileCount / std::max(1.0, parameters.filesPerNamespace)));
+	for (uint32_t i = 0; i < namespaceCount; i++)
+	{
+		uint32_t parent = s_none;
+		if (i > 0 && !random->chance(s_topLevelNamespaceProbability))
+		{
+			const size_t maxDepth = std::max<size_t>(1, parameters.maxNamespaceDepth);
+			parent = random->index(i);
+			while (parent != s_none && layout.namespaces[parent].depth >= maxDepth)
+			{
+				parent = layout.namespaces[parent].parent;
+			}
+		}
+
+		std::wstring name = s_nouns[random->index(s_nouns.size())] + std::to_wstring(i);
+		name[0] = std::towlower(name[0]);
+
+		const bool topLevel = parent == s_none;
+		layout.namespaces.push_back(
+			{parent,
+			 topLevel ? 1 : layout.namespaces[parent].depth + 1,
+			 name,
+			 (topLevel ? L"" : layout.namespaces[parent].path + L"/") + name});
+	}
+
+	for (uint32_t i = 0; i < parameters.fileCount; i++)
+	{
+		File file;
+		file.namespaceIndex = random->index(layout.namespaces.size());
+		file.firstSymbol = static_cast<uint32_t>(layout.symbols.size());
+		file.includeCount = random->count(parameters.includesPerFile);
+		file.header = random->chance(s_headerProbability);
+
+		const uint32_t recordCount = random->count(parameters.recordsPerFile);
+		for (uint32_t j = 0; j < recordCount; j++)
+		{
+			const uint32_t recordIndex = static_cast<uint32_t>(layout.symbols.size());
+			layout.symbols.push_back(
+				{NodeType::NODE_CLASS,
+				 file.namespaceIndex,
+				 static_cast<uint16_t>(random->index(s_nouns.size())),
+				 static_cast<uint16_t>(random->index(s_nouns.size())),
+				 recordIndex + 1,
+				 0,
+				 random->chance(s_inheritanceProbability)});
+
+			// members only need to be unique within their record
+			std::set<std::pair<uint16_t, uint16_t>> memberNames;
+			const uint32_t memberCount = random->count(parameters.membersPerRecord);
+			for (uint32_t k = 0; k < memberCount; k++)
+			{
+				const bool method = random->chance(s_methodProbability);
+				Symbol member {
+					method ? NodeType::NODE_METHOD : NodeType::NODE_FIELD,
+					recordIndex,
+					static_cast<uint16_t>(random->index(method ? s_verbs.size() : s_nouns.size())),
+					static_cast<uint16_t>(random->index(s_nouns.size())),
+					0,
+					method ? random->count(parameters.callsPerFunction) : 0,
+					method ? random->chance(s_returnTypeUsageProbability) : true};
+
+				const uint32_t firstWord = member.firstWord + (method ? 0 : 0x8000);
+				if (!memberNames.emplace(firstWord, member.secondWord).second)
+				{
+					member.suffix = k + 1;
+				}
+				layout.symbols.push_back(member);
+			}
+		}
+
+		const uint32_t functionCount = random->count(parameters.functionsPerFile);
+		for (uint32_t j = 0; j < functionCount; j++)
+		{
+			layout.symbols.push_back(
+				{NodeType::NODE_FUNCTION,
+				 file.namespaceIndex,
+				 static_cast<uint16_t>(random->index(s_verbs.size())),
+				 static_cast<uint16_t>(random->index(s_nouns.size())),
+				 static_cast<uint32_t>(layout.symbols.size()) + 1,
+				 random->count(parameters.callsPerFunction),
+				 random->chance(s_returnTypeUsageProbability)});
+		}
+
+		file.symbolEnd = static_cast<uint32_t>(layout.symbols.size());
+		layout.files.push_back(file);
+	}
+
+	return layout;
+}
+
+// Builds the text of one source file line by line and records where the tokens are.
+class SourceFileWriter
+{
+public:
+	SourceFileWriter(Id fileId): m_fileId(fileId) {}
+
+	// returns the number of the added line
+	size_t addLine(const std::string& line)
+	{
+		m_text += line + '\n';
+		return ++m_lineCount;
+	}
+
+	StorageSourceLocationData getTokenLocation(size_t line, size_t column, size_t length) const
+	{
+		return StorageSourceLocationData(
+			m_fileId, line, column, line, column + length - 1, locationTypeToInt(LOCATION_TOKEN));
+	}
+
+	StorageSourceLocationData getScopeLocation(size_t startLine) const
+	{
+		return StorageSourceLocationData(
+			m_fileId, startLine, 1, m_lineCount, 1, locationTypeToInt(LOCATION_SCOPE));
+	}
+
+	const std::string& getText() const
+	{
+		return m_text;
+	}
+
+private:
+	const Id m_fileId;
+	std::string m_text;
+	size_t m_lineCount = 0;
+};
+
+// edge ids are only known after the edges are added, so locations can refer to an edge by index
+struct PendingLocation
+{
+	StorageSourceLocationData location;
+	Id elementId;
+	size_t edgeIndex;
+};
+}	 // namespace
+
+SyntheticIndexGenerator::SyntheticIndexGenerator(const Parameters& parameters)
+	: m_parameters(parameters)
+{
+}
+
+SyntheticIndexGenerator::Statistics SyntheticIndexGenerator::generate(
+	SqliteIndexStorage* storage, const FilePath& sourceDirectory) const
+{
+	Random random(m_parameters.seed);
+	const Layout layout = createLayout(m_parameters, &random);
+
+	std::vector<uint32_t> headers;
+	for (uint32_t i = 0; i < layout.files.size(); i++)
+	{
+		if (layout.files[i].header)
+		{
+			headers.push_back(i);
+		}
+	}
+
+	std::vector<uint32_t> records;
+	std::vector<uint32_t> callables;
+	for (uint32_t i = 0; i < layout.symbols.size(); i++)
+	{
+		const NodeType::Type type = layout.symbols[i].type;
+		if (type == NodeType::NODE_CLASS)
+		{
+			records.push_back(i);
+		}
+		else if (type == NodeType::NODE_METHOD || type == NodeType::NODE_FUNCTION)
+		{
+			callables.push_back(i);
+		}
+	}
+
+	const ZipfSampler headerSampler(headers, m_parameters.fanInExponent, &random);
+	const ZipfSampler recordSampler(records, m_parameters.fanInExponent, &random);
+	const ZipfSampler callableSampler(callables, m_parameters.fanInExponent, &random);
+
+	storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+
+	// all nodes get added first, so references can point to symbols of files that come later
+	std::vector<Id> namespaceIds;
+	std::vector<Id> fileIds;
+	std::vector<Id> symbolIds;
+	{
+		storage->beginTransaction();
+
+		std::vector<NameHierarchy> namespaceNames;
+		std::vector<StorageNode> nodes;
+		std::vector<StorageEdge> edges;
+		for (const Namespace& ns: layout.namespaces)
+		{
+			NameHierarchy name = ns.parent == s_none ? NameHierarchy(NAME_DELIMITER_CXX)
+													 : namespaceNames[ns.parent];
+			name.push(ns.name);
+			nodes.emplace_back(
+				0, NodeType::typeToInt(NodeType::NODE_NAMESPACE), NameHierarchy::serialize(name));
+			namespaceNames.push_back(name);
+		}
+		utility::append(namespaceIds, storage->addNodes(nodes));
+
+		for (size_t i = 0; i < layout.namespaces.size(); i++)
+		{
+			if (layout.namespaces[i].parent != s_none)
+			{
+				edges.emplace_back(
+					0,
+					Edge::typeToInt(Edge::EDGE_MEMBER),
+					namespaceIds[layout.namespaces[i].parent],
+					namespaceIds[i]);
+			}
+		}
+		storage->addEdges(edges);
+
+		storage->commitTransaction();
+
+		for (size_t batchStart = 0; batchStart < layout.files.size(); batchStart += s_filesPerBatch)
+		{
+			const size_t batchEnd = std::min(batchStart + s_filesPerBatch, layout.files.size());
+
+			std::vector<StorageNode> fileNodes;
+			std::vector<StorageNode> symbolNodes;
+			for (size_t i = batchStart; i < batchEnd; i++)
+			{
+				const File& file = layout.files[i];
+				fileNodes.emplace_back(
+					0,
+					NodeType::typeToInt(NodeType::NODE_FILE),
+					NameHierarchy::serialize(NameHierarchy(
+						sourceDirectory.getConcatenated(getFileName(layout, i)).wstr(),
+						NAME_DELIMITER_FILE)));
+
+				NameHierarchy recordName;
+				for (uint32_t j = file.firstSymbol; j < file.symbolEnd; j++)
+				{
+					const Symbol& symbol = layout.symbols[j];
+					NameHierarchy name = symbol.type == NodeType::NODE_METHOD ||
+							symbol.type == NodeType::NODE_FIELD
+						? recordName
+						: namespaceNames[symbol.parent];
+
+					if (symbol.type == NodeType::NODE_METHOD ||
+						symbol.type == NodeType::NODE_FUNCTION)
+					{
+						name.push(NameElement(getSymbolName(symbol), L"void", L"()"));
+					}
+					else
+					{
+						name.push(getSymbolName(symbol));
+					}
+
+					if (symbol.type == NodeType::NODE_CLASS)
+					{
+						recordName = name;
+					}
+
+					symbolNodes.emplace_back(
+						0, NodeType::typeToInt(symbol.type), NameHierarchy::serialize(name));
+				}
+			}
+
+			storage->beginTransaction();
+			utility::append(fileIds, storage->addNodes(fileNodes));
+			utility::append(symbolIds, storage->addNodes(symbolNodes));
+			storage->commitTransaction();
+		}
+	}
+
+	for (size_t batchStart = 0; batchStart < layout.files.size(); batchStart += s_filesPerBatch)
+	{
+		const size_t batchEnd = std::min(batchStart + s_filesPerBatch, layout.files.size());
+
+		std::vector<StorageFile> files;
+		std::vector<StorageSymbol> symbols;
+		std::vector<StorageEdge> edges;
+		std::vector<PendingLocation> locations;
+		std::vector<StorageComponentAccess> accesses;
+
+		auto addEdge = [&](Edge::EdgeType type, Id sourceId, Id targetId) {
+			edges.emplace_back(0, Edge::typeToInt(type), sourceId, targetId);
+			return edges.size() - 1;
+		};
+
+		auto addReference = [&](Edge::EdgeType type,
+								Id sourceId,
+								Id targetId,
+								const StorageSourceLocationData& location) {
+			locations.push_back({location, 0, addEdge(type, sourceId, targetId)});
+		};
+
+		auto addDefinition = [&](Id symbolId, const StorageSourceLocationData& location) {
+			symbols.emplace_back(symbolId, definitionKindToInt(DEFINITION_EXPLICIT));
+			locations.push_back({location, symbolId, 0});
+		};
+
+		for (size_t i = batchStart; i < batchEnd; i++)
+		{
+			const File& file = layout.files[i];
+			const Id fileId = fileIds[i];
+			SourceFileWriter writer(fileId);
+
+			std::set<uint32_t> includedFiles;
+			for (uint32_t j = 0; j < file.includeCount && !headerSampler.empty(); j++)
+			{
+				const uint32_t includedFile = headerSampler.sample(&random);
+				if (includedFile != i && includedFiles.insert(includedFile).second)
+				{
+					const std::string includedFileName =
+						utility::encodeToUtf8(getFileName(layout, includedFile));
+					const size_t line = writer.addLine("#include \"" + includedFileName + "\"");
+					addReference(
+						Edge::EDGE_INCLUDE,
+						fileId,
+						fileIds[includedFile],
+						writer.getTokenLocation(line, 10, includedFileName.size() + 2));
+				}
+			}
+
+			const Namespace& ns = layout.namespaces[file.namespaceIndex];
+			const std::string namespaceName = utility::encodeToUtf8(ns.name);
+			const std::string namespaceLine = "namespace " +
+				utility::replace(utility::encodeToUtf8(ns.path), "/", "::") + " {";
+			writer.addLine("");
+			locations.push_back(
+				{writer.getTokenLocation(
+					 writer.addLine(namespaceLine),
+					 namespaceLine.size() - namespaceName.size() - 1,
+					 namespaceName.size()),
+				 namespaceIds[file.namespaceIndex],
+				 0});
+
+			size_t recordStartLine = 0;
+			Id recordId = 0;
+			for (uint32_t j = file.firstSymbol; j < file.symbolEnd; j++)
+			{
+				const Symbol& symbol = layout.symbols[j];
+				const Id symbolId = symbolIds[j];
+				const std::string name = utility::encodeToUtf8(getSymbolName(symbol));
+				const bool member = symbol.type == NodeType::NODE_METHOD ||
+					symbol.type == NodeType::NODE_FIELD;
+				const std::string indent = member ? "\t" : "";
+
+				if (recordId && !member)
+				{
+					writer.addLine("};");
+					locations.push_back({writer.getScopeLocation(recordStartLine), recordId, 0});
+					recordId = 0;
+				}
+
+				addEdge(
+					Edge::EDGE_MEMBER,
+					member ? symbolIds[symbol.parent] : namespaceIds[symbol.parent],
+					symbolId);
+
+				if (symbol.type == NodeType::NODE_CLASS)
+				{
+					recordId = symbolId;
+
+					const uint32_t baseRecord = symbol.hasTypeUsage && !recordSampler.empty()
+						? recordSampler.sample(&random)
+						: j;
+					if (baseRecord != j)
+					{
+						const std::string baseName =
+							utility::encodeToUtf8(getSymbolName(layout.symbols[baseRecord]));
+						const std::string line = "class " + name + ": public " + baseName;
+						recordStartLine = writer.addLine(line);
+						addReference(
+							Edge::EDGE_INHERITANCE,
+							symbolId,
+							symbolIds[baseRecord],
+							writer.getTokenLocation(
+								recordStartLine,
+								line.size() - baseName.size() + 1,
+								baseName.size()));
+					}
+					else
+					{
+						recordStartLine = writer.addLine("class " + name);
+					}
+					addDefinition(
+						symbolId, writer.getTokenLocation(recordStartLine, 7, name.size()));
+					writer.addLine("{");
+				}
+				else if (symbol.type == NodeType::NODE_FIELD)
+				{
+					accesses.emplace_back(symbolId, accessKindToInt(ACCESS_PRIVATE));
+
+					const uint32_t typeRecord = recordSampler.sample(&random);
+					const std::string typeName =
+						utility::encodeToUtf8(getSymbolName(layout.symbols[typeRecord]));
+					const size_t line = writer.addLine("\t" + typeName + " " + name + ";");
+					addDefinition(
+						symbolId, writer.getTokenLocation(line, typeName.size() + 3, name.size()));
+					addReference(
+						Edge::EDGE_TYPE_USAGE,
+						symbolId,
+						symbolIds[typeRecord],
+						writer.getTokenLocation(line, 2, typeName.size()));
+				}
+				else
+				{
+					if (member)
+					{
+						accesses.emplace_back(symbolId, accessKindToInt(ACCESS_PUBLIC));
+					}
+
+					const size_t startLine = writer.addLine(indent + "void " + name + "()");
+					addDefinition(
+						symbolId,
+						writer.getTokenLocation(startLine, indent.size() + 6, name.size()));
+					writer.addLine(indent + "{");
+
+					if (symbol.hasTypeUsage && !recordSampler.empty())
+					{
+						const uint32_t typeRecord = recordSampler.sample(&random);
+						const std::string typeName =
+							utility::encodeToUtf8(getSymbolName(layout.symbols[typeRecord]));
+						const size_t line = writer.addLine(indent + "\t" + typeName + " value;");
+						addReference(
+							Edge::EDGE_TYPE_USAGE,
+							symbolId,
+							symbolIds[typeRecord],
+							writer.getTokenLocation(line, indent.size() + 2, typeName.size()));
+					}
+
+					for (uint32_t k = 0; k < symbol.callCount; k++)
+					{
+						const uint32_t callee = callableSampler.sample(&random);
+						const std::string calleeName =
+							utility::encodeToUtf8(getSymbolName(layout.symbols[callee]));
+						const size_t line = writer.addLine(indent + "\t" + calleeName + "();");
+						addReference(
+							Edge::EDGE_CALL,
+							symbolId,
+							symbolIds[callee],
+							writer.getTokenLocation(line, indent.size() + 2, calleeName.size()));
+					}
+
+					writer.addLine(indent + "}");
+					locations.push_back({writer.getScopeLocation(startLine), symbolId, 0});
+				}
+			}
+
+			if (recordId)
+			{
+				writer.addLine("};");
+				locations.push_back({writer.getScopeLocation(recordStartLine), recordId, 0});
+			}
+			writer.addLine("}");
+
+			const FilePath filePath = sourceDirectory.getConcatenated(getFileName(layout, i));
+			FileSystem::createDirectory(filePath.getParentDirectory());
+			std::ofstream(filePath.str()) << writer.getText();
+
+			files.emplace_back(fileId, filePath.wstr(), L"cpp", "", true, true);
+		}
+
+		storage->beginTransaction();
+
+		for (const StorageFile& file: files)
+		{
+			storage->addFile(file);
+		}
+		storage->addSymbols(symbols);
+
+		const std::vector<Id> edgeIds = storage->addEdges(edges);
+
+		std::vector<StorageSourceLocation> sourceLocations;
+		sourceLocations.reserve(locations.size());
+		for (const PendingLocation& location: locations)
+		{
+			sourceLocations.emplace_back(0, location.location);
+		}
+
+		const std::vector<Id> sourceLocationIds = storage->addSourceLocations(sourceLocations);
+
+		std::vector<StorageOccurrence> occurrences;
+		occurrences.reserve(locations.size());
+		for (size_t i = 0; i < locations.size(); i++)
+		{
+			occurrences.emplace_back(
+				locations[i].elementId ? locations[i].elementId : edgeIds[locations[i].edgeIndex],
+				sourceLocationIds[i]);
+		}
+		storage->addOccurrences(occurrences);
+		storage->addComponentAccesses(accesses);
+
+		storage->commitTransaction();
+
+		LOG_INFO(
+			"Generated " + std::to_string(batchEnd) + " of " +
+			std::to_string(layout.files.size()) + " files");
+	}
+
+	storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+	storage->setVersion(storage->getStaticVersion());
+	storage->setTime();
+
+	Statistics statistics;
+	statistics.fileCount = storage->getFileCount();
+	statistics.nodeCount = storage->getNodeCount();
+	statistics.edgeCount = storage->getEdgeCount();
+	statistics.sourceLocationCount = storage->getSourceLocationCount();
+	return statistics;
+}
@@ -0,0 +1,52 @@
+#ifndef SYNTHETIC_INDEX_GENERATOR_H
+#define SYNTHETIC_INDEX_GENERATOR_H
+
+#include <cstddef>
+
+class FilePath;
+class SqliteIndexStorage;
+
+// Writes a C++ like index of configurable size directly into a storage, without running an
+// indexer. Namespaces nest up to a maximum depth, the number of records, members, functions, calls
+// and includes per file follow long tailed distributions and references pick their targets with
+// Zipf distributed popularity, which gives the fan-in and fan-out of real code bases. Matching
+// source files are written as well, because their content is part of the index. The same
+// parameters always produce the same index.
+class SyntheticIndexGenerator
+{
+public:
+	struct Parameters
+	{
+		size_t fileCount = 1000;
+		size_t maxNamespaceDepth = 4;
+		double filesPerNamespace = 8.0;
+		double recordsPerFile = 3.0;
+		double membersPerRecord = 8.0;
+		double functionsPerFile = 2.0;
+		double includesPerFile = 6.0;
+		double callsPerFunction = 4.0;
+
+		// larger values concentrate more references on fewer popular symbols and headers
+		double fanInExponent = 1.0;
+
+		unsigned int seed = 1;
+	};
+
+	struct Statistics
+	{
+		size_t fileCount = 0;
+		size_t nodeCount = 0;
+		size_t edgeCount = 0;
+		size_t sourceLocationCount = 0;
+	};
+
+	SyntheticIndexGenerator(const Parameters& parameters);
+
+	// the storage needs to be set up and empty, the source files are written to sourceDirectory
+	Statistics generate(SqliteIndexStorage* storage, const FilePath& sourceDirectory) const;
+
+private:
+	const Parameters m_parameters;
+};
+
+#endif	  // SYNTHETIC_INDEX_GENERATOR_H
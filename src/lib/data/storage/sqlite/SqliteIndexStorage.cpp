@@ -32,8 +32,8 @@ size_t SqliteIndexStorage::getStorageVersion()
 	return s_storageVersion;
 }
 
-SqliteIndexStorage::SqliteIndexStorage(const FilePath& dbFilePath)
-	: SqliteStorage(dbFilePath.getCanonical())
+SqliteIndexStorage::SqliteIndexStorage(const FilePath& dbFilePath, bool readOnly)
+	: SqliteStorage(dbFilePath.getCanonical(), readOnly)
 {
 }
 
@@ -75,6 +75,26 @@ void SqliteIndexStorage::setProjectSettingsText(std::string text)
 	insertOrUpdateMetaValue("project_settings", text);
 }
 
+std::string SqliteIndexStorage::getIndexingReport() const
+{
+	return getMetaValue("indexing_report");
+}
+
+void SqliteIndexStorage::setIndexingReport(const std::string& report)
+{
+	insertOrUpdateMetaValue("indexing_report", report);
+}
+
+std::string SqliteIndexStorage::getIndexingCheckpoint() const
+{
+	return getMetaValue("indexing_checkpoint");
+}
+
+void SqliteIndexStorage::setIndexingCheckpoint(const std::string& checkpoint)
+{
+	insertOrUpdateMetaValue("indexing_checkpoint", checkpoint);
+}
+
 Id SqliteIndexStorage::addNode(const StorageNodeData& data)
 {
 	std::vector<Id> ids = addNodes({StorageNode(0, data)});
@@ -452,6 +472,22 @@ StorageError SqliteIndexStorage::addError(const StorageErrorData& data)
 	return StorageError(id, data);
 }
 
+bool SqliteIndexStorage::addIndexingCosts(const std::vector<StorageIndexingCost>& costs)
+{
+	for (const StorageIndexingCost& cost: costs)
+	{
+		m_insertIndexingCostStmt.bind(1, utility::encodeToUtf8(cost.filePath).c_str());
+		m_insertIndexingCostStmt.bind(2, double(cost.wallTimeMs));
+		m_insertIndexingCostStmt.bind(3, double(cost.peakMemoryBytes));
+		m_insertIndexingCostStmt.bind(4, double(cost.storageByteSize));
+		if (!executeStatement(m_insertIndexingCostStmt))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void SqliteIndexStorage::removeElement(Id id)
 {
 	std::vector<Id> ids;
@@ -763,7 +799,7 @@ StorageNode SqliteIndexStorage::getNodeById(Id id) const
 
 StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& serializedName) const
 {
-	CppSQLite3Statement stmt = m_database.compileStatement(
+	CppSQLite3Statement stmt = getReadDatabase().compileStatement(
 		"SELECT id, type, serialized_name FROM node WHERE serialized_name == ? LIMIT 1;");
 
 	stmt.bind(1, utility::encodeToUtf8(serializedName).c_str());
@@ -1113,6 +1149,17 @@ std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
 	return errorInfos;
 }
 
+std::vector<StorageIndexingCost> SqliteIndexStorage::getIndexingCosts() const
+{
+	if (!hasTable("indexing_cost"))
+	{
+		// databases that were opened in an incompatible state have not been set up
+		return std::vector<StorageIndexingCost>();
+	}
+
+	return doGetAll<StorageIndexingCost>("ORDER BY path");
+}
+
 int SqliteIndexStorage::getNodeCount() const
 {
 	return executeStatementScalar("SELECT COUNT(*) FROM node;", 0);
@@ -1203,6 +1250,7 @@ void SqliteIndexStorage::clearTables()
 {
 	try
 	{
+		m_database.execDML("DROP TABLE IF EXISTS main.indexing_cost;");
 		m_database.execDML("DROP TABLE IF EXISTS main.error;");
 		m_database.execDML("DROP TABLE IF EXISTS main.component_access;");
 		m_database.execDML("DROP TABLE IF EXISTS main.occurrence;");
@@ -1332,6 +1380,14 @@ void SqliteIndexStorage::setupTables()
 			"translation_unit TEXT, "
 			"PRIMARY KEY(id), "
 			"FOREIGN KEY(id) REFERENCES element(id) ON DELETE CASCADE);");
+
+		m_database.execDML(
+			"CREATE TABLE IF NOT EXISTS indexing_cost("
+			"path TEXT NOT NULL, "
+			"wall_time_ms INTEGER, "
+			"peak_memory INTEGER, "
+			"storage_size INTEGER, "
+			"PRIMARY KEY(path));");
 	}
 	catch (CppSQLite3Exception& e)
 	{
@@ -1426,6 +1482,9 @@ void SqliteIndexStorage::setupPrecompiledStatements()
 		m_insertErrorStmt = m_database.compileStatement(
 			"INSERT INTO error(id, message, fatal, indexed, translation_unit) "
 			"VALUES(?, ?, ?, ?, ?);");
+		m_insertIndexingCostStmt = m_database.compileStatement(
+			"INSERT OR REPLACE INTO indexing_cost(path, wall_time_ms, peak_memory, storage_size) "
+			"VALUES(?, ?, ?, ?);");
 	}
 	catch (CppSQLite3Exception& e)
 	{
@@ -1672,3 +1731,30 @@ void SqliteIndexStorage::forEach<StorageError>(
 		q.nextRow();
 	}
 }
+
+template <>
+void SqliteIndexStorage::forEach<StorageIndexingCost>(
+	const std::string& query, std::function<void(StorageIndexingCost&&)> func) const
+{
+	CppSQLite3Query q = executeQuery(
+		"SELECT path, wall_time_ms, peak_memory, storage_size FROM indexing_cost " + query + ";");
+
+	while (!q.eof())
+	{
+		const std::string filePath = q.getStringField(0, "");
+		const sqlite_int64 wallTimeMs = q.getInt64Field(1, 0);
+		const sqlite_int64 peakMemoryBytes = q.getInt64Field(2, 0);
+		const sqlite_int64 storageByteSize = q.getInt64Field(3, 0);
+
+		if (!filePath.empty())
+		{
+			func(StorageIndexingCost(
+				utility::decodeFromUtf8(filePath),
+				size_t(wallTimeMs),
+				size_t(peakMemoryBytes),
+				size_t(storageByteSize)));
+		}
+
+		q.nextRow();
+	}
+}
@@ -15,6 +15,7 @@
 #include "StorageElementComponent.h"
 #include "StorageError.h"
 #include "StorageFile.h"
+#include "StorageIndexingCost.h"
 #include "StorageLocalSymbol.h"
 #include "StorageNode.h"
 #include "StorageOccurrence.h"
@@ -41,7 +42,7 @@ public:
 		STORAGE_MODE_CLEAR = 4
 	};
 
-	SqliteIndexStorage(const FilePath& dbFilePath);
+	SqliteIndexStorage(const FilePath& dbFilePath, bool readOnly = false);
 
 	virtual size_t getStaticVersion() const;
 
@@ -50,6 +51,12 @@ public:
 	std::string getProjectSettingsText() const;
 	void setProjectSettingsText(std::string text);
 
+	std::string getIndexingReport() const;
+	void setIndexingReport(const std::string& report);
+
+	std::string getIndexingCheckpoint() const;
+	void setIndexingCheckpoint(const std::string& checkpoint);
+
 	Id addNode(const StorageNodeData& data);
 	std::vector<Id> addNodes(const std::vector<StorageNode>& nodes);
 	bool addSymbol(const StorageSymbol& data);
@@ -68,6 +75,7 @@ public:
 	void addElementComponent(const StorageElementComponent& component);
 	void addElementComponents(const std::vector<StorageElementComponent>& components);
 	StorageError addError(const StorageErrorData& data);
+	bool addIndexingCosts(const std::vector<StorageIndexingCost>& costs);
 
 	void removeElement(Id id);
 	void removeElements(const std::vector<Id>& ids);
@@ -137,6 +145,8 @@ public:
 
 	std::vector<ErrorInfo> getAllErrorInfos() const;
 
+	std::vector<StorageIndexingCost> getIndexingCosts() const;
+
 	template <typename ResultType>
 	std::vector<ResultType> getAll() const
 	{
@@ -366,6 +376,7 @@ private:
 	CppSQLite3Statement m_insertFileContentStmt;
 	CppSQLite3Statement m_checkErrorExistsStmt;
 	CppSQLite3Statement m_insertErrorStmt;
+	CppSQLite3Statement m_insertIndexingCostStmt;
 };
 
 template <>
@@ -398,5 +409,8 @@ void SqliteIndexStorage::forEach<StorageElementComponent>(
 template <>
 void SqliteIndexStorage::forEach<StorageError>(
 	const std::string& query, std::function<void(StorageError&&)> func) const;
+template <>
+void SqliteIndexStorage::forEach<StorageIndexingCost>(
+	const std::string& query, std::function<void(StorageIndexingCost&&)> func) const;
 
 #endif	  // SQLITE_INDEX_STORAGE_H
@@ -1,12 +1,23 @@
 #include "SqliteStorage.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "FileSystem.h"
 #include "TimeStamp.h"
 #include "logging.h"
 #include "utilityString.h"
 
-SqliteStorage::SqliteStorage(const FilePath& dbFilePath): m_dbFilePath(dbFilePath.getCanonical())
+SqliteStorage::SqliteStorage(const FilePath& dbFilePath, bool readOnly)
+	: m_dbFilePath(dbFilePath.getCanonical()), m_readDatabases(std::make_shared<ReadDatabases>())
 {
+	if (readOnly)
+	{
+		m_database.open(
+			utility::encodeToUtf8(m_dbFilePath.wstr()).c_str(), SQLITE_OPEN_READONLY);
+		return;
+	}
+
 	if (!m_dbFilePath.getParentDirectory().empty() && !m_dbFilePath.getParentDirectory().exists())
 	{
 		FileSystem::createDirectory(m_dbFilePath.getParentDirectory());
@@ -21,6 +32,7 @@ SqliteStorage::~SqliteStorage()
 {
 	try
 	{
+		setConcurrentReadsEnabled(false);
 		m_database.close();
 	}
 	catch (CppSQLite3Exception e)
@@ -123,6 +135,17 @@ TimeStamp SqliteStorage::getTime() const
 	return TimeStamp(getMetaValue("timestamp"));
 }
 
+void SqliteStorage::setConcurrentReadsEnabled(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(m_readDatabases->mutex);
+	m_readDatabases->enabled = enabled;
+
+	if (!enabled)
+	{
+		m_readDatabases->databases.clear();
+	}
+}
+
 void SqliteStorage::setupMetaTable()
 {
 	try
@@ -190,7 +213,7 @@ int SqliteStorage::executeStatementScalar(const std::string& statement, const in
 	int ret = 0;
 	try
 	{
-		ret = m_database.execScalar(statement.c_str(), nullValue);
+		ret = getReadDatabase().execScalar(statement.c_str(), nullValue);
 	}
 	catch (CppSQLite3Exception e)
 	{
@@ -226,7 +249,7 @@ CppSQLite3Query SqliteStorage::executeQuery(const std::string& statement) const
 {
 	try
 	{
-		return m_database.execQuery(statement.c_str());
+		return getReadDatabase().execQuery(statement.c_str());
 	}
 	catch (CppSQLite3Exception e)
 	{
@@ -261,6 +284,66 @@ bool SqliteStorage::hasTable(const std::string& tableName) const
 	return false;
 }
 
+CppSQLite3DB& SqliteStorage::getReadDatabase() const
+{
+	// closes the connections of the thread in all storages that still exist when the thread exits
+	struct ThreadReadDatabases
+	{
+		~ThreadReadDatabases()
+		{
+			for (const std::weak_ptr<ReadDatabases>& weakReadDatabases: readDatabases)
+			{
+				if (std::shared_ptr<ReadDatabases> readDatabases = weakReadDatabases.lock())
+				{
+					std::lock_guard<std::mutex> lock(readDatabases->mutex);
+					readDatabases->databases.erase(std::this_thread::get_id());
+				}
+			}
+		}
+
+		std::vector<std::weak_ptr<ReadDatabases>> readDatabases;
+	};
+	thread_local ThreadReadDatabases s_threadReadDatabases;
+
+	std::lock_guard<std::mutex> lock(m_readDatabases->mutex);
+	if (!m_readDatabases->enabled)
+	{
+		return m_database;
+	}
+
+	std::unique_ptr<CppSQLite3DB>& database =
+		m_readDatabases->databases[std::this_thread::get_id()];
+	if (!database)
+	{
+		try
+		{
+			database = std::make_unique<CppSQLite3DB>();
+			database->open(
+				utility::encodeToUtf8(m_dbFilePath.wstr()).c_str(), SQLITE_OPEN_READONLY);
+		}
+		catch (CppSQLite3Exception& e)
+		{
+			LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
+			m_readDatabases->databases.erase(std::this_thread::get_id());
+			return m_database;
+		}
+
+		std::vector<std::weak_ptr<ReadDatabases>>& threadReadDatabases =
+			s_threadReadDatabases.readDatabases;
+		threadReadDatabases.erase(
+			std::remove_if(
+				threadReadDatabases.begin(),
+				threadReadDatabases.end(),
+				[](const std::weak_ptr<ReadDatabases>& readDatabases) {
+					return readDatabases.expired();
+				}),
+			threadReadDatabases.end());
+		threadReadDatabases.push_back(m_readDatabases);
+	}
+
+	return *database;
+}
+
 std::string SqliteStorage::getMetaValue(const std::string& key) const
 {
 	if (hasTable("meta"))
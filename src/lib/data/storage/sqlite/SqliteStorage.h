@@ -1,6 +1,11 @@
 #ifndef SQLITE_STORAGE_H
 #define SQLITE_STORAGE_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "CppSQLite3.h"
 
 #include "FilePath.h"
@@ -12,7 +17,9 @@ class TimeStamp;
 class SqliteStorage
 {
 public:
-	SqliteStorage(const FilePath& dbFilePath);
+	// a read-only storage opens an existing database with SQLITE_OPEN_READONLY, it must neither be
+	// set up nor written
+	SqliteStorage(const FilePath& dbFilePath, bool readOnly = false);
 	virtual ~SqliteStorage();
 
 	void setup();
@@ -35,6 +42,13 @@ public:
 	void setTime();
 	TimeStamp getTime() const;
 
+	// Runs the queries of each thread on its own read-only connection, so threads reading the
+	// database at the same time don't share one connection. Only enable this while the database
+	// is not written, the other connections don't see changes of open transactions. Connections
+	// are closed when their thread exits. Disabling closes all of them and must not happen while
+	// queries are running.
+	void setConcurrentReadsEnabled(bool enabled);
+
 protected:
 	void setupMetaTable();
 	void clearMetaTable();
@@ -48,6 +62,9 @@ protected:
 
 	bool hasTable(const std::string& tableName) const;
 
+	// connection for queries of the calling thread
+	CppSQLite3DB& getReadDatabase() const;
+
 	std::string getMetaValue(const std::string& key) const;
 	void insertOrUpdateMetaValue(const std::string& key, const std::string& value);
 
@@ -64,6 +81,16 @@ private:
 
 	bool m_precompiledStatementsInitialized = false;
 
+	// shared with the threads that own a connection, so they can close it when they exit
+	struct ReadDatabases
+	{
+		std::mutex mutex;
+		bool enabled = false;
+		std::map<std::thread::id, std::unique_ptr<CppSQLite3DB>> databases;
+	};
+
+	std::shared_ptr<ReadDatabases> m_readDatabases;
+
 	friend SqliteStorageMigration;
 };
 
@@ -0,0 +1,32 @@
+#ifndef STORAGE_INDEXING_COST_H
+#define STORAGE_INDEXING_COST_H
+
+#include <string>
+
+#include "types.h"
+
+struct StorageIndexingCost
+{
+	StorageIndexingCost(): filePath(L""), wallTimeMs(0), peakMemoryBytes(0), storageByteSize(0) {}
+
+	StorageIndexingCost(
+		std::wstring filePath, size_t wallTimeMs, size_t peakMemoryBytes, size_t storageByteSize)
+		: filePath(std::move(filePath))
+		, wallTimeMs(wallTimeMs)
+		, peakMemoryBytes(peakMemoryBytes)
+		, storageByteSize(storageByteSize)
+	{
+	}
+
+	bool operator<(const StorageIndexingCost& other) const
+	{
+		return filePath < other.filePath;
+	}
+
+	std::wstring filePath;
+	size_t wallTimeMs;
+	size_t peakMemoryBytes;
+	size_t storageByteSize;
+};
+
+#endif	  // STORAGE_INDEXING_COST_H
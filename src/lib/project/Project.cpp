@@ -5,6 +5,7 @@
 #include "DialogView.h"
 #include "IndexerCommand.h"
 #include "IndexerCommandCustom.h"
+#include "IndexingReport.h"
 #include "PersistentStorage.h"
 #include "ProjectSettings.h"
 #include "RefreshInfoGenerator.h"
@@ -22,9 +23,12 @@
 #include "TaskMergeStorages.h"
 #include "TaskParseWrapper.h"
 
+#include "FileInfo.h"
 #include "FilePath.h"
 #include "FileSystem.h"
+#include "FileWatcher.h"
 #include "MessageErrorCountClear.h"
+#include "MessageIndexingFilesChanged.h"
 #include "MessageIndexingFinished.h"
 #include "MessageIndexingShowDialog.h"
 #include "MessageIndexingStarted.h"
@@ -41,6 +45,7 @@
 #include "TaskReturnSuccessIf.h"
 #include "TaskSetValue.h"
 #include "TextAccess.h"
+#include "TimeStamp.h"
 #include "utility.h"
 #include "utilityApp.h"
 #include "utilityFile.h"
@@ -55,6 +60,8 @@ Project::Project(
 	, m_storageCache(storageCache)
 	, m_state(PROJECT_STATE_NOT_LOADED)
 	, m_refreshStage(RefreshStageType::NONE)
+	, m_indexingShardIndex(0)
+	, m_indexingShardCount(1)
 	, m_appUUID(appUUID)
 	, m_hasGUI(hasGUI)
 {
@@ -116,8 +123,7 @@ void Project::load(std::shared_ptr<DialogView> dialogView)
 	}
 
 	m_storageCache->clear();
-	m_storageCache->setSubject(
-		std::weak_ptr<StorageAccess>());	// TODO: check if this is really required.
+	releaseStorage();
 
 	if (!m_settings->reload())
 	{
@@ -130,7 +136,37 @@ void Project::load(std::shared_ptr<DialogView> dialogView)
 	const FilePath bookmarkDbPath = m_settings->getBookmarkDBFilePath();
 
 	{
+		RefreshInfo interruptedRefreshInfo;
 		if (tempDbPath.exists())
+		{
+			const PersistentStorage tempStorage(tempDbPath, FilePath());
+			if (!tempStorage.isIncompatible())
+			{
+				interruptedRefreshInfo = RefreshInfoGenerator::getRefreshInfoForCheckpoint(
+					tempStorage.getIndexingCheckpoint(), tempStorage.getIndexedFiles());
+			}
+		}
+
+		if (interruptedRefreshInfo.resume && !interruptedRefreshInfo.filesToIndex.empty())
+		{
+			if (dialogView->confirm(
+					L"Sourcetrail has been closed unexpectedly while indexing this project. "
+					L"You can either resume indexing the " +
+						std::to_wstring(interruptedRefreshInfo.filesToIndex.size()) +
+						L" source files that have not been stored yet or discard the indexed data "
+						L"and restore the state of your project before indexing.",
+					{L"Resume Indexing", L"Discard and Restore"}) != 1)
+			{
+				LOG_INFO("Keeping temporary indexing data to resume indexing");
+				m_interruptedRefreshInfo = interruptedRefreshInfo;
+			}
+			else
+			{
+				LOG_INFO("Discarding temporary indexing data on user's decision");
+				FileSystem::remove(tempDbPath);
+			}
+		}
+		else if (tempDbPath.exists())
 		{
 			if (dbPath.exists())
 			{
@@ -222,6 +258,7 @@ void Project::load(std::shared_ptr<DialogView> dialogView)
 	{
 		m_storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
 		m_storage->buildCaches();
+		m_storage->setConcurrentReadsEnabled(true);
 		m_storageCache->setSubject(m_storage);
 
 		if (m_hasGUI)
@@ -229,6 +266,8 @@ void Project::load(std::shared_ptr<DialogView> dialogView)
 			MessageIndexingFinished().dispatch();
 		}
 		MessageStatus(L"Finished Loading", false, false).dispatch();
+
+		startWatchingFiles();
 	}
 	else
 	{
@@ -266,7 +305,7 @@ void Project::load(std::shared_ptr<DialogView> dialogView)
 		}
 	}
 
-	if (m_state != PROJECT_STATE_LOADED && m_hasGUI)
+	if ((m_state != PROJECT_STATE_LOADED || m_interruptedRefreshInfo.resume) && m_hasGUI)
 	{
 		MessageRefresh().dispatch();
 	}
@@ -337,7 +376,29 @@ void Project::refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refres
 		break;
 	}
 
-	if (question.size() && m_hasGUI)
+	// an explicitly requested full refresh starts over instead of resuming an interrupted run
+	const bool discardInterruptedRun = refreshMode == REFRESH_ALL_FILES &&
+		m_interruptedRefreshInfo.resume;
+	if (refreshMode != REFRESH_ALL_FILES && !m_interruptedRefreshInfo.resume &&
+		m_state == PROJECT_STATE_LOADED)
+	{
+		// the data of an interrupted run was kept, so it continues with the files not stored yet
+		const std::string checkpoint = m_storage->getIndexingCheckpoint();
+		if (!checkpoint.empty())
+		{
+			const RefreshInfo interruptedRefreshInfo =
+				RefreshInfoGenerator::getRefreshInfoForCheckpoint(
+					checkpoint, m_storage->getIndexedFiles());
+			if (interruptedRefreshInfo.resume && !interruptedRefreshInfo.filesToIndex.empty())
+			{
+				m_interruptedRefreshInfo = interruptedRefreshInfo;
+			}
+		}
+	}
+
+	const bool resumeIndexing = m_interruptedRefreshInfo.resume && !discardInterruptedRun;
+
+	if (question.size() && m_hasGUI && !resumeIndexing)
 	{
 		if (dialogView->confirm(question, {L"Reindex", L"Cancel"}) == 1)
 		{
@@ -361,6 +422,13 @@ void Project::refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refres
 
 	m_refreshStage = RefreshStageType::REFRESHING;
 
+	if (discardInterruptedRun)
+	{
+		LOG_INFO("Discarding temporary indexing data for full refresh");
+		m_interruptedRefreshInfo = RefreshInfo();
+		FileSystem::remove(m_settings->getTempDBFilePath());
+	}
+
 	if (m_state == PROJECT_STATE_NEEDS_MIGRATION)
 	{
 		m_settings->migrate();
@@ -379,6 +447,15 @@ void Project::refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refres
 		}
 	}
 
+	if (resumeIndexing)
+	{
+		// the interrupted run already decided what to index, it just continues where it stopped
+		const RefreshInfo info = m_interruptedRefreshInfo;
+		m_interruptedRefreshInfo = RefreshInfo();
+		buildIndex(info, dialogView);
+		return;
+	}
+
 	if (needsFullRefresh || fullRefresh)
 	{
 		refreshMode = REFRESH_ALL_FILES;
@@ -417,33 +494,112 @@ void Project::refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refres
 			allowsShallowIndexing,
 			useShallowIndexing,
 			[this, dialogView](const RefreshInfo& info) { buildIndex(info, dialogView); },
-			[this]() { m_refreshStage = RefreshStageType::NONE; });
+			[this]() {
+				m_refreshStage = RefreshStageType::NONE;
+				clearSourceGroupCaches();
+			});
 	}
 	else
 	{
 		RefreshInfo info = getRefreshInfo(refreshMode);
 		info.shallow = useShallowIndexing;
+		RefreshInfoGenerator::restrictToShard(
+			&info, m_sourceGroups, m_indexingShardIndex, m_indexingShardCount);
 		buildIndex(info, dialogView);
 	}
 }
 
+void Project::setIndexingShard(size_t shardIndex, size_t shardCount)
+{
+	m_indexingShardIndex = shardIndex;
+	m_indexingShardCount = shardCount;
+}
+
 RefreshInfo Project::getRefreshInfo(RefreshMode mode) const
 {
+	const TimeStamp start = TimeStamp::now();
+
+	RefreshInfo info;
 	switch (mode)
 	{
 	case REFRESH_NONE:
-		return RefreshInfo();
+		break;
 
 	case REFRESH_UPDATED_FILES:
-		return RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(m_sourceGroups, m_storage);
+		info = RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(m_sourceGroups, m_storage);
+		break;
 
 	case REFRESH_UPDATED_AND_INCOMPLETE_FILES:
-		return RefreshInfoGenerator::getRefreshInfoForIncompleteFiles(m_sourceGroups, m_storage);
+		info = RefreshInfoGenerator::getRefreshInfoForIncompleteFiles(m_sourceGroups, m_storage);
+		break;
 
 	case REFRESH_ALL_FILES:
 	default:
-		return RefreshInfoGenerator::getRefreshInfoForAllFiles(m_sourceGroups);
+		info = RefreshInfoGenerator::getRefreshInfoForAllFiles(m_sourceGroups);
+		break;
 	}
+
+	info.collectionTimeMs = TimeStamp::now().deltaMS(start);
+	return info;
+}
+
+void Project::refreshChangedFiles(const std::set<FilePath>& changedFilePaths)
+{
+	utility::append(m_changedFilePaths, changedFilePaths);
+
+	if (m_changedFilePaths.empty() || m_refreshStage != RefreshStageType::NONE ||
+		m_state != PROJECT_STATE_LOADED || !m_storage)
+	{
+		return;
+	}
+
+	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
+	{
+		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED &&
+			!sourceGroup->allowsPartialClearing())
+		{
+			// these projects would need to get fully reindexed, which is left to the user
+			m_changedFilePaths.clear();
+			return;
+		}
+	}
+
+	const TimeStamp start = TimeStamp::now();
+	RefreshInfo info = RefreshInfoGenerator::getRefreshInfoForChangedFiles(
+		m_watchedSourceFilePaths, m_storage, m_changedFilePaths);
+	info.collectionTimeMs = TimeStamp::now().deltaMS(start);
+	info.background = true;
+
+	m_changedFilePaths.clear();
+
+	if (info.filesToIndex.empty() && info.filesToClear.empty() &&
+		info.nonIndexedFilesToClear.empty())
+	{
+		return;
+	}
+
+	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
+	{
+		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED &&
+			!sourceGroup->prepareIndexing())
+		{
+			return;
+		}
+	}
+
+	LOG_INFO(
+		"Indexing " + std::to_string(info.filesToIndex.size()) +
+		" files in the background after files were changed");
+
+	m_refreshStage = RefreshStageType::REFRESHING;
+
+	// a dialog view without GUI confirms nothing and keeps the indexed data
+	buildIndex(info, std::make_shared<DialogView>(DialogView::UseCase::INDEXING, nullptr));
+}
+
+std::shared_ptr<const IndexingReport> Project::getIndexingReport() const
+{
+	return m_indexingReport;
 }
 
 void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogView)
@@ -542,18 +698,30 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	const FilePath indexDbFilePath = m_settings->getDBFilePath();
 	const FilePath tempIndexDbFilePath = m_settings->getTempDBFilePath();
 
-	if (info.mode != REFRESH_ALL_FILES)
+	if (info.resume ? !tempIndexDbFilePath.exists() : info.mode != REFRESH_ALL_FILES)
 	{
 		// store the indexed data into the temp db but keep the current state to allow browsing
-		// while indexing
+		// while indexing. Runs resumed after a crash continue in the existing temp db, runs
+		// interrupted by the user continue with the data they stored into the index db.
 		FileSystem::copyFile(indexDbFilePath, tempIndexDbFilePath);
 	}
 
 	std::shared_ptr<PersistentStorage> tempStorage = std::make_shared<PersistentStorage>(
 		tempIndexDbFilePath, m_storage->getBookmarkDbFilePath());
 	tempStorage->setup();
+	if (!info.resume)
+	{
+		// the copied database may still contain the checkpoint of the run that created it
+		tempStorage->setIndexingCheckpoint("");
+	}
+
+	std::shared_ptr<IndexingReport> report = std::make_shared<IndexingReport>();
+	report->addPhaseTime("refresh info", info.collectionTimeMs * 1000);
+	m_indexingReport = report;
 
 	std::shared_ptr<TaskGroupSequence> taskSequential = std::make_shared<TaskGroupSequence>();
+	taskSequential->addTask(
+		std::make_shared<TaskSetValue<std::shared_ptr<IndexingReport>>>("indexing_report", report));
 
 	if (info.mode != REFRESH_ALL_FILES &&
 		(info.filesToClear.size() || info.nonIndexedFilesToClear.size()))
@@ -565,6 +733,21 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 			info.mode == REFRESH_UPDATED_AND_INCOMPLETE_FILES));
 	}
 
+	if (!info.resume)
+	{
+		// the checkpoint is stored once the temp db is cleared, from then on every injected
+		// storage is committed and an interrupted run can resume with the files not stored yet.
+		// A resumed run keeps the checkpoint of the run it continues.
+		std::weak_ptr<PersistentStorage> weakTempStorage = tempStorage;
+		taskSequential->addTask(std::make_shared<TaskLambda>([weakTempStorage, info]() {
+			if (std::shared_ptr<PersistentStorage> storage = weakTempStorage.lock())
+			{
+				storage->setIndexingCheckpoint(RefreshInfoGenerator::getCheckpointForRefreshInfo(
+					info, storage->getIndexedFiles()));
+			}
+		}));
+	}
+
 	tempStorage->setProjectSettingsText(
 		TextAccess::createFromFile(getProjectSettingsFilePath())->getText());
 	tempStorage->updateVersion();
@@ -573,6 +756,7 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 		std::make_unique<CombinedIndexerCommandProvider>();
 	std::unique_ptr<CombinedIndexerCommandProvider> customIndexerCommandProvider =
 		std::make_unique<CombinedIndexerCommandProvider>();
+	const TimeStamp enumerationStart = TimeStamp::now();
 	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
 	{
 		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED)
@@ -596,7 +780,11 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 		}
 	}
 
+	report->addPhaseTime(
+		"enumerate source files", TimeStamp::now().deltaMS(enumerationStart) * 1000);
+
 	size_t sourceFileCount = indexerCommandProvider->size() + customIndexerCommandProvider->size();
+	report->setValue("source_file_count", sourceFileCount);
 
 	taskSequential->addTask(std::make_shared<TaskSetValue<bool>>("shallow_indexing", info.shallow));
 	taskSequential->addTask(std::make_shared<TaskSetValue<int>>("source_file_count", sourceFileCount));
@@ -605,7 +793,12 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	taskSequential->addTask(std::make_shared<TaskSetValue<float>>("index_time", 0.0f));
 
 	int indexerThreadCount = ApplicationSettings::getInstance()->getIndexerThreadCount();
-	if (indexerThreadCount <= 0)
+	if (info.background)
+	{
+		// keeps the machine responsive while the user continues editing
+		indexerThreadCount = 1;
+	}
+	else if (indexerThreadCount <= 0)
 	{
 		indexerThreadCount = utility::getIdealThreadCount();
 		if (indexerThreadCount <= 0)
@@ -618,8 +811,24 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	{
 		const int adjustedIndexerThreadCount = std::min<int>(
 			indexerThreadCount, indexerCommandProvider->size());
+		report->setValue("indexer_thread_count", adjustedIndexerThreadCount);
+
+		bool multiProcess = ApplicationSettings::getInstance()->getMultiProcessIndexingEnabled() &&
+			hasCxxSourceGroup();
 
-		std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+		const int memoryBudgetMB = ApplicationSettings::getInstance()->getIndexingMemoryBudget();
+		size_t memoryBudget = 0;
+		if (memoryBudgetMB > 0)
+		{
+			memoryBudget = static_cast<size_t>(memoryBudgetMB) * 1048576;
+			if (!multiProcess && hasCxxSourceGroup())
+			{
+				// indexer threads cache the contents of files in the memory of the app
+				memoryBudget -= ApplicationSettings::getInstance()->getIndexingFileCacheByteSize();
+			}
+		}
+		std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>(
+			memoryBudget);
 		// add tasks for setting some variables on the blackboard that are used during indexing
 		taskSequential->addTask(
 			std::make_shared<TaskSetValue<bool>>("indexer_threads_started", false));
@@ -650,11 +859,9 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 
 		// add task for refilling the indexer command queue
 		taskParallelIndexing->addTask(std::make_shared<TaskFillIndexerCommandsQueue>(
-			m_appUUID, std::move(indexerCommandProvider), 20));
+			m_appUUID, std::move(indexerCommandProvider), 20, m_storage->getIndexingCosts()));
 
 		// add task for indexing
-		bool multiProcess = ApplicationSettings::getInstance()->getMultiProcessIndexingEnabled() &&
-			hasCxxSourceGroup();
 		taskParallelIndexing->addChildTasks(std::make_shared<TaskGroupSequence>()->addChildTasks(
 			// block until there are indexer commands to process
 			std::make_shared<TaskDecoratorRepeat>(
@@ -710,6 +917,22 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 			std::make_shared<TaskDecoratorRepeat>(
 				TaskDecoratorRepeat::CONDITION_WHILE_SUCCESS, Task::STATE_SUCCESS, 25)
 				->addChildTask(std::make_shared<TaskInjectStorage>(storageProvider, tempStorage)));
+
+		// add task that stores the measured indexing costs for scheduling upcoming runs
+		std::weak_ptr<PersistentStorage> weakTempStorage = tempStorage;
+		taskSequential->addTask(
+			std::make_shared<TaskLambda>([storageProvider, weakTempStorage, report]() {
+				const std::vector<StorageIndexingCost> costs =
+					storageProvider->consumeIndexingCosts();
+				report->addTranslationUnits(costs);
+				report->setValue("max_queued_storage_count", storageProvider->getMaxStorageCount());
+				report->setValue("max_queued_storage_bytes", storageProvider->getMaxByteSize());
+
+				if (std::shared_ptr<PersistentStorage> storage = weakTempStorage.lock())
+				{
+					storage->addIndexingCosts(costs);
+				}
+			}));
 	}
 	else
 	{
@@ -748,7 +971,10 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 
 	taskSequential->addTask(std::make_shared<TaskLambda>([dialogView, this]() {
 		m_refreshStage = RefreshStageType::NONE;
-		MessageIndexingFinished().dispatch();
+		// dispatched behind the storage swap, so the new index and its report are complete
+		Task::dispatch(TabId::app(), std::make_shared<TaskLambda>([]() {
+						   MessageIndexingFinished().dispatch();
+					   }));
 	}));
 
 	taskSequential->addTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
@@ -772,6 +998,27 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 		L"Starting Indexing: " + std::to_wstring(sourceFileCount) + L" source files", false, true)
 		.dispatch();
 	MessageIndexingStarted().dispatch();
+
+	// the indexer commands are created, so the source groups don't need their parsed data anymore
+	clearSourceGroupCaches();
+}
+
+void Project::releaseStorage()
+{
+	// queries of other threads, e.g. jobs of the thread pool, keep the storage alive while they
+	// run. Once the cache stops handing it out, no new ones start and the running ones finish.
+	// Prefetches stop after their current query.
+	StorageCache::cancelPrefetches();
+	m_storageCache->setSubject(std::weak_ptr<StorageAccess>());
+	m_storageCache->waitForReaders();
+	if (!m_storage)
+	{
+		return;
+	}
+
+	// closes the connections of the threads that ran queries
+	m_storage->setConcurrentReadsEnabled(false);
+	m_storage.reset();
 }
 
 void Project::swapToTempStorage(std::shared_ptr<DialogView> dialogView)
@@ -782,7 +1029,7 @@ void Project::swapToTempStorage(std::shared_ptr<DialogView> dialogView)
 	const FilePath tempIndexDbFilePath = m_settings->getTempDBFilePath();
 	const FilePath bookmarkDbFilePath = m_settings->getBookmarkDBFilePath();
 
-	m_storage.reset();
+	releaseStorage();
 
 	if (!swapToTempStorageFile(indexDbFilePath, tempIndexDbFilePath, dialogView))
 	{
@@ -796,11 +1043,21 @@ void Project::swapToTempStorage(std::shared_ptr<DialogView> dialogView)
 	// std::shared_ptr<DialogView> dialogView =
 	// Application::getInstance()->getDialogView(DialogView::UseCase::INDEXING);
 	// dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Building caches");
-	m_storage->buildCaches();
+	m_storage->buildCaches(m_indexingReport.get());
 	// dialogView->hideUnknownProgressDialog();
 
+	if (m_indexingReport)
+	{
+		m_storage->setIndexingReport(m_indexingReport->toJson());
+	}
+
+	// the index is not written anymore until it gets replaced by the next indexing run
+	m_storage->setConcurrentReadsEnabled(true);
 	m_storageCache->setSubject(m_storage);
 	m_state = PROJECT_STATE_LOADED;
+
+	// files indexed for the first time need to be watched as well
+	startWatchingFiles();
 }
 
 bool Project::swapToTempStorageFile(
@@ -839,6 +1096,69 @@ void Project::discardTempStorage()
 	}
 }
 
+void Project::startWatchingFiles()
+{
+	m_fileWatcher.reset();
+	m_watchedSourceFilePaths.clear();
+
+	if (!m_hasGUI || !FileWatcher::isSupported() ||
+		!ApplicationSettings::getInstance()->getBackgroundIndexingEnabled())
+	{
+		return;
+	}
+
+	m_watchedSourceFilePaths = RefreshInfoGenerator::getAllSourceFilePaths(m_sourceGroups);
+	clearSourceGroupCaches();
+
+	std::shared_ptr<std::set<FilePath>> watchedFilePaths = std::make_shared<std::set<FilePath>>(
+		m_watchedSourceFilePaths);
+	for (const FileInfo& fileInfo: m_storage->getFileInfoForAllFiles())
+	{
+		watchedFilePaths->insert(fileInfo.path);
+	}
+
+	std::set<FilePath> directoryPaths;
+	for (const FilePath& filePath: *watchedFilePaths)
+	{
+		const FilePath directoryPath = filePath.getParentDirectory();
+		if (directoryPath.exists())
+		{
+			directoryPaths.insert(directoryPath);
+		}
+	}
+
+	// waits for a quiet second, so saving several files at once results in one refresh
+	m_fileWatcher = std::make_unique<FileWatcher>(
+		1000, [watchedFilePaths](const std::set<FilePath>& changedFilePaths) {
+			std::set<FilePath> relevantFilePaths;
+			for (const FilePath& filePath: changedFilePaths)
+			{
+				if (watchedFilePaths->find(filePath) != watchedFilePaths->end())
+				{
+					relevantFilePaths.insert(filePath);
+				}
+			}
+
+			if (!relevantFilePaths.empty())
+			{
+				MessageIndexingFilesChanged(relevantFilePaths).dispatch();
+			}
+		});
+
+	if (!m_fileWatcher->start(directoryPaths))
+	{
+		m_fileWatcher.reset();
+	}
+}
+
+void Project::clearSourceGroupCaches() const
+{
+	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
+	{
+		sourceGroup->clearCaches();
+	}
+}
+
 bool Project::hasCxxSourceGroup() const
 {
 #if BUILD_CXX_LANGUAGE_PACKAGE
@@ -12,6 +12,8 @@
 struct FileInfo;
 class DialogView;
 class FilePath;
+class FileWatcher;
+class IndexingReport;
 class PersistentStorage;
 class ProjectSettings;
 class StorageCache;
@@ -39,10 +41,20 @@ public:
 
 	void refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refreshMode, bool shallowIndexingRequested);
 
+	// restricts refreshes without GUI to one of several shards of the source files
+	void setIndexingShard(size_t shardIndex, size_t shardCount);
+
 	RefreshInfo getRefreshInfo(RefreshMode mode) const;
 
 	void buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogView);
 
+	// indexes the changed files and the files depending on them in the background, changes that
+	// are reported while indexing are kept until the running refresh has finished
+	void refreshChangedFiles(const std::set<FilePath>& changedFilePaths);
+
+	// report of the last indexing run, nullptr if the project was not indexed since loading
+	std::shared_ptr<const IndexingReport> getIndexingReport() const;
+
 private:
 	enum ProjectStateType
 	{
@@ -64,6 +76,8 @@ private:
 
 	Project(const Project&);
 
+	// waits for queries of other threads that still use the storage, so its files can be replaced
+	void releaseStorage();
 	void swapToTempStorage(std::shared_ptr<DialogView> dialogView);
 	bool swapToTempStorageFile(
 		const FilePath& indexDbFilePath,
@@ -71,6 +85,9 @@ private:
 		std::shared_ptr<DialogView> dialogView);
 	void discardTempStorage();
 
+	void startWatchingFiles();
+	void clearSourceGroupCaches() const;
+
 	bool hasCxxSourceGroup() const;
 
 	std::shared_ptr<ProjectSettings> m_settings;
@@ -81,6 +98,17 @@ private:
 
 	std::shared_ptr<PersistentStorage> m_storage;
 	std::vector<std::shared_ptr<SourceGroup>> m_sourceGroups;
+	std::shared_ptr<IndexingReport> m_indexingReport;
+
+	// run that was interrupted before its temp db could be swapped in
+	RefreshInfo m_interruptedRefreshInfo;
+
+	std::unique_ptr<FileWatcher> m_fileWatcher;
+	std::set<FilePath> m_watchedSourceFilePaths;
+	std::set<FilePath> m_changedFilePaths;
+
+	size_t m_indexingShardIndex;
+	size_t m_indexingShardCount;
 
 	std::string m_appUUID;
 	bool m_hasGUI;
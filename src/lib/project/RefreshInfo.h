@@ -21,6 +21,15 @@ struct RefreshInfo
 
 	RefreshMode mode = REFRESH_NONE;
 	bool shallow = false;
+
+	// continues an interrupted run in its temporary database instead of starting over
+	bool resume = false;
+
+	// started by file changes instead of the user, runs with a single indexer thread
+	bool background = false;
+
+	// time spent collecting the files above, reported after indexing
+	size_t collectionTimeMs = 0;
 };
 
 #endif	  // REFRESH_INFO_H
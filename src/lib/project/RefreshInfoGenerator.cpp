@@ -1,5 +1,8 @@
 #include "RefreshInfoGenerator.h"
 
+#include <cstdlib>
+#include <sstream>
+
 #include "FileInfo.h"
 #include "FileSystem.h"
 #include "PersistentStorage.h"
@@ -8,6 +11,7 @@
 #include "SourceGroupStatusType.h"
 #include "TextAccess.h"
 #include "utility.h"
+#include "utilityString.h"
 
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
 	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
@@ -74,46 +78,8 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(
 	const std::set<FilePath> allSourceFilePathsFromSourcegroups = getAllSourceFilePaths(sourceGroups);
 
 	// 2) Figure out which files need to be cleared
-	// 2.1) Add all changed files
-	std::set<FilePath> filesToClear = changedFilePaths;
-
-	// 2.2) Add files that are reference the changed files
-	utility::append(filesToClear, storage->getReferencing(changedFilePaths));
-
-	// 2.3) Handle files that are referenced by the files that will be cleared. These will be
-	// re-indexed on the fly. However, we do not
-	//		need to clear files that are also referenced by unchanged source files, because otherwise
-	//we will lose these connections.
-	// 2.3.1) Get all source file paths that will not be cleared.
-	// - Initially this list contains all source file paths the project would index right now.
-	// - Then we remove all source files that will be cleared
-	// - NOTE: Source files that are new to the project will part of this list, but won't result in
-	// any referenced
-	//   paths because they are not part of the DB. Source files that are new to the project but are
-	//   already in the DB will be removed from this list if they have changed or reference changed
-	//   files.
-	std::set<FilePath> staticSourceFiles = allSourceFilePathsFromSourcegroups;
-	for (const FilePath& path: filesToClear)
-	{
-		staticSourceFiles.erase(path);
-	}
-
-	// 2.3.2) Get sets of referenced files
-	const std::set<FilePath> staticReferencedFilePaths = storage->getReferenced(staticSourceFiles);
-	const std::set<FilePath> dynamicReferencedFilePaths = storage->getReferenced(filesToClear);
-
-	// 2.3.3) Add "dynamicReferencedFilePaths" to "filesToClear" that are not refenced by static
-	// paths, because these files may not be
-	//        referenced anymore. If they still are, they will be re-added when encountered during
-	//        re-indexing.
-	for (const FilePath& path: dynamicReferencedFilePaths)
-	{
-		if (staticReferencedFilePaths.find(path) == staticReferencedFilePaths.end() &&
-			staticSourceFiles.find(path) == staticSourceFiles.end())
-		{
-			filesToClear.insert(path);
-		}
-	}
+	const std::set<FilePath> filesToClear = getFilesToClear(
+		changedFilePaths, allSourceFilePathsFromSourcegroups, storage);
 
 	// 3) Figure out which files need to be indexed
 	std::set<FilePath> filesToIndex;
@@ -199,6 +165,55 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForIncompleteFiles(
 	return info;
 }
 
+RefreshInfo RefreshInfoGenerator::getRefreshInfoForChangedFiles(
+	const std::set<FilePath>& sourceFilePaths,
+	std::shared_ptr<const PersistentStorage> storage,
+	const std::set<FilePath>& changedFilePaths)
+{
+	// only files known by the storage or source files of the project can affect the index
+	std::set<FilePath> relevantFilePaths;
+	for (const FilePath& path: changedFilePaths)
+	{
+		if (sourceFilePaths.find(path) != sourceFilePaths.end() ||
+			storage->getNodeIdForFileNode(path) != 0)
+		{
+			relevantFilePaths.insert(path);
+		}
+	}
+
+	RefreshInfo info;
+	if (relevantFilePaths.empty())
+	{
+		return info;
+	}
+
+	const std::set<FilePath> filesToClear = getFilesToClear(
+		relevantFilePaths, sourceFilePaths, storage);
+
+	info.mode = REFRESH_UPDATED_FILES;
+	for (const FilePath& path: filesToClear)
+	{
+		if (sourceFilePaths.find(path) != sourceFilePaths.end() && path.exists())
+		{
+			info.filesToIndex.insert(path);
+		}
+	}
+
+	for (const FilePath& fileToClear: filesToClear)
+	{
+		if (storage->getFilePathIndexed(fileToClear))
+		{
+			info.filesToClear.insert(fileToClear);
+		}
+		else if (storage->getNodeIdForFileNode(fileToClear) != 0)
+		{
+			info.nonIndexedFilesToClear.insert(fileToClear);
+		}
+	}
+
+	return info;
+}
+
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForAllFiles(
 	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups)
 {
@@ -208,6 +223,102 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForAllFiles(
 	return info;
 }
 
+void RefreshInfoGenerator::restrictToShard(
+	RefreshInfo* info,
+	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
+	size_t shardIndex,
+	size_t shardCount)
+{
+	if (shardCount <= 1)
+	{
+		return;
+	}
+
+	std::set<FilePath> shardFilePaths;
+	size_t position = 0;
+	for (const FilePath& sourceFilePath: getAllSourceFilePaths(sourceGroups))
+	{
+		if (position++ % shardCount == shardIndex && info->filesToIndex.count(sourceFilePath))
+		{
+			shardFilePaths.insert(sourceFilePath);
+		}
+	}
+
+	info->filesToIndex = std::move(shardFilePaths);
+}
+
+std::string RefreshInfoGenerator::getCheckpointForRefreshInfo(
+	const RefreshInfo& info, const std::set<FilePath>& indexedFilePaths)
+{
+	std::stringstream ss;
+	ss << "mode " << info.mode << "\n";
+	ss << "shallow " << (info.shallow ? 1 : 0) << "\n";
+
+	for (const FilePath& filePath: info.filesToIndex)
+	{
+		ss << (indexedFilePaths.count(filePath) ? "reindex " : "index ")
+		   << utility::encodeToUtf8(filePath.wstr()) << "\n";
+	}
+
+	return ss.str();
+}
+
+RefreshInfo RefreshInfoGenerator::getRefreshInfoForCheckpoint(
+	const std::string& checkpoint, const std::set<FilePath>& indexedFilePaths)
+{
+	RefreshInfo info;
+
+	std::stringstream ss(checkpoint);
+	std::string line;
+	while (std::getline(ss, line))
+	{
+		const size_t separatorPos = line.find(' ');
+		if (separatorPos == std::string::npos)
+		{
+			return RefreshInfo();
+		}
+
+		const std::string key = line.substr(0, separatorPos);
+		const std::string value = line.substr(separatorPos + 1);
+
+		if (key == "mode")
+		{
+			const int mode = std::atoi(value.c_str());
+			if (mode < REFRESH_NONE || mode > REFRESH_ALL_FILES)
+			{
+				return RefreshInfo();
+			}
+			info.mode = RefreshMode(mode);
+		}
+		else if (key == "shallow")
+		{
+			info.shallow = (value == "1");
+		}
+		else if (key == "reindex")
+		{
+			info.filesToIndex.insert(FilePath(utility::decodeFromUtf8(value)));
+		}
+		else if (key == "index")
+		{
+			const FilePath filePath(utility::decodeFromUtf8(value));
+			if (!indexedFilePaths.count(filePath))
+			{
+				info.filesToIndex.insert(filePath);
+			}
+		}
+		else
+		{
+			return RefreshInfo();
+		}
+	}
+
+	if (info.mode != REFRESH_NONE)
+	{
+		info.resume = true;
+	}
+	return info;
+}
+
 std::set<FilePath> RefreshInfoGenerator::getAllSourceFilePaths(
 	const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups)
 {
@@ -230,6 +341,52 @@ std::set<FilePath> RefreshInfoGenerator::getAllSourceFilePaths(
 	return allSourceFilePaths;
 }
 
+std::set<FilePath> RefreshInfoGenerator::getFilesToClear(
+	const std::set<FilePath>& changedFilePaths,
+	const std::set<FilePath>& sourceFilePaths,
+	std::shared_ptr<const PersistentStorage> storage)
+{
+	// 1) Add all changed files
+	std::set<FilePath> filesToClear = changedFilePaths;
+
+	// 2) Add files that are reference the changed files
+	utility::append(filesToClear, storage->getReferencing(changedFilePaths));
+
+	// 3) Handle files that are referenced by the files that will be cleared. These will be
+	// re-indexed on the fly. However, we do not need to clear files that are also referenced by
+	// unchanged source files, because otherwise we will lose these connections.
+	// 3.1) Get all source file paths that will not be cleared.
+	// - Initially this list contains all source file paths the project would index right now.
+	// - Then we remove all source files that will be cleared
+	// - NOTE: Source files that are new to the project will part of this list, but won't result in
+	//   any referenced paths because they are not part of the DB. Source files that are new to the
+	//   project but are already in the DB will be removed from this list if they have changed or
+	//   reference changed files.
+	std::set<FilePath> staticSourceFiles = sourceFilePaths;
+	for (const FilePath& path: filesToClear)
+	{
+		staticSourceFiles.erase(path);
+	}
+
+	// 3.2) Get sets of referenced files
+	const std::set<FilePath> staticReferencedFilePaths = storage->getReferenced(staticSourceFiles);
+	const std::set<FilePath> dynamicReferencedFilePaths = storage->getReferenced(filesToClear);
+
+	// 3.3) Add "dynamicReferencedFilePaths" to "filesToClear" that are not refenced by static
+	// paths, because these files may not be referenced anymore. If they still are, they will be
+	// re-added when encountered during re-indexing.
+	for (const FilePath& path: dynamicReferencedFilePaths)
+	{
+		if (staticReferencedFilePaths.find(path) == staticReferencedFilePaths.end() &&
+			staticSourceFiles.find(path) == staticSourceFiles.end())
+		{
+			filesToClear.insert(path);
+		}
+	}
+
+	return filesToClear;
+}
+
 bool RefreshInfoGenerator::didFileChange(
 	const FileInfo& info, std::shared_ptr<const PersistentStorage> storage)
 {
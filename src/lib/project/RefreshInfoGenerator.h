@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 struct FileInfo;
@@ -22,13 +23,48 @@ public:
 		const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
 		std::shared_ptr<const PersistentStorage> storage);
 
+	// Computes the files affected by the changes reported for the given paths, e.g. by a file
+	// watcher, without checking the modification dates of all files in the storage. Changed paths
+	// that are neither source files nor known by the storage are ignored.
+	static RefreshInfo getRefreshInfoForChangedFiles(
+		const std::set<FilePath>& sourceFilePaths,
+		std::shared_ptr<const PersistentStorage> storage,
+		const std::set<FilePath>& changedFilePaths);
+
 	static RefreshInfo getRefreshInfoForAllFiles(
 		const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups);
 
-private:
+	// Keeps only the files to index that belong to the shard, so several machines can each index
+	// one part of the project into their own database. The source files of all source groups are
+	// distributed round robin in path order, so shards do not depend on the location of the
+	// checkout and stay stable between runs as long as no source files are added or removed.
+	static void restrictToShard(
+		RefreshInfo* info,
+		const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
+		size_t shardIndex,
+		size_t shardCount);
+
+	// Describes the files an indexing run is going to index. The checkpoint is stored in the
+	// temporary database once it is cleared, so an interrupted run can be resumed later on.
+	// Files that are already indexed in the database at that point are marked to be reindexed
+	// in any case.
+	static std::string getCheckpointForRefreshInfo(
+		const RefreshInfo& info, const std::set<FilePath>& indexedFilePaths);
+
+	// Resumes the run of the checkpoint with the files whose index has not been stored yet.
+	// Returns a refresh info with mode REFRESH_NONE if the checkpoint is empty or invalid.
+	static RefreshInfo getRefreshInfoForCheckpoint(
+		const std::string& checkpoint, const std::set<FilePath>& indexedFilePaths);
+
 	static std::set<FilePath> getAllSourceFilePaths(
 		const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups);
 
+private:
+	static std::set<FilePath> getFilesToClear(
+		const std::set<FilePath>& changedFilePaths,
+		const std::set<FilePath>& sourceFilePaths,
+		std::shared_ptr<const PersistentStorage> storage);
+
 	static bool didFileChange(const FileInfo& info, std::shared_ptr<const PersistentStorage> storage);
 };
 
@@ -18,6 +18,8 @@ std::shared_ptr<Task> SourceGroup::getPreIndexTask(
 	return std::make_shared<TaskLambda>([]() {});
 }
 
+void SourceGroup::clearCaches() const {}
+
 SourceGroupType SourceGroup::getType() const
 {
 	return getSourceGroupSettings()->getType();
@@ -38,6 +38,7 @@ public:
 	virtual std::shared_ptr<Task> getPreIndexTask(
 		std::shared_ptr<StorageProvider> storageProvider,
 		std::shared_ptr<DialogView> dialogView) const;
+	virtual void clearCaches() const;
 
 	SourceGroupType getType() const;
 	LanguageType getLanguage() const;
@@ -1,5 +1,7 @@
 #include "ApplicationSettings.h"
 
+#include <algorithm>
+
 #include "AppPath.h"
 #include "Logger.h"
 #include "ResourcePaths.h"
@@ -337,6 +339,16 @@ void ApplicationSettings::setVerboseIndexerLoggingEnabled(bool value)
 	setValue<bool>("application/verbose_indexer_logging_enabled", value);
 }
 
+bool ApplicationSettings::getTracingEnabled() const
+{
+	return getValue<bool>("application/tracing_enabled", false);
+}
+
+void ApplicationSettings::setTracingEnabled(bool value)
+{
+	setValue<bool>("application/tracing_enabled", value);
+}
+
 void ApplicationSettings::setLogFilter(int mask)
 {
 	setValue<int>("application/log_filter", mask);
@@ -378,6 +390,49 @@ void ApplicationSettings::setMultiProcessIndexingEnabled(bool enabled)
 	setValue<bool>("indexing/multi_process_indexing", enabled);
 }
 
+int ApplicationSettings::getIndexingMemoryBudget() const
+{
+	return getValue<int>("indexing/memory_budget", 0);
+}
+
+void ApplicationSettings::setIndexingMemoryBudget(int budget)
+{
+	setValue<int>("indexing/memory_budget", budget);
+}
+
+size_t ApplicationSettings::getIndexingFileCacheByteSize() const
+{
+	const size_t maxByteSize = 512 * 1024 * 1024;
+	const int budget = getIndexingMemoryBudget();
+	if (budget <= 0)
+	{
+		return maxByteSize;
+	}
+
+	// a quarter of the budget, the rest is left for the queued intermediate storages
+	return std::min(maxByteSize, static_cast<size_t>(budget) * 1024 * 1024 / 4);
+}
+
+bool ApplicationSettings::getCxxAutomaticPreamblesEnabled() const
+{
+	return getValue<bool>("indexing/cxx/automatic_preambles", false);
+}
+
+void ApplicationSettings::setCxxAutomaticPreamblesEnabled(bool enabled)
+{
+	setValue<bool>("indexing/cxx/automatic_preambles", enabled);
+}
+
+bool ApplicationSettings::getBackgroundIndexingEnabled() const
+{
+	return getValue<bool>("indexing/background_indexing_enabled", false);
+}
+
+void ApplicationSettings::setBackgroundIndexingEnabled(bool enabled)
+{
+	setValue<bool>("indexing/background_indexing_enabled", enabled);
+}
+
 FilePath ApplicationSettings::getJavaPath() const
 {
 	return FilePath(getValue<std::wstring>("indexing/java/java_path", L""));
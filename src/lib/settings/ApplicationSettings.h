@@ -82,6 +82,9 @@ public:
 	bool getVerboseIndexerLoggingEnabled() const;
 	void setVerboseIndexerLoggingEnabled(bool loggingEnabled);
 
+	bool getTracingEnabled() const;
+	void setTracingEnabled(bool tracingEnabled);
+
 	int getLogFilter() const;
 	void setLogFilter(int mask);
 
@@ -95,6 +98,18 @@ public:
 	bool getMultiProcessIndexingEnabled() const;
 	void setMultiProcessIndexingEnabled(bool enabled);
 
+	int getIndexingMemoryBudget() const;	// in MB, 0 means unlimited
+	void setIndexingMemoryBudget(int budget);
+
+	// part of the memory budget the indexers may use for caching the contents of files, in bytes
+	size_t getIndexingFileCacheByteSize() const;
+
+	bool getCxxAutomaticPreamblesEnabled() const;
+	void setCxxAutomaticPreamblesEnabled(bool enabled);
+
+	bool getBackgroundIndexingEnabled() const;
+	void setBackgroundIndexingEnabled(bool enabled);
+
 	FilePath getJavaPath() const;
 	void setJavaPath(const FilePath& path);
 
@@ -0,0 +1,140 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <functional>
+#include <vector>
+
+// Open addressing hash set of positions within a vector that is owned by someone else. The keys
+// are only stored in the vector, so indexing records with long names does not copy the names. The
+// vector elements need to convert to the key type that Hash and Equal take.
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class HashIndex
+{
+public:
+	static const size_t s_notFound = ~size_t(0);
+
+	HashIndex(): m_size(0) {}
+
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	// returns the position of the element equal to the key or s_notFound
+	template <typename Element>
+	size_t find(const Key& key, const std::vector<Element>& elements) const;
+
+	// the position needs to refer to an element that has no equal element in the index yet
+	template <typename Element>
+	void insert(size_t position, const std::vector<Element>& elements);
+
+	template <typename Element>
+	void rebuild(const std::vector<Element>& elements);
+
+private:
+	struct Slot
+	{
+		size_t hash;
+		size_t position;
+	};
+
+	static size_t getFirstSlotIndex(size_t hash, size_t mask);
+	void insertSlot(const Slot& slot);
+
+	std::vector<Slot> m_slots;
+	size_t m_size;
+};
+
+template <typename Key, typename Hash, typename Equal>
+const size_t HashIndex<Key, Hash, Equal>::s_notFound;
+
+template <typename Key, typename Hash, typename Equal>
+template <typename Element>
+size_t HashIndex<Key, Hash, Equal>::find(const Key& key, const std::vector<Element>& elements) const
+{
+	if (m_slots.empty())
+	{
+		return s_notFound;
+	}
+
+	const size_t hash = Hash()(key);
+	const size_t mask = m_slots.size() - 1;
+	for (size_t i = getFirstSlotIndex(hash, mask); m_slots[i].position != s_notFound;
+		 i = (i + 1) & mask)
+	{
+		const Slot& slot = m_slots[i];
+		if (slot.hash == hash && Equal()(elements[slot.position], key))
+		{
+			return slot.position;
+		}
+	}
+	return s_notFound;
+}
+
+template <typename Key, typename Hash, typename Equal>
+template <typename Element>
+void HashIndex<Key, Hash, Equal>::insert(size_t position, const std::vector<Element>& elements)
+{
+	// linear probing stays short below a load factor of 3/4, the slot count is a power of two
+	if ((m_size + 1) * 4 > m_slots.size() * 3)
+	{
+		std::vector<Slot> slots;
+		slots.swap(m_slots);
+		m_slots.resize(slots.empty() ? 16 : slots.size() * 2, Slot {0, s_notFound});
+
+		for (const Slot& slot: slots)
+		{
+			if (slot.position != s_notFound)
+			{
+				insertSlot(slot);
+			}
+		}
+	}
+
+	insertSlot({Hash()(elements[position]), position});
+	m_size++;
+}
+
+template <typename Key, typename Hash, typename Equal>
+template <typename Element>
+void HashIndex<Key, Hash, Equal>::rebuild(const std::vector<Element>& elements)
+{
+	clear();
+	for (size_t i = 0; i < elements.size(); i++)
+	{
+		if (find(elements[i], elements) == s_notFound)
+		{
+			insert(i, elements);
+		}
+	}
+}
+
+template <typename Key, typename Hash, typename Equal>
+size_t HashIndex<Key, Hash, Equal>::getFirstSlotIndex(size_t hash, size_t mask)
+{
+	// integer hashes are often the identity, mixing spreads combined ids over all slots
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3b;
+	hash ^= hash >> 16;
+	return hash & mask;
+}
+
+template <typename Key, typename Hash, typename Equal>
+void HashIndex<Key, Hash, Equal>::insertSlot(const Slot& slot)
+{
+	const size_t mask = m_slots.size() - 1;
+	size_t i = getFirstSlotIndex(slot.hash, mask);
+	while (m_slots[i].position != s_notFound)
+	{
+		i = (i + 1) & mask;
+	}
+	m_slots[i] = slot;
+}
+
+#endif	  // HASH_INDEX_H
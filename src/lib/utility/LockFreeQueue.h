@@ -0,0 +1,131 @@
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Unbounded FIFO queue for multiple producers and a single consumer. Pushing is wait-free and only
+// touches the mutex when the consumer is blocked in waitForValue(). Based on the intrusive node
+// queue by Dmitry Vyukov, the consumer always keeps one node that is no longer part of the queue.
+template <typename T>
+class LockFreeQueue
+{
+public:
+	LockFreeQueue();
+	~LockFreeQueue();
+
+	LockFreeQueue(const LockFreeQueue&) = delete;
+	void operator=(const LockFreeQueue&) = delete;
+
+	// may be called from any thread
+	void push(T value);
+
+	// may only be called from the consumer thread, returns false if no value is available
+	bool pop(T* value);
+
+	// blocks the consumer thread until values were pushed or wakeUp() was called
+	void waitForValue();
+	void wakeUp();
+
+	size_t size() const;
+
+private:
+	struct Node
+	{
+		Node(): next(nullptr) {}
+		Node(T value): value(std::move(value)), next(nullptr) {}
+
+		T value;
+		std::atomic<Node*> next;
+	};
+
+	std::atomic<Node*> m_head;
+	Node* m_tail;
+	std::atomic<size_t> m_size;
+
+	std::atomic<bool> m_consumerWaiting;
+	bool m_wokenUp;
+	std::mutex m_waitMutex;
+	std::condition_variable m_waitCondition;
+};
+
+template <typename T>
+LockFreeQueue<T>::LockFreeQueue()
+	: m_head(new Node()), m_size(0), m_consumerWaiting(false), m_wokenUp(false)
+{
+	m_tail = m_head.load();
+}
+
+template <typename T>
+LockFreeQueue<T>::~LockFreeQueue()
+{
+	T value;
+	while (pop(&value))
+		;
+	delete m_tail;
+}
+
+template <typename T>
+void LockFreeQueue<T>::push(T value)
+{
+	// counted before linking, so the size never drops below the number of reachable values
+	m_size++;
+
+	Node* node = new Node(std::move(value));
+	Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+	previous->next.store(node, std::memory_order_release);
+
+	// either the consumer sees the new size before blocking or the producer sees it waiting
+	if (m_consumerWaiting)
+	{
+		std::lock_guard<std::mutex> lock(m_waitMutex);
+		m_waitCondition.notify_one();
+	}
+}
+
+template <typename T>
+bool LockFreeQueue<T>::pop(T* value)
+{
+	Node* next = m_tail->next.load(std::memory_order_acquire);
+	if (!next)
+	{
+		return false;
+	}
+
+	*value = std::move(next->value);
+	delete m_tail;
+	m_tail = next;
+	m_size--;
+	return true;
+}
+
+template <typename T>
+void LockFreeQueue<T>::waitForValue()
+{
+	m_consumerWaiting = true;
+	{
+		std::unique_lock<std::mutex> lock(m_waitMutex);
+		m_waitCondition.wait(lock, [this]() { return m_size > 0 || m_wokenUp; });
+		m_wokenUp = false;
+	}
+	m_consumerWaiting = false;
+}
+
+template <typename T>
+void LockFreeQueue<T>::wakeUp()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_waitMutex);
+		m_wokenUp = true;
+	}
+	m_waitCondition.notify_all();
+}
+
+template <typename T>
+size_t LockFreeQueue<T>::size() const
+{
+	return m_size;
+}
+
+#endif	  // LOCK_FREE_QUEUE_H
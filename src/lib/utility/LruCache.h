@@ -0,0 +1,91 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <list>
+#include <map>
+#include <utility>
+
+// Keeps the values of the most recently used keys. Once more than maxSize values are stored, the
+// value that was not used for the longest time gets dropped. Not thread safe.
+template <typename KeyType, typename ValType>
+class LruCache
+{
+public:
+	LruCache(size_t maxSize);
+
+	// returns false if there is no value for the key, a found value becomes the most recent one
+	bool getValue(const KeyType& key, ValType* value);
+	void setValue(const KeyType& key, const ValType& value);
+
+	size_t size() const;
+	void clear();
+
+private:
+	typedef std::list<std::pair<KeyType, ValType>> EntryList;
+
+	const size_t m_maxSize;
+
+	// ordered from the most to the least recently used entry
+	EntryList m_entries;
+	std::map<KeyType, typename EntryList::iterator> m_entryIterators;
+};
+
+template <typename KeyType, typename ValType>
+LruCache<KeyType, ValType>::LruCache(size_t maxSize): m_maxSize(maxSize)
+{
+}
+
+template <typename KeyType, typename ValType>
+bool LruCache<KeyType, ValType>::getValue(const KeyType& key, ValType* value)
+{
+	auto it = m_entryIterators.find(key);
+	if (it == m_entryIterators.end())
+	{
+		return false;
+	}
+
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	*value = it->second->second;
+	return true;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::setValue(const KeyType& key, const ValType& value)
+{
+	auto it = m_entryIterators.find(key);
+	if (it != m_entryIterators.end())
+	{
+		it->second->second = value;
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return;
+	}
+
+	if (!m_maxSize)
+	{
+		return;
+	}
+
+	if (m_entries.size() >= m_maxSize)
+	{
+		m_entryIterators.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+
+	m_entries.emplace_front(key, value);
+	m_entryIterators.emplace(key, m_entries.begin());
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::size() const
+{
+	return m_entries.size();
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::clear()
+{
+	m_entries.clear();
+	m_entryIterators.clear();
+}
+
+#endif	  // LRU_CACHE_H
@@ -0,0 +1,135 @@
+#include "SmallObjectAllocator.h"
+
+#include <cassert>
+#include <new>
+#include <set>
+#include <vector>
+
+namespace
+{
+const size_t s_granularity = alignof(std::max_align_t);
+const size_t s_maxBlockSize = 256;
+const size_t s_sizeClassCount = s_maxBlockSize / s_granularity;
+const size_t s_chunkSize = 64 * 1024;
+
+class SizeClassPool
+{
+public:
+	SizeClassPool(): m_chunkPosition(nullptr), m_chunkRemaining(0)
+	{
+		for (FreeBlock*& freeList: m_freeLists)
+		{
+			freeList = nullptr;
+		}
+	}
+
+	~SizeClassPool()
+	{
+		for (void* chunk: m_chunks)
+		{
+			::operator delete(chunk);
+		}
+	}
+
+	void* allocate(size_t sizeClass)
+	{
+		FreeBlock*& freeList = m_freeLists[sizeClass];
+		if (freeList)
+		{
+			FreeBlock* block = freeList;
+			freeList = block->next;
+			return block;
+		}
+
+		const size_t blockSize = (sizeClass + 1) * s_granularity;
+		if (m_chunkRemaining < blockSize)
+		{
+			// the rest of the previous chunk is too small for this size class and stays unused
+			m_chunks.push_back(::operator new(s_chunkSize));
+			m_chunkPosition = static_cast<char*>(m_chunks.back());
+			m_chunkRemaining = s_chunkSize;
+#ifndef NDEBUG
+			m_chunkStarts.insert(m_chunkPosition);
+#endif
+		}
+
+		void* block = m_chunkPosition;
+		m_chunkPosition += blockSize;
+		m_chunkRemaining -= blockSize;
+		return block;
+	}
+
+	void deallocate(void* block, size_t sizeClass)
+	{
+		assert(ownsBlock(block) && "block was allocated on another thread");
+
+		FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+		freeBlock->next = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = freeBlock;
+	}
+
+	size_t getReservedSize() const
+	{
+		return m_chunks.size() * s_chunkSize;
+	}
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+#ifndef NDEBUG
+	bool ownsBlock(const void* block) const
+	{
+		// the chunk with the largest start address not behind the block is the only candidate
+		const char* address = static_cast<const char*>(block);
+		std::set<const char*>::const_iterator it = m_chunkStarts.upper_bound(address);
+		return it != m_chunkStarts.begin() && address < *(--it) + s_chunkSize;
+	}
+
+	std::set<const char*> m_chunkStarts;
+#endif
+
+	FreeBlock* m_freeLists[s_sizeClassCount];
+	std::vector<void*> m_chunks;
+	char* m_chunkPosition;
+	size_t m_chunkRemaining;
+};
+
+thread_local SizeClassPool t_pool;
+
+size_t getSizeClass(size_t size)
+{
+	return size ? (size - 1) / s_granularity : 0;
+}
+}	 // namespace
+
+void* SmallObjectAllocator::allocate(size_t size)
+{
+	if (size > s_maxBlockSize)
+	{
+		return ::operator new(size);
+	}
+	return t_pool.allocate(getSizeClass(size));
+}
+
+void SmallObjectAllocator::deallocate(void* block, size_t size)
+{
+	if (!block)
+	{
+		return;
+	}
+
+	if (size > s_maxBlockSize)
+	{
+		::operator delete(block);
+		return;
+	}
+	t_pool.deallocate(block, getSizeClass(size));
+}
+
+size_t SmallObjectAllocator::getReservedSize()
+{
+	return t_pool.getReservedSize();
+}
@@ -0,0 +1,21 @@
+#ifndef SMALL_OBJECT_ALLOCATOR_H
+#define SMALL_OBJECT_ALLOCATOR_H
+
+#include <cstddef>
+
+// Allocates small objects from memory chunks that belong to the calling thread. Freed blocks are
+// kept in a free list of their size class and reused by the next allocation of that size, so short
+// lived objects neither go through the global heap nor contend for its lock while several threads
+// are indexing. Blocks need to be freed on the thread that allocated them, debug builds assert
+// that. Large objects are passed on to the global heap.
+class SmallObjectAllocator
+{
+public:
+	static void* allocate(size_t size);
+	static void deallocate(void* block, size_t size);
+
+	// number of bytes held in chunks by the calling thread
+	static size_t getReservedSize();
+};
+
+#endif	  // SMALL_OBJECT_ALLOCATOR_H
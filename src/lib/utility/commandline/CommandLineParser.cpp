@@ -7,6 +7,8 @@
 
 #include "CommandlineCommandConfig.h"
 #include "CommandlineCommandIndex.h"
+#include "CommandlineCommandMerge.h"
+#include "CommandlineCommandServe.h"
 #include "CommandlineHelper.h"
 #include "ConfigManager.h"
 #include "TextAccess.h"
@@ -29,6 +31,8 @@ CommandLineParser::CommandLineParser(const std::string& version): m_version(vers
 
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandConfig>(this));
 	m_commands.push_back(std::make_unique<commandline::CommandlineCommandIndex>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandMerge>(this));
+	m_commands.push_back(std::make_unique<commandline::CommandlineCommandServe>(this));
 
 	for (auto& command : m_commands)
 	{
@@ -251,4 +255,50 @@ bool CommandLineParser::getShallowIndexingRequested() const
 	return m_shallowIndexingRequested;
 }
 
+const FilePath& CommandLineParser::getTraceFilePath() const
+{
+	return m_traceFilePath;
+}
+
+void CommandLineParser::setTraceFilePath(const FilePath& traceFilePath)
+{
+	m_traceFilePath = traceFilePath;
+}
+
+const FilePath& CommandLineParser::getReportFilePath() const
+{
+	return m_reportFilePath;
+}
+
+void CommandLineParser::setReportFilePath(const FilePath& reportFilePath)
+{
+	m_reportFilePath = reportFilePath;
+}
+
+size_t CommandLineParser::getIndexingShardIndex() const
+{
+	return m_indexingShardIndex;
+}
+
+size_t CommandLineParser::getIndexingShardCount() const
+{
+	return m_indexingShardCount;
+}
+
+void CommandLineParser::setIndexingShard(size_t shardIndex, size_t shardCount)
+{
+	m_indexingShardIndex = shardIndex;
+	m_indexingShardCount = shardCount;
+}
+
+const std::string& CommandLineParser::getQueryServerName() const
+{
+	return m_queryServerName;
+}
+
+void CommandLineParser::setQueryServerName(const std::string& serverName)
+{
+	m_queryServerName = serverName;
+}
+
 }	 // namespace commandline
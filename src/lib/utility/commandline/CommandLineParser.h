@@ -42,6 +42,20 @@ public:
 	RefreshMode getRefreshMode() const;
 	bool getShallowIndexingRequested() const;
 
+	const FilePath& getTraceFilePath() const;
+	void setTraceFilePath(const FilePath& traceFilePath);
+
+	const FilePath& getReportFilePath() const;
+	void setReportFilePath(const FilePath& reportFilePath);
+
+	size_t getIndexingShardIndex() const;
+	size_t getIndexingShardCount() const;
+	void setIndexingShard(size_t shardIndex, size_t shardCount);
+
+	// serve queries on the index of the project instead of indexing it, if not empty
+	const std::string& getQueryServerName() const;
+	void setQueryServerName(const std::string& serverName);
+
 private:
 	void processProjectfile();
 	void printHelp() const;
@@ -54,8 +68,13 @@ private:
 
 	const std::string m_version;
 	FilePath m_projectFile;
+	FilePath m_traceFilePath;
+	FilePath m_reportFilePath;
 	RefreshMode m_refreshMode = REFRESH_UPDATED_FILES;
 	bool m_shallowIndexingRequested = false;
+	size_t m_indexingShardIndex = 0;
+	size_t m_indexingShardCount = 1;
+	std::string m_queryServerName;
 
 	bool m_quit = false;
 	bool m_withoutGUI = false;
@@ -87,12 +87,23 @@ void CommandlineCommandConfig::setup()
 		"use-processes,p",
 		po::value<bool>(),
 		"Enable C/C++ Indexer threads to run in different processes. <true/false>")(
+		"memory-budget,b",
+		po::value<int>(),
+		"Set the memory in MB that indexed data may use while waiting to be stored (0 means "
+		"unlimited)")(
+		"automatic-preambles,a",
+		po::value<bool>(),
+		"Precompile the leading includes that C/C++ source files have in common. <true/false>")(
 		"logging-enabled,l", po::value<bool>(), "Enable file/console logging <true/false>")(
 		"verbose-indexer-logging-enabled,L",
 		po::value<bool>(),
 		"Enable additional log of abstract syntax tree during the indexing. <true/false> WARNINIG "
 		"Slows down "
 		"indexing speed")(
+		"tracing-enabled,T",
+		po::value<bool>(),
+		"Record performance traces and write them to the log directory as Chrome trace JSON "
+		"<true/false>")(
 		"jvm-path,j", po::value<std::string>(), "Path to the location of the jvm library")(
 		"maven-path,m", po::value<std::string>(), "Path to the maven binary")(
 		"jre-system-library-paths,J",
@@ -148,9 +159,12 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 		std::cout << "Sourcetrail Settings:\n"
 				  << "\n  indexer-threads: " << settings->getIndexerThreadCount()
 				  << "\n  use-processes: " << settings->getMultiProcessIndexingEnabled()
+				  << "\n  memory-budget: " << settings->getIndexingMemoryBudget()
+				  << "\n  automatic-preambles: " << settings->getCxxAutomaticPreamblesEnabled()
 				  << "\n  logging-enabled: " << settings->getLoggingEnabled()
 				  << "\n  verbose-indexer-logging-enabled: "
 				  << settings->getVerboseIndexerLoggingEnabled()
+				  << "\n  tracing-enabled: " << settings->getTracingEnabled()
 				  << "\n  jvm-path: " << settings->getJavaPath().str()
 				  << "\n  maven-path: " << settings->getMavenPath().str();
 		printVector("global-header-search-paths", settings->getHeaderSearchPaths());
@@ -167,8 +181,12 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 		"verbose-indexer-logging-enabled",
 		settings,
 		vm);
+	parseAndSetValue(&ApplicationSettings::setTracingEnabled, "tracing-enabled", settings, vm);
 
 	parseAndSetValue(&ApplicationSettings::setIndexerThreadCount, "indexer-threads", settings, vm);
+	parseAndSetValue(&ApplicationSettings::setIndexingMemoryBudget, "memory-budget", settings, vm);
+	parseAndSetValue(
+		&ApplicationSettings::setCxxAutomaticPreamblesEnabled, "automatic-preambles", settings, vm);
 
 	parseAndSetValue(&ApplicationSettings::setMavenPath, "maven-path", settings, vm);
 	parseAndSetValue(&ApplicationSettings::setJavaPath, "jvm-path", settings, vm);
@@ -1,5 +1,6 @@
 #include "CommandlineCommandIndex.h"
 
+#include <cstdlib>
 #include <iostream>
 
 #include "CommandLineParser.h"
@@ -24,6 +25,9 @@ void CommandlineCommandIndex::setup()
 		("incomplete,i", "Also reindex incomplete files (files with errors)")
 		("full,f", "Index full project (omit to only index new/changed files)")
 		("shallow,s", "Build a shallow index is supported by the project")
+		("trace,t", po::value<std::string>(), "Write a performance trace to this file")
+		("report,r", po::value<std::string>(), "Write an indexing report as JSON to this file")
+		("shard", po::value<std::string>(), "Only index part i of n of the source files (i/n)")
 		("project-file", po::value<std::string>(), "Project file to index (.srctrlprj)");
 
 	m_options.add(options);
@@ -68,6 +72,39 @@ CommandlineCommand::ReturnStatus CommandlineCommandIndex::parse(std::vector<std:
 		m_parser->setShallowIndexingRequested();
 	}
 
+	if (vm.count("trace"))
+	{
+		m_parser->setTraceFilePath(FilePath(vm["trace"].as<std::string>()));
+	}
+
+	if (vm.count("report"))
+	{
+		m_parser->setReportFilePath(FilePath(vm["report"].as<std::string>()));
+	}
+
+	if (vm.count("shard"))
+	{
+		const std::string shard = vm["shard"].as<std::string>();
+		const size_t separatorPos = shard.find('/');
+
+		size_t shardNumber = 0;
+		size_t shardCount = 0;
+		if (separatorPos != std::string::npos)
+		{
+			shardNumber = std::strtoul(shard.substr(0, separatorPos).c_str(), nullptr, 10);
+			shardCount = std::strtoul(shard.substr(separatorPos + 1).c_str(), nullptr, 10);
+		}
+
+		if (shardNumber == 0 || shardNumber > shardCount)
+		{
+			std::cerr << "ERROR: Invalid shard \"" << shard << "\", expected i/n with 1 <= i <= n."
+					  << std::endl;
+			return ReturnStatus::CMD_FAILURE;
+		}
+
+		m_parser->setIndexingShard(shardNumber - 1, shardCount);
+	}
+
 	if (vm.count("project-file"))
 	{
 		m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
@@ -0,0 +1,128 @@
+#include "CommandlineCommandMerge.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+#include "CommandlineHelper.h"
+#include "FileSystem.h"
+#include "PersistentStorage.h"
+#include "TimeStamp.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandMerge::CommandlineCommandMerge(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "merge", "Merge index databases of project shards into one database.", parser)
+{
+}
+
+CommandlineCommandMerge::~CommandlineCommandMerge() {}
+
+void CommandlineCommandMerge::setup()
+{
+	po::options_description options("Merge Options");
+	options.add_options()
+		("help,h", "Print this help message")
+		("output,o", po::value<std::string>(), "Database file to write the merged index to")
+		("database-files", po::value<std::vector<std::string>>(), "Shard databases to merge");
+
+	m_options.add(options);
+	m_positional.add("database-files", -1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandMerge::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (!vm.count("output") || !vm.count("database-files"))
+	{
+		std::cerr << "ERROR: An output file and at least one database file are required."
+				  << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	const FilePath outputFilePath = FilePath(vm["output"].as<std::string>()).getAbsolute();
+	const std::vector<FilePath> databaseFilePaths = extractPaths(
+		vm["database-files"].as<std::vector<std::string>>());
+
+	std::string projectSettingsText;
+	for (const FilePath& databaseFilePath: databaseFilePaths)
+	{
+		if (!databaseFilePath.exists() || databaseFilePath.getAbsolute() == outputFilePath)
+		{
+			std::cerr << "ERROR: Database file " << databaseFilePath.str()
+					  << " does not exist or is the output file." << std::endl;
+			return ReturnStatus::CMD_FAILURE;
+		}
+
+		const PersistentStorage storage(databaseFilePath, FilePath());
+		if (storage.isIncompatible())
+		{
+			std::cerr << "ERROR: Database file " << databaseFilePath.str()
+					  << " was indexed with a different version of Sourcetrail." << std::endl;
+			return ReturnStatus::CMD_FAILURE;
+		}
+
+		if (projectSettingsText.empty())
+		{
+			projectSettingsText = storage.getProjectSettingsText();
+		}
+		else if (projectSettingsText != storage.getProjectSettingsText())
+		{
+			std::cout << "WARNING: Database file " << databaseFilePath.str()
+					  << " was indexed with different project settings." << std::endl;
+		}
+	}
+
+	if (outputFilePath.exists())
+	{
+		FileSystem::remove(outputFilePath);
+	}
+
+	{
+		PersistentStorage targetStorage(outputFilePath, FilePath());
+		targetStorage.setup();
+
+		// indices are only built once all shards are merged
+		targetStorage.setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		targetStorage.setProjectSettingsText(projectSettingsText);
+
+		for (const FilePath& databaseFilePath: databaseFilePaths)
+		{
+			const TimeStamp start = TimeStamp::now();
+			targetStorage.injectDatabase(databaseFilePath);
+			std::cout << "Merged " << databaseFilePath.str() << " in "
+					  << TimeStamp::secondsToString(TimeStamp::now().deltaS(start)) << std::endl;
+		}
+
+		targetStorage.updateVersion();
+		targetStorage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+		targetStorage.optimizeMemory();
+	}
+
+	std::cout << "Wrote merged index to " << outputFilePath.str() << std::endl;
+
+	return ReturnStatus::CMD_QUIT;
+}
+
+}	 // namespace commandline
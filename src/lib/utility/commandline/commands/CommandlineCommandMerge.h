@@ -0,0 +1,25 @@
+#ifndef COMMANDLINE_COMMAND_MERGE_H
+#define COMMANDLINE_COMMAND_MERGE_H
+
+#include "CommandlineCommand.h"
+
+namespace commandline
+{
+class CommandlineCommandMerge: public CommandlineCommand
+{
+public:
+	CommandlineCommandMerge(CommandLineParser* parser);
+	virtual ~CommandlineCommandMerge();
+
+	virtual void setup();
+	virtual ReturnStatus parse(std::vector<std::string>& args);
+
+	virtual bool hasHelp() const
+	{
+		return true;
+	}
+};
+
+}	 // namespace commandline
+
+#endif	  // COMMANDLINE_COMMAND_MERGE_H
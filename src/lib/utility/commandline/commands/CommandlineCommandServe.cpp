@@ -0,0 +1,66 @@
+#include "CommandlineCommandServe.h"
+
+#include <iostream>
+
+#include "CommandLineParser.h"
+
+namespace po = boost::program_options;
+
+namespace commandline
+{
+CommandlineCommandServe::CommandlineCommandServe(CommandLineParser* parser)
+	: CommandlineCommand(
+		  "serve", "Answer queries on the index of a project over a local socket.", parser)
+{
+}
+
+CommandlineCommandServe::~CommandlineCommandServe() {}
+
+void CommandlineCommandServe::setup()
+{
+	po::options_description options("Serve Options");
+	options.add_options()
+		("help,h", "Print this help message")
+		("socket,s", po::value<std::string>()->default_value("sourcetrail"),
+			"Name of the local socket to listen on")
+		("project-file", po::value<std::string>(), "Project file to serve (.srctrlprj)");
+
+	m_options.add(options);
+	m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandServe::parse(std::vector<std::string>& args)
+{
+	po::variables_map vm;
+	try
+	{
+		po::store(
+			po::command_line_parser(args).options(m_options).positional(m_positional).run(), vm);
+		po::notify(vm);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << m_options << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	if (vm.count("help") || args.size() == 0 || args[0] == "help")
+	{
+		printHelp();
+		return ReturnStatus::CMD_QUIT;
+	}
+
+	if (!vm.count("project-file"))
+	{
+		std::cerr << "ERROR: A project file is required." << std::endl;
+		return ReturnStatus::CMD_FAILURE;
+	}
+
+	m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
+	m_parser->setQueryServerName(vm["socket"].as<std::string>());
+
+	return ReturnStatus::CMD_OK;
+}
+
+}	 // namespace commandline
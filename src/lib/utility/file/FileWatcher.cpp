@@ -0,0 +1,150 @@
+#include "FileWatcher.h"
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#	include <poll.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+#include "TimeStamp.h"
+#include "logging.h"
+
+bool FileWatcher::isSupported()
+{
+#if !defined(_WIN32) && !defined(__APPLE__)
+	return true;
+#else
+	return false;
+#endif
+}
+
+FileWatcher::FileWatcher(
+	size_t quietPeriodMs, std::function<void(const std::set<FilePath>&)> onFilesChanged)
+	: m_quietPeriodMs(quietPeriodMs)
+	, m_onFilesChanged(onFilesChanged)
+	, m_fileDescriptor(-1)
+	, m_running(false)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+	stop();
+}
+
+bool FileWatcher::start(const std::set<FilePath>& directoryPaths)
+{
+	stop();
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+	m_fileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_fileDescriptor < 0)
+	{
+		LOG_ERROR("Unable to initialize file watcher.");
+		return false;
+	}
+
+	for (const FilePath& directoryPath: directoryPaths)
+	{
+		const int watchDescriptor = inotify_add_watch(
+			m_fileDescriptor,
+			directoryPath.str().c_str(),
+			IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+
+		if (watchDescriptor < 0)
+		{
+			// usually the per user limit of inotify watches has been reached
+			LOG_WARNING("Unable to watch directory: " + directoryPath.str());
+			continue;
+		}
+
+		m_watchedDirectories.emplace(watchDescriptor, directoryPath);
+	}
+
+	if (m_watchedDirectories.empty())
+	{
+		stop();
+		return false;
+	}
+
+	LOG_INFO(
+		"Watching " + std::to_string(m_watchedDirectories.size()) + " directories for changes.");
+
+	m_running = true;
+	m_thread = std::make_unique<std::thread>(&FileWatcher::run, this);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FileWatcher::stop()
+{
+	m_running = false;
+
+	if (m_thread)
+	{
+		m_thread->join();
+		m_thread.reset();
+	}
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+	if (m_fileDescriptor >= 0)
+	{
+		// closing the descriptor also removes all of its watches
+		close(m_fileDescriptor);
+		m_fileDescriptor = -1;
+	}
+#endif
+
+	m_watchedDirectories.clear();
+}
+
+bool FileWatcher::isRunning() const
+{
+	return m_running;
+}
+
+void FileWatcher::run()
+{
+#if !defined(_WIN32) && !defined(__APPLE__)
+	std::set<FilePath> changedFilePaths;
+	TimeStamp lastChange;
+
+	alignas(struct inotify_event) char buffer[4096];
+
+	while (m_running)
+	{
+		pollfd pollDescriptor = {m_fileDescriptor, POLLIN, 0};
+		if (poll(&pollDescriptor, 1, 100) > 0 && (pollDescriptor.revents & POLLIN))
+		{
+			ssize_t length = 0;
+			while ((length = read(m_fileDescriptor, buffer, sizeof(buffer))) > 0)
+			{
+				for (char* it = buffer; it < buffer + length;)
+				{
+					const struct inotify_event* event = reinterpret_cast<struct inotify_event*>(it);
+					it += sizeof(struct inotify_event) + event->len;
+
+					auto directoryIt = m_watchedDirectories.find(event->wd);
+					if (event->len == 0 || directoryIt == m_watchedDirectories.end() ||
+						(event->mask & IN_ISDIR))
+					{
+						continue;
+					}
+
+					changedFilePaths.insert(
+						directoryIt->second.getConcatenated(FilePath(std::string(event->name))));
+					lastChange = TimeStamp::now();
+				}
+			}
+		}
+
+		if (!changedFilePaths.empty() && TimeStamp::now().deltaMS(lastChange) >= m_quietPeriodMs)
+		{
+			m_onFilesChanged(changedFilePaths);
+			changedFilePaths.clear();
+		}
+	}
+#endif
+}
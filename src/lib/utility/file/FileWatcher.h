@@ -0,0 +1,47 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+
+#include "FilePath.h"
+
+// Watches directories for files that get written, created, removed or renamed. Changes are
+// collected until no further change was reported for the quiet period, so saving several files at
+// once or tools rewriting a file in multiple steps result in a single callback. The callback is
+// invoked on the watcher thread. Directories are not watched recursively.
+class FileWatcher
+{
+public:
+	// file watching is currently only available on Linux (inotify)
+	static bool isSupported();
+
+	FileWatcher(
+		size_t quietPeriodMs, std::function<void(const std::set<FilePath>&)> onFilesChanged);
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	bool start(const std::set<FilePath>& directoryPaths);
+	void stop();
+
+	bool isRunning() const;
+
+private:
+	void run();
+
+	const size_t m_quietPeriodMs;
+	std::function<void(const std::set<FilePath>&)> m_onFilesChanged;
+
+	int m_fileDescriptor;
+	std::map<int, FilePath> m_watchedDirectories;
+	std::atomic<bool> m_running;
+	std::unique_ptr<std::thread> m_thread;
+};
+
+#endif	  // FILE_WATCHER_H
@@ -11,14 +11,9 @@ template <typename MessageType>
 class MessageListener: public MessageListenerBase
 {
 public:
-	MessageListener() {}
+	MessageListener(): MessageListenerBase(MessageType::getStaticType()) {}
 
 private:
-	virtual std::string doGetType() const
-	{
-		return MessageType::getStaticType();
-	}
-
 	virtual void doHandleMessageBase(MessageBase* message)
 	{
 		// if (message->isLogged())
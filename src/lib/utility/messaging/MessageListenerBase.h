@@ -10,7 +10,8 @@
 class MessageListenerBase
 {
 public:
-	MessageListenerBase(): m_id(s_nextId++), m_alive(true)
+	// the type is known up front, so the queue can file the listener by it on registration
+	MessageListenerBase(const std::string& type): m_id(s_nextId++), m_type(type), m_alive(true)
 	{
 		MessageQueue::getInstance()->registerListener(this);
 	}
@@ -19,8 +20,9 @@ public:
 	{
 		if (m_alive)
 		{
-			m_alive = false;
+			// unregistering needs the type, which is only reported while alive
 			MessageQueue::getInstance()->unregisterListener(this);
+			m_alive = false;
 		}
 	}
 
@@ -33,7 +35,7 @@ public:
 	{
 		if (m_alive)
 		{
-			return doGetType();
+			return m_type;
 		}
 		return "";
 	}
@@ -57,12 +59,12 @@ public:
 	}
 
 private:
-	virtual std::string doGetType() const = 0;
 	virtual void doHandleMessageBase(MessageBase*) = 0;
 
 	static Id s_nextId;
 
 	Id m_id;
+	const std::string m_type;
 	bool m_alive;
 };
 
@@ -1,5 +1,6 @@
 #include "MessageQueue.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -24,41 +25,59 @@ std::shared_ptr<MessageQueue> MessageQueue::getInstance()
 MessageQueue::~MessageQueue()
 {
 	std::lock_guard<std::mutex> lock(m_listenersMutex);
-	for (size_t i = 0; i < m_listeners.size(); i++)
+	for (const auto& p: m_listenersById)
 	{
-		m_listeners[i]->removedListener();
+		p.second->removedListener();
 	}
 	m_listeners.clear();
+	m_listenersById.clear();
 }
 
 void MessageQueue::registerListener(MessageListenerBase* listener)
 {
 	std::lock_guard<std::mutex> lock(m_listenersMutex);
-	m_listeners.push_back(listener);
+	m_listeners[listener->getType()].push_back(listener);
+	m_listenersById[listener->getId()] = listener;
 }
 
 void MessageQueue::unregisterListener(MessageListenerBase* listener)
 {
 	std::lock_guard<std::mutex> lock(m_listenersMutex);
-	for (size_t i = 0; i < m_listeners.size(); i++)
+	m_listenersById.erase(listener->getId());
+
+	// entries are never erased, the vector of the current message must stay valid
+	auto it = m_listeners.find(listener->getType());
+	if (it != m_listeners.end())
 	{
-		if (m_listeners[i] == listener)
+		std::vector<MessageListenerBase*>& listeners = it->second;
+		for (size_t i = 0; i < listeners.size(); i++)
 		{
-			m_listeners.erase(m_listeners.begin() + i);
-
-			// m_currentListenerIndex and m_listenersLength need to be updated in case this happens
-			// while a message is handled.
-			if (i <= m_currentListenerIndex)
+			if (listeners[i] == listener)
 			{
-				m_currentListenerIndex--;
-			}
+				listeners.erase(listeners.begin() + i);
 
-			if (i < m_listenersLength)
-			{
-				m_listenersLength--;
-			}
+				// index and length of iterations need to be updated in case this happens while a
+				// message of the same type is handled.
+				for (ListenerIteration* iteration: m_listenerIterations)
+				{
+					if (iteration->listeners != &listeners)
+					{
+						continue;
+					}
 
-			return;
+					if (i <= iteration->index)
+					{
+						iteration->index--;
+					}
+
+					if (i < iteration->length)
+					{
+						iteration->length--;
+					}
+				}
+
+				return;
+			}
 		}
 	}
 
@@ -68,12 +87,10 @@ void MessageQueue::unregisterListener(MessageListenerBase* listener)
 MessageListenerBase* MessageQueue::getListenerById(Id listenerId) const
 {
 	std::lock_guard<std::mutex> lock(m_listenersMutex);
-	for (size_t i = 0; i < m_listeners.size(); i++)
+	auto it = m_listenersById.find(listenerId);
+	if (it != m_listenersById.end())
 	{
-		if (m_listeners[i]->getId() == listenerId)
-		{
-			return m_listeners[i];
-		}
+		return it->second;
 	}
 	return nullptr;
 }
@@ -85,8 +102,8 @@ void MessageQueue::addMessageFilter(std::shared_ptr<MessageFilter> filter)
 
 void MessageQueue::pushMessage(std::shared_ptr<MessageBase> message)
 {
-	std::lock_guard<std::mutex> lock(m_messageBufferMutex);
-	m_messageBuffer.push_back(message);
+	m_queuedMessageCount++;
+	m_messageQueue.push(message);
 }
 
 void MessageQueue::processMessage(std::shared_ptr<MessageBase> message, bool asNextTask)
@@ -141,7 +158,7 @@ void MessageQueue::startMessageLoop()
 			}
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(25));
+		m_messageQueue.waitForValue();
 	}
 
 	{
@@ -166,6 +183,8 @@ void MessageQueue::stopMessageLoop()
 		m_loopIsRunning = false;
 	}
 
+	m_messageQueue.wakeUp();
+
 	while (true)
 	{
 		{
@@ -188,8 +207,7 @@ bool MessageQueue::loopIsRunning() const
 
 bool MessageQueue::hasMessagesQueued() const
 {
-	std::lock_guard<std::mutex> lock(m_messageBufferMutex);
-	return m_messageBuffer.size() > 0;
+	return m_queuedMessageCount > 0;
 }
 
 void MessageQueue::setSendMessagesAsTasks(bool sendMessagesAsTasks)
@@ -200,8 +218,7 @@ void MessageQueue::setSendMessagesAsTasks(bool sendMessagesAsTasks)
 std::shared_ptr<MessageQueue> MessageQueue::s_instance;
 
 MessageQueue::MessageQueue()
-	: m_currentListenerIndex(0)
-	, m_listenersLength(0)
+	: m_queuedMessageCount(0)
 	, m_loopIsRunning(false)
 	, m_threadIsRunning(false)
 	, m_sendMessagesAsTasks(false)
@@ -213,28 +230,32 @@ void MessageQueue::processMessages()
 	while (true)
 	{
 		std::shared_ptr<MessageBase> message;
+		while (m_messageQueue.pop(&message))
 		{
-			std::lock_guard<std::mutex> lock(m_messageBufferMutex);
-
-			for (std::shared_ptr<MessageFilter> filter: m_filters)
-			{
-				if (!m_messageBuffer.size())
-				{
-					break;
-				}
-
-				filter->filter(&m_messageBuffer);
-			}
+			m_messageBuffer.push_back(message);
+		}
 
+		for (std::shared_ptr<MessageFilter> filter: m_filters)
+		{
 			if (!m_messageBuffer.size())
 			{
 				break;
 			}
 
-			message = m_messageBuffer.front();
-			m_messageBuffer.pop_front();
+			const size_t messageCount = m_messageBuffer.size();
+			filter->filter(&m_messageBuffer);
+			m_queuedMessageCount -= messageCount - m_messageBuffer.size();
+		}
+
+		if (!m_messageBuffer.size())
+		{
+			break;
 		}
 
+		message = m_messageBuffer.front();
+		m_messageBuffer.pop_front();
+		m_queuedMessageCount--;
+
 		processMessage(message, false);
 	}
 }
@@ -243,20 +264,25 @@ void MessageQueue::sendMessage(std::shared_ptr<MessageBase> message)
 {
 	std::lock_guard<std::mutex> lock(m_listenersMutex);
 
-	// m_listenersLength is saved, so that new listeners registered whithin message handling don't
-	// get the current message and the length can be reduced when a listener gets unregistered.
-	m_listenersLength = m_listeners.size();
+	auto it = m_listeners.find(message->getType());
+	if (it == m_listeners.end())
+	{
+		return;
+	}
 
-	// The currentListenerIndex holds the index of the current listener being handled, so it can be
-	// changed when a listener gets removed while message handling.
-	for (m_currentListenerIndex = 0; m_currentListenerIndex < m_listenersLength;
-		 m_currentListenerIndex++)
+	// The length is saved, so that new listeners registered whithin message handling don't get the
+	// current message and the length can be reduced when a listener gets unregistered. The index
+	// holds the current listener being handled, so it can be changed when a listener gets removed
+	// while message handling.
+	ListenerIteration iteration = {&it->second, 0, it->second.size()};
+	m_listenerIterations.push_back(&iteration);
+
+	for (; iteration.index < iteration.length; iteration.index++)
 	{
-		MessageListenerBase* listener = m_listeners[m_currentListenerIndex];
+		MessageListenerBase* listener = (*iteration.listeners)[iteration.index];
 
-		if (listener->getType() == message->getType() &&
-			(message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
-			 listener->getSchedulerId() == message->getSchedulerId()))
+		if (message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
+			listener->getSchedulerId() == message->getSchedulerId())
 		{
 			// The listenersMutex gets unlocked so changes to listeners are possible while message handling.
 			m_listenersMutex.unlock();
@@ -264,6 +290,9 @@ void MessageQueue::sendMessage(std::shared_ptr<MessageBase> message)
 			m_listenersMutex.lock();
 		}
 	}
+
+	m_listenerIterations.erase(
+		std::find(m_listenerIterations.begin(), m_listenerIterations.end(), &iteration));
 }
 
 void MessageQueue::sendMessageAsTask(std::shared_ptr<MessageBase> message, bool asNextTask) const
@@ -280,23 +309,24 @@ void MessageQueue::sendMessageAsTask(std::shared_ptr<MessageBase> message, bool
 
 	{
 		std::lock_guard<std::mutex> lock(m_listenersMutex);
-		for (size_t i = 0; i < m_listeners.size(); i++)
+		auto it = m_listeners.find(message->getType());
+		if (it != m_listeners.end())
 		{
-			MessageListenerBase* listener = m_listeners[i];
-
-			if (listener->getType() == message->getType() &&
-				(message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
-				 listener->getSchedulerId() == message->getSchedulerId()))
+			for (MessageListenerBase* listener: it->second)
 			{
-				Id listenerId = listener->getId();
-				taskGroup->addTask(std::make_shared<TaskLambda>([listenerId, message]() {
-					MessageListenerBase* listener = MessageQueue::getInstance()->getListenerById(
-						listenerId);
-					if (listener)
-					{
-						listener->handleMessageBase(message.get());
-					}
-				}));
+				if (message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
+					listener->getSchedulerId() == message->getSchedulerId())
+				{
+					Id listenerId = listener->getId();
+					taskGroup->addTask(std::make_shared<TaskLambda>([listenerId, message]() {
+						MessageListenerBase* listener =
+							MessageQueue::getInstance()->getListenerById(listenerId);
+						if (listener)
+						{
+							listener->handleMessageBase(message.get());
+						}
+					}));
+				}
 			}
 		}
 	}
@@ -1,11 +1,15 @@
 #ifndef MESSAGE_QUEUE_H
 #define MESSAGE_QUEUE_H
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "LockFreeQueue.h"
 #include "types.h"
 
 class MessageBase;
@@ -51,17 +55,31 @@ private:
 	void sendMessage(std::shared_ptr<MessageBase> message);
 	void sendMessageAsTask(std::shared_ptr<MessageBase> message, bool asNextTask) const;
 
+	// messages get pushed from any thread and are moved to the buffer by the loop thread, which
+	// is the only one that filters the buffer
+	LockFreeQueue<std::shared_ptr<MessageBase>> m_messageQueue;
 	MessageBufferType m_messageBuffer;
-	std::vector<MessageListenerBase*> m_listeners;
+	std::atomic<size_t> m_queuedMessageCount;
+
 	std::vector<std::shared_ptr<MessageFilter>> m_filters;
 
-	size_t m_currentListenerIndex;
-	size_t m_listenersLength;
+	// listeners by message type, in order of registration
+	std::unordered_map<std::string, std::vector<MessageListenerBase*>> m_listeners;
+	std::unordered_map<Id, MessageListenerBase*> m_listenersById;
+
+	// Listener lists currently walked by sendMessage. Messages can be sent while handling another
+	// message, so there may be several of them.
+	struct ListenerIteration
+	{
+		const std::vector<MessageListenerBase*>* listeners;
+		size_t index;
+		size_t length;
+	};
+	std::vector<ListenerIteration*> m_listenerIterations;
 
 	bool m_loopIsRunning;
 	bool m_threadIsRunning;
 
-	mutable std::mutex m_messageBufferMutex;
 	mutable std::mutex m_listenersMutex;
 	mutable std::mutex m_loopMutex;
 	mutable std::mutex m_threadMutex;
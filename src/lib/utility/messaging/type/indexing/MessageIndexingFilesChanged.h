@@ -0,0 +1,27 @@
+#ifndef MESSAGE_INDEXING_FILES_CHANGED_H
+#define MESSAGE_INDEXING_FILES_CHANGED_H
+
+#include <set>
+
+#include "FilePath.h"
+#include "Message.h"
+
+class MessageIndexingFilesChanged: public Message<MessageIndexingFilesChanged>
+{
+public:
+	static const std::string getStaticType()
+	{
+		return "MessageIndexingFilesChanged";
+	}
+
+	MessageIndexingFilesChanged(const std::set<FilePath>& filePaths): filePaths(filePaths) {}
+
+	void print(std::wostream& os) const override
+	{
+		os << filePaths.size() << L" files";
+	}
+
+	const std::set<FilePath> filePaths;
+};
+
+#endif	  // MESSAGE_INDEXING_FILES_CHANGED_H
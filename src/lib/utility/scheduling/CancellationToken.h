@@ -0,0 +1,27 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic>
+
+// Shared between the code that starts jobs and the jobs themselves. Pending jobs of a cancelled
+// token are skipped by the ThreadPool, running jobs may poll isCancelled() to stop early.
+class CancellationToken
+{
+public:
+	CancellationToken(): m_cancelled(false) {}
+
+	void cancel()
+	{
+		m_cancelled = true;
+	}
+
+	bool isCancelled() const
+	{
+		return m_cancelled;
+	}
+
+private:
+	std::atomic<bool> m_cancelled;
+};
+
+#endif	  // CANCELLATION_TOKEN_H
@@ -0,0 +1,202 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#include "CancellationToken.h"
+#include "utilityApp.h"
+
+namespace
+{
+// identifies the pool and queue of the worker running on the current thread
+thread_local const ThreadPool* t_currentPool = nullptr;
+thread_local size_t t_currentWorkerIndex = 0;
+}	 // namespace
+
+ThreadPool* ThreadPool::getInstance()
+{
+	static ThreadPool s_instance(std::max(1, utility::getIdealThreadCount()));
+	return &s_instance;
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+	: m_nextWorkerIndex(0), m_pendingJobCount(0), m_stopped(false)
+{
+	for (size_t i = 0; i < std::max<size_t>(1, threadCount); i++)
+	{
+		m_workers.push_back(std::make_unique<Worker>());
+	}
+
+	// all queues need to exist before the first worker starts stealing
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i]->thread = std::thread(&ThreadPool::runWorker, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopped = true;
+	}
+	m_sleepCondition.notify_all();
+
+	for (std::unique_ptr<Worker>& worker: m_workers)
+	{
+		worker->thread.join();
+	}
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+	return m_workers.size();
+}
+
+void ThreadPool::execute(
+	std::function<void()> job, Priority priority, std::shared_ptr<CancellationToken> token)
+{
+	// jobs posted by a worker stay on its queue, where they are likely to find warm caches
+	const size_t workerIndex = t_currentPool == this ? t_currentWorkerIndex
+													 : m_nextWorkerIndex++ % m_workers.size();
+	{
+		Worker& worker = *m_workers[workerIndex];
+		std::lock_guard<std::mutex> lock(worker.queueMutex);
+		worker.queues[priority].push_back({std::move(job), token});
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_pendingJobCount++;
+	}
+	m_sleepCondition.notify_one();
+}
+
+void ThreadPool::forEachIndex(
+	size_t count,
+	std::function<void(size_t)> function,
+	Priority priority,
+	std::shared_ptr<CancellationToken> token)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	struct State
+	{
+		std::function<void(size_t)> function;
+		std::shared_ptr<CancellationToken> token;
+		size_t count;
+		std::atomic<size_t> nextIndex;
+		std::atomic<size_t> runningCount;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+
+	std::shared_ptr<State> state = std::make_shared<State>();
+	state->function = std::move(function);
+	state->token = token;
+	state->count = count;
+	state->nextIndex = 0;
+	state->runningCount = 0;
+
+	// runners that start after all indices were handed out return without touching the function,
+	// so only the running ones need to be waited for
+	std::function<void()> runner = [state]() {
+		state->runningCount++;
+		while (!state->token || !state->token->isCancelled())
+		{
+			const size_t index = state->nextIndex++;
+			if (index >= state->count)
+			{
+				break;
+			}
+			state->function(index);
+		}
+
+		if (--state->runningCount == 0)
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->finished.notify_all();
+		}
+	};
+
+	for (size_t i = 0; i < std::min(count - 1, m_workers.size()); i++)
+	{
+		execute(runner, priority);
+	}
+
+	runner();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state]() { return state->runningCount == 0; });
+}
+
+void ThreadPool::runWorker(size_t workerIndex)
+{
+	t_currentPool = this;
+	t_currentWorkerIndex = workerIndex;
+
+	while (true)
+	{
+		if (runPendingJob())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		if (m_stopped)
+		{
+			return;
+		}
+		m_sleepCondition.wait(lock, [this]() { return m_pendingJobCount > 0 || m_stopped; });
+	}
+}
+
+bool ThreadPool::runPendingJob()
+{
+	Job job;
+	if (!popJob(t_currentPool == this ? t_currentWorkerIndex : m_workers.size(), &job))
+	{
+		return false;
+	}
+
+	if (!job.token || !job.token->isCancelled())
+	{
+		job.function();
+	}
+	return true;
+}
+
+bool ThreadPool::popJob(size_t workerIndex, Job* job)
+{
+	for (size_t priority = 0; priority < s_priorityCount; priority++)
+	{
+		// newest job of the own queue first, then the oldest job of the other workers
+		if (workerIndex < m_workers.size())
+		{
+			Worker& worker = *m_workers[workerIndex];
+			std::lock_guard<std::mutex> lock(worker.queueMutex);
+			if (!worker.queues[priority].empty())
+			{
+				*job = std::move(worker.queues[priority].back());
+				worker.queues[priority].pop_back();
+				m_pendingJobCount--;
+				return true;
+			}
+		}
+
+		for (size_t i = 1; i <= m_workers.size(); i++)
+		{
+			Worker& worker = *m_workers[(workerIndex + i) % m_workers.size()];
+			std::lock_guard<std::mutex> lock(worker.queueMutex);
+			if (!worker.queues[priority].empty())
+			{
+				*job = std::move(worker.queues[priority].front());
+				worker.queues[priority].pop_front();
+				m_pendingJobCount--;
+				return true;
+			}
+		}
+	}
+	return false;
+}
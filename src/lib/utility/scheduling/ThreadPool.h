@@ -0,0 +1,98 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CancellationToken;
+
+// Process wide pool of worker threads for short jobs. Every worker owns a queue per priority, takes
+// its own jobs newest first and steals the oldest jobs of other workers when it runs dry. Threads
+// that wait for jobs help running them, so jobs can fan out into further jobs without exhausting
+// the pool. Loops that run for the lifetime of a task keep their own threads instead.
+class ThreadPool
+{
+public:
+	enum Priority
+	{
+		PRIORITY_HIGH = 0,
+		PRIORITY_NORMAL,
+		PRIORITY_LOW
+	};
+
+	static ThreadPool* getInstance();
+
+	ThreadPool(size_t threadCount);
+	~ThreadPool();
+
+	size_t getThreadCount() const;
+
+	// runs the job asynchronously, it is skipped if the token gets cancelled before it starts
+	void execute(
+		std::function<void()> job,
+		Priority priority = PRIORITY_NORMAL,
+		std::shared_ptr<CancellationToken> token = std::shared_ptr<CancellationToken>());
+
+	// calls the function for every index below count and returns once all calls finished. Indices
+	// are handed out one by one to the workers and the calling thread, which balances uneven
+	// work per index. Indices not yet started are skipped once the token gets cancelled.
+	void forEachIndex(
+		size_t count,
+		std::function<void(size_t)> function,
+		Priority priority = PRIORITY_NORMAL,
+		std::shared_ptr<CancellationToken> token = std::shared_ptr<CancellationToken>());
+
+	template <typename T>
+	void forEach(
+		const std::vector<T>& values,
+		std::function<void(const T&)> function,
+		Priority priority = PRIORITY_NORMAL,
+		std::shared_ptr<CancellationToken> token = std::shared_ptr<CancellationToken>());
+
+private:
+	struct Job
+	{
+		std::function<void()> function;
+		std::shared_ptr<CancellationToken> token;
+	};
+
+	static const size_t s_priorityCount = PRIORITY_LOW + 1;
+
+	struct Worker
+	{
+		std::thread thread;
+		std::mutex queueMutex;
+		std::deque<Job> queues[s_priorityCount];
+	};
+
+	void runWorker(size_t workerIndex);
+	bool runPendingJob();
+	bool popJob(size_t workerIndex, Job* job);
+
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::atomic<size_t> m_nextWorkerIndex;
+
+	std::atomic<size_t> m_pendingJobCount;
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	bool m_stopped;
+};
+
+template <typename T>
+void ThreadPool::forEach(
+	const std::vector<T>& values,
+	std::function<void(const T&)> function,
+	Priority priority,
+	std::shared_ptr<CancellationToken> token)
+{
+	forEachIndex(
+		values.size(), [&values, &function](size_t i) { function(values[i]); }, priority, token);
+}
+
+#endif	  // THREAD_POOL_H
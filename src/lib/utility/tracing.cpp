@@ -1,135 +1,226 @@
 #include "tracing.h"
 
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
 #include <set>
 
-std::shared_ptr<Tracer> Tracer::s_instance;
-Id Tracer::s_nextTraceId = 0;
+#include "logging.h"
+#include "utility.h"
 
-Tracer* Tracer::getInstance()
+namespace
 {
-	if (!s_instance)
-	{
-		s_instance = std::shared_ptr<Tracer>(new Tracer());
-	}
+std::string getFileName(const char* filePath)
+{
+	const std::string path(filePath);
+	const size_t pos = path.find_last_of("/\\");
+	return pos == std::string::npos ? path : path.substr(pos + 1);
+}
 
-	return s_instance.get();
+std::string getEventName(const TraceEvent& event)
+{
+	return std::string(event.eventName).empty() ? std::string(event.functionName)
+												: std::string(event.eventName);
 }
 
-std::shared_ptr<TraceEvent> Tracer::startEvent(const std::string& eventName)
+std::string escapeJson(const std::string& str)
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
+	std::string escaped;
+	escaped.reserve(str.size());
+	for (const char c: str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			escaped.push_back('\\');
+			escaped.push_back(c);
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			escaped.push_back(' ');
+		}
+		else
+		{
+			escaped.push_back(c);
+		}
+	}
+	return escaped;
+}
 
-	const std::thread::id id = std::this_thread::get_id();
+const std::string s_traceFileHeader = "{\"traceEvents\":[";
+const std::string s_traceFileFooter = "],\"displayTimeUnit\":\"ms\"}";
+}	 // namespace
 
-	std::shared_ptr<TraceEvent> event = std::make_shared<TraceEvent>(
-		eventName, s_nextTraceId++, m_startedEvents[id].size());
+std::atomic<bool> Tracer::s_enabled(false);
+const size_t Tracer::s_threadBufferSize = 1 << 14;
 
-	m_events[id].push_back(event);
-	m_startedEvents[id].push(event.get());
+Tracer* Tracer::getInstance()
+{
+	static Tracer s_instance;
+	return &s_instance;
+}
 
-	return event;
+long long Tracer::getMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
 }
 
-void Tracer::finishEvent(std::shared_ptr<TraceEvent> event)
+void Tracer::setEnabled(bool enabled)
+{
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setProcess(int processId, const std::string& processName)
 {
 	std::lock_guard<std::mutex> lock(m_mutex);
+	m_processId = processId;
+	m_processName = processName;
+}
+
+void Tracer::recordEvent(const TraceEvent& event)
+{
+	ThreadBuffer* buffer = getThreadBuffer();
 
-	const std::thread::id id = std::this_thread::get_id();
+	// only the owning thread writes to the buffer, readers may copy a slot while it gets
+	// overwritten and use its sequence number to drop such events afterwards
+	const size_t eventCount = buffer->eventCount.load(std::memory_order_relaxed);
+	EventSlot& slot = buffer->slots[eventCount % s_threadBufferSize];
 
-	m_startedEvents[id].pop();
+	slot.sequence.store(2 * eventCount + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.store(event);
+	slot.sequence.store(2 * (eventCount + 1), std::memory_order_release);
+
+	buffer->eventCount.store(eventCount + 1, std::memory_order_release);
 }
 
-void Tracer::printTraces()
+bool Tracer::importTrace(const FilePath& traceFilePath)
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
-
-	size_t unfinishEvents = 0;
-	for (auto& p: m_startedEvents)
+	std::ifstream traceFile(traceFilePath.str());
+	if (traceFile.fail())
 	{
-		unfinishEvents += p.second.size();
+		LOG_ERROR(L"Could not open trace file " + traceFilePath.wstr());
+		return false;
 	}
 
-	if (unfinishEvents > 0)
+	std::vector<std::string> events;
+	std::string line;
+	while (std::getline(traceFile, line))
 	{
-		std::cout << "TRACING: Trace events are still running." << std::endl;
-		return;
-	}
-	else if (m_events.empty())
-	{
-		std::cout << "TRACING: No trace events collected." << std::endl;
-		return;
-	}
+		if (!line.empty() && line.back() == ',')
+		{
+			line.pop_back();
+		}
 
+		if (!line.empty() && line.front() == '{' && line != s_traceFileHeader)
+		{
+			events.push_back(line);
+		}
+	}
 
-	std::cout << "TRACING\n--------------------------\n" << std::endl;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	utility::append(m_importedEvents, events);
+	return true;
+}
 
-	std::cout << "HISTORY:\n\n";
-	std::cout << "    time                 name                     function";
-	std::cout << "                                          location\n";
-	std::cout << "-----------------------------------------------------------------";
-	std::cout << "------------------------------------------------------------\n";
+bool Tracer::exportTrace(const FilePath& traceFilePath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
 
-	for (auto& p: m_events)
+	std::ofstream traceFile(traceFilePath.str());
+	if (traceFile.fail())
 	{
-		std::cout << "thread: " << p.first << std::endl;
-
-		for (const std::shared_ptr<TraceEvent>& event: p.second)
-		{
-			std::cout.width(8 + 2 * event->depth);
-			std::cout << std::right << std::setprecision(3) << std::fixed << event->time;
-
-			std::cout.width(17 - 2 * event->depth);
-			std::cout << " ";
+		LOG_ERROR(L"Could not write trace file " + traceFilePath.wstr());
+		return false;
+	}
 
-			std::cout.width(25);
-			std::cout << std::left << event->eventName;
+	// every event is written to its own line, which is what importTrace relies on
+	traceFile << s_traceFileHeader << '\n';
+	traceFile << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << m_processId
+			  << ",\"tid\":0,\"args\":{\"name\":\"" << escapeJson(m_processName) << "\"}}";
 
-			std::cout.width(50);
-			std::cout << (event->functionName + "()") << event->locationName << std::endl;
+	for (const std::shared_ptr<ThreadBuffer>& buffer: m_threadBuffers)
+	{
+		for (const TraceEvent& event: getEvents(*buffer))
+		{
+			traceFile << ",\n{\"name\":\"" << escapeJson(getEventName(event))
+					  << "\",\"cat\":\"sourcetrail\",\"ph\":\"X\""
+					  << ",\"ts\":" << event.startMicroseconds
+					  << ",\"dur\":" << event.durationMicroseconds << ",\"pid\":" << m_processId
+					  << ",\"tid\":" << buffer->threadId << ",\"args\":{\"function\":\""
+					  << escapeJson(event.functionName) << "\",\"location\":\""
+					  << escapeJson(getFileName(event.fileName)) << ':' << event.lineNumber
+					  << "\"}}";
 		}
+	}
 
-		std::cout << std::endl;
+	for (const std::string& event: m_importedEvents)
+	{
+		traceFile << ",\n" << event;
 	}
 
-	std::cout << "\nREPORT:\n\n";
-	std::cout << "    time      count      name                     function";
-	std::cout << "                                          location\n";
-	std::cout << "-----------------------------------------------------------------";
-	std::cout << "------------------------------------------------------------\n";
+	traceFile << '\n' << s_traceFileFooter << std::endl;
+
+	LOG_INFO(L"Wrote trace file " + traceFilePath.wstr());
+	return true;
+}
 
+void Tracer::printTraces()
+{
 	struct AccumulatedTraceEvent
 	{
-		TraceEvent* event;
+		TraceEvent event;
 		size_t count;
-		float time;
+		long long time;
 	};
 
 	std::map<std::string, AccumulatedTraceEvent> accumulatedEvents;
-
-	for (auto& p: m_events)
 	{
-		for (const std::shared_ptr<TraceEvent>& event: p.second)
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const std::shared_ptr<ThreadBuffer>& buffer: m_threadBuffers)
 		{
-			const std::string name = event->eventName + event->functionName + event->locationName;
-
-			std::pair<std::map<std::string, AccumulatedTraceEvent>::iterator, bool> p =
-				accumulatedEvents.emplace(name, AccumulatedTraceEvent());
-
-			AccumulatedTraceEvent* acc = &p.first->second;
-			if (p.second)
+			for (const TraceEvent& event: getEvents(*buffer))
 			{
-				acc->event = event.get();
-				acc->time = event->time;
-				acc->count = 1;
-			}
-			else
-			{
-				acc->time += event->time;
-				acc->count++;
+				const std::string name = getEventName(event) + event.fileName +
+					std::to_string(event.lineNumber);
+
+				std::pair<std::map<std::string, AccumulatedTraceEvent>::iterator, bool> p =
+					accumulatedEvents.emplace(name, AccumulatedTraceEvent());
+
+				AccumulatedTraceEvent* acc = &p.first->second;
+				if (p.second)
+				{
+					acc->event = event;
+					acc->time = event.durationMicroseconds;
+					acc->count = 1;
+				}
+				else
+				{
+					acc->time += event.durationMicroseconds;
+					acc->count++;
+				}
 			}
 		}
 	}
 
+	if (accumulatedEvents.empty())
+	{
+		std::cout << "TRACING: No trace events collected." << std::endl;
+		return;
+	}
+
+	std::cout << "TRACING\n--------------------------\n" << std::endl;
+
+	std::cout << "REPORT:\n\n";
+	std::cout << "    time      count      name                     function";
+	std::cout << "                                          location\n";
+	std::cout << "-----------------------------------------------------------------";
+	std::cout << "------------------------------------------------------------\n";
+
 	std::multiset<
 		AccumulatedTraceEvent,
 		std::function<bool(const AccumulatedTraceEvent&, const AccumulatedTraceEvent&)>>
@@ -145,128 +236,125 @@ void Tracer::printTraces()
 	for (const AccumulatedTraceEvent& acc: sortedEvents)
 	{
 		std::cout.width(8);
-		std::cout << std::right << std::setprecision(3) << std::fixed << acc.time;
+		std::cout << std::right << std::setprecision(3) << std::fixed << acc.time / 1000000.0;
 
 		std::cout.width(10);
 		std::cout << acc.count << "       ";
 
 		std::cout.width(25);
-		std::cout << std::left << acc.event->eventName;
+		std::cout << std::left << getEventName(acc.event);
 
 		std::cout.width(50);
-		std::cout << (acc.event->functionName + "()") << acc.event->locationName << std::endl;
+		std::cout << (std::string(acc.event.functionName) + "()")
+				  << getFileName(acc.event.fileName) << ':' << acc.event.lineNumber << std::endl;
 	}
 
 	std::cout << std::endl;
-
-	m_events.clear();
 }
 
-Tracer::Tracer() {}
-
-
-std::shared_ptr<AccumulatingTracer> AccumulatingTracer::s_instance;
-Id AccumulatingTracer::s_nextTraceId = 0;
-
-AccumulatingTracer* AccumulatingTracer::getInstance()
+Tracer::EventSlot::EventSlot()
+	: eventName("")
+	, functionName("")
+	, fileName("")
+	, lineNumber(0)
+	, depth(0)
+	, startMicroseconds(0)
+	, durationMicroseconds(0)
+	, sequence(0)
 {
-	if (!s_instance)
-	{
-		s_instance = std::shared_ptr<AccumulatingTracer>(new AccumulatingTracer());
-	}
-
-	return s_instance.get();
 }
 
-std::shared_ptr<TraceEvent> AccumulatingTracer::startEvent(const std::string& eventName)
+void Tracer::EventSlot::store(const TraceEvent& event)
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
-
-	const std::thread::id id = std::this_thread::get_id();
-
-	std::shared_ptr<TraceEvent> event = std::make_shared<TraceEvent>(
-		eventName, s_nextTraceId++, m_startedEvents[id].size());
-
-	m_startedEvents[id].push(event.get());
+	eventName.store(event.eventName, std::memory_order_relaxed);
+	functionName.store(event.functionName, std::memory_order_relaxed);
+	fileName.store(event.fileName, std::memory_order_relaxed);
+	lineNumber.store(event.lineNumber, std::memory_order_relaxed);
+	depth.store(event.depth, std::memory_order_relaxed);
+	startMicroseconds.store(event.startMicroseconds, std::memory_order_relaxed);
+	durationMicroseconds.store(event.durationMicroseconds, std::memory_order_relaxed);
+}
 
+TraceEvent Tracer::EventSlot::load() const
+{
+	TraceEvent event;
+	event.eventName = eventName.load(std::memory_order_relaxed);
+	event.functionName = functionName.load(std::memory_order_relaxed);
+	event.fileName = fileName.load(std::memory_order_relaxed);
+	event.lineNumber = lineNumber.load(std::memory_order_relaxed);
+	event.depth = depth.load(std::memory_order_relaxed);
+	event.startMicroseconds = startMicroseconds.load(std::memory_order_relaxed);
+	event.durationMicroseconds = durationMicroseconds.load(std::memory_order_relaxed);
 	return event;
 }
 
-void AccumulatingTracer::finishEvent(std::shared_ptr<TraceEvent> event)
+Tracer::ThreadBuffer::ThreadBuffer(size_t threadId)
+	: threadId(threadId), slots(s_threadBufferSize), eventCount(0)
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
-
-	const std::thread::id id = std::this_thread::get_id();
-
-	m_startedEvents[id].pop();
-
-	const std::string name = event->eventName + event->functionName + event->locationName;
-
-	std::pair<std::map<std::string, AccumulatedTraceEvent>::iterator, bool> p =
-		m_accumulatedEvents.emplace(name, AccumulatedTraceEvent());
+}
 
-	AccumulatedTraceEvent* acc = &p.first->second;
-	if (p.second)
-	{
-		acc->event = TraceEvent(*(event.get()));
-		acc->time = event->time;
-		acc->count = 1;
-	}
-	else
+Tracer::ThreadBufferOwner::~ThreadBufferOwner()
+{
+	if (buffer)
 	{
-		acc->time += event->time;
-		acc->count++;
+		Tracer* tracer = getInstance();
+		std::lock_guard<std::mutex> lock(tracer->m_mutex);
+		tracer->m_unusedThreadBuffers.push_back(buffer);
 	}
 }
 
-void AccumulatingTracer::printTraces()
+Tracer::ThreadBuffer* Tracer::getThreadBuffer()
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
-
-	for (auto& p: m_startedEvents)
+	// buffers are owned by the tracer, so events of finished threads are kept for the export. Their
+	// buffers are reused, so short-lived threads don't allocate a new buffer each.
+	thread_local ThreadBufferOwner owner;
+	if (!owner.buffer)
 	{
-		if (!p.second.empty())
+		Tracer* tracer = getInstance();
+		std::lock_guard<std::mutex> lock(tracer->m_mutex);
+		if (!tracer->m_unusedThreadBuffers.empty())
+		{
+			owner.buffer = tracer->m_unusedThreadBuffers.back();
+			tracer->m_unusedThreadBuffers.pop_back();
+		}
+		else
 		{
-			std::cout << "TRACING: Trace events are still running." << std::endl;
+			tracer->m_threadBuffers.push_back(
+				std::make_shared<ThreadBuffer>(tracer->m_threadBuffers.size() + 1));
+			owner.buffer = tracer->m_threadBuffers.back().get();
 		}
 	}
+	return owner.buffer;
+}
 
-	std::cout << "\nREPORT:\n\n";
-	std::cout << "    time      count      name                     function";
-	std::cout << "                                          location\n";
-	std::cout << "-----------------------------------------------------------------";
-	std::cout << "------------------------------------------------------------\n";
-
-	std::multiset<
-		AccumulatedTraceEvent,
-		std::function<bool(const AccumulatedTraceEvent&, const AccumulatedTraceEvent&)>>
-		sortedEvents([](const AccumulatedTraceEvent& a, const AccumulatedTraceEvent& b) {
-			return a.time > b.time;
-		});
+Tracer::Tracer(): m_processId(0), m_processName("Sourcetrail") {}
 
-	for (const std::pair<std::string, AccumulatedTraceEvent>& p: m_accumulatedEvents)
-	{
-		sortedEvents.insert(p.second);
-	}
+std::vector<TraceEvent> Tracer::getEvents(const ThreadBuffer& buffer) const
+{
+	const size_t eventCount = buffer.eventCount.load(std::memory_order_acquire);
+	const size_t firstEvent = eventCount > s_threadBufferSize ? eventCount - s_threadBufferSize : 0;
 
-	for (const AccumulatedTraceEvent& acc: sortedEvents)
+	std::vector<TraceEvent> events;
+	events.reserve(eventCount - firstEvent);
+	for (size_t i = firstEvent; i < eventCount; i++)
 	{
-		std::cout.width(8);
-		std::cout << std::right << std::setprecision(3) << std::fixed << acc.time;
+		const EventSlot& slot = buffer.slots[i % s_threadBufferSize];
 
-		std::cout.width(10);
-		std::cout << acc.count << "       ";
+		const size_t sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+		if (sequenceBefore != 2 * (i + 1))
+		{
+			continue;	 // already overwritten by a newer event
+		}
 
-		std::cout.width(25);
-		std::cout << std::left << acc.event.eventName;
+		const TraceEvent event = slot.load();
+		std::atomic_thread_fence(std::memory_order_acquire);
 
-		std::cout.width(50);
-		std::cout << (acc.event.functionName + "()") << acc.event.locationName << std::endl;
+		if (slot.sequence.load(std::memory_order_relaxed) == sequenceBefore)
+		{
+			events.push_back(event);
+		}
 	}
-
-	std::cout << std::endl;
-
-	m_accumulatedEvents.clear();
+	return events;
 }
 
-AccumulatingTracer::AccumulatingTracer() {}
+thread_local size_t ScopedTrace::s_depth = 0;
@@ -1,155 +1,180 @@
 #ifndef TRACING_H
 #define TRACING_H
 
-
-// #define TRACING_ENABLED
-// #define USE_ACCUMULATED_TRACING
-
-
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <stack>
 #include <thread>
+#include <vector>
 
 #include "FilePath.h"
 #include "TimeStamp.h"
 #include "types.h"
 #include "utilityString.h"
 
+// All strings are static literals, so recording an event neither allocates nor copies.
 struct TraceEvent
 {
-public:
-	TraceEvent(): eventName(""), id(0), depth(0), time(0.0) {}
-
-	TraceEvent(const std::string& eventName, Id id, size_t depth)
-		: eventName(eventName), id(id), depth(depth), time(0.0)
+	TraceEvent()
+		: eventName("")
+		, functionName("")
+		, fileName("")
+		, lineNumber(0)
+		, depth(0)
+		, startMicroseconds(0)
+		, durationMicroseconds(0)
 	{
 	}
 
-	std::string eventName;
-	Id id;
+	const char* eventName;
+	const char* functionName;
+	const char* fileName;
+	int lineNumber;
 	size_t depth;
 
-	std::string functionName;
-	std::string locationName;
-
-	double time;
+	long long startMicroseconds;
+	long long durationMicroseconds;
 };
 
 
+// Collects trace events of all threads while tracing is enabled. Every thread writes into its own
+// ring buffer without locking, so the oldest events of a thread get dropped once it is full.
+// Readers detect slots that got overwritten while copying them via a sequence number per slot.
+// The buffer of an exited thread keeps its events and gets reused by the next thread that traces.
+// Events are exported as Chrome trace JSON, which chrome://tracing and Perfetto can open. Traces
+// of other processes can be imported, so they end up in the same file on the same time line.
 class Tracer
 {
 public:
 	static Tracer* getInstance();
 
-	std::shared_ptr<TraceEvent> startEvent(const std::string& eventName);
-	void finishEvent(std::shared_ptr<TraceEvent> event);
+	static bool isEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
 
-	void printTraces();
+	// microseconds of a clock that is shared by all processes on this machine
+	static long long getMicroseconds();
 
-private:
-	static std::shared_ptr<Tracer> s_instance;
-	static Id s_nextTraceId;
+	void setEnabled(bool enabled);
+	void setProcess(int processId, const std::string& processName);
 
-	Tracer();
-	Tracer(const Tracer&) = delete;
-	void operator=(const Tracer&) = delete;
+	void recordEvent(const TraceEvent& event);
 
-	std::map<std::thread::id, std::vector<std::shared_ptr<TraceEvent>>> m_events;
-	std::map<std::thread::id, std::stack<TraceEvent*>> m_startedEvents;
+	bool importTrace(const FilePath& traceFilePath);
+	bool exportTrace(const FilePath& traceFilePath);
 
-	std::mutex m_mutex;
-};
+	void printTraces();
 
+private:
+	// the fields are only accessed with relaxed atomic operations, because readers may copy a slot
+	// while the owning thread overwrites it
+	struct EventSlot
+	{
+		EventSlot();
 
-class AccumulatingTracer
-{
-public:
-	static AccumulatingTracer* getInstance();
+		void store(const TraceEvent& event);
+		TraceEvent load() const;
 
-	std::shared_ptr<TraceEvent> startEvent(const std::string& eventName);
-	void finishEvent(std::shared_ptr<TraceEvent> event);
+		std::atomic<const char*> eventName;
+		std::atomic<const char*> functionName;
+		std::atomic<const char*> fileName;
+		std::atomic<int> lineNumber;
+		std::atomic<size_t> depth;
+		std::atomic<long long> startMicroseconds;
+		std::atomic<long long> durationMicroseconds;
 
-	void printTraces();
+		// odd while the event of the slot is written, 2 * (index + 1) once event index is complete
+		std::atomic<size_t> sequence;
+	};
 
-private:
-	struct AccumulatedTraceEvent
+	struct ThreadBuffer
 	{
-		TraceEvent event;
-		size_t count;
-		double time;
+		ThreadBuffer(size_t threadId);
+
+		const size_t threadId;
+		std::vector<EventSlot> slots;
+		std::atomic<size_t> eventCount;
 	};
 
-	static std::shared_ptr<AccumulatingTracer> s_instance;
-	static Id s_nextTraceId;
+	// returns the buffer of an exited thread to the tracer once the owning thread exits
+	struct ThreadBufferOwner
+	{
+		~ThreadBufferOwner();
+
+		ThreadBuffer* buffer = nullptr;
+	};
+
+	static ThreadBuffer* getThreadBuffer();
+
+	static std::atomic<bool> s_enabled;
+	static const size_t s_threadBufferSize;
+
+	Tracer();
+	Tracer(const Tracer&) = delete;
+	void operator=(const Tracer&) = delete;
 
-	AccumulatingTracer();
-	AccumulatingTracer(const AccumulatingTracer&) = delete;
-	void operator=(const AccumulatingTracer&) = delete;
+	std::vector<TraceEvent> getEvents(const ThreadBuffer& buffer) const;
 
-	std::map<std::string, AccumulatedTraceEvent> m_accumulatedEvents;
-	std::map<std::thread::id, std::stack<TraceEvent*>> m_startedEvents;
+	std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+	std::vector<ThreadBuffer*> m_unusedThreadBuffers;
+	std::vector<std::string> m_importedEvents;
+	int m_processId;
+	std::string m_processName;
 
 	std::mutex m_mutex;
 };
 
 
-template <typename TracerType>
 class ScopedTrace
 {
 public:
 	ScopedTrace(
-		const std::string& eventName,
-		const std::string& fileName,
-		int lineNumber,
-		const std::string& functionName);
-	~ScopedTrace();
-
-private:
-	std::shared_ptr<TraceEvent> m_event;
-	TimeStamp m_timeStamp;
-};
-
-template <typename TracerType>
-ScopedTrace<TracerType>::ScopedTrace(
-	const std::string& eventName,
-	const std::string& fileName,
-	int lineNumber,
-	const std::string& functionName)
-{
-	m_event = TracerType::getInstance()->startEvent(eventName);
-	m_event->functionName = functionName;
-	m_event->locationName = utility::encodeToUtf8(FilePath(fileName).fileName()) + ":" +
-		std::to_string(lineNumber);
-
-	m_timeStamp = TimeStamp::now();
-}
+		const char* eventName, const char* fileName, int lineNumber, const char* functionName)
+		: m_active(Tracer::isEnabled())
+	{
+		if (m_active)
+		{
+			m_event.eventName = eventName;
+			m_event.functionName = functionName;
+			m_event.fileName = fileName;
+			m_event.lineNumber = lineNumber;
+			m_event.depth = s_depth++;
+			m_event.startMicroseconds = Tracer::getMicroseconds();
+		}
+	}
 
-template <typename TracerType>
-ScopedTrace<TracerType>::~ScopedTrace()
-{
-	m_event->time = TimeStamp::durationSeconds(m_timeStamp);
-	TracerType::getInstance()->finishEvent(m_event);
-}
+	~ScopedTrace()
+	{
+		if (m_active)
+		{
+			s_depth--;
+			m_event.durationMicroseconds = Tracer::getMicroseconds() - m_event.startMicroseconds;
+			Tracer::getInstance()->recordEvent(m_event);
+		}
+	}
 
+private:
+	static thread_local size_t s_depth;
 
-#ifdef TRACING_ENABLED
-#	ifdef USE_ACCUMULATED_TRACING
-#		define TRACE(__name__)                                                                    \
-			ScopedTrace<AccumulatingTracer> __trace__(                                             \
-				std::string(__name__), __FILE__, __LINE__, __FUNCTION__)
+	const bool m_active;
+	TraceEvent m_event;
+};
 
-#		define PRINT_TRACES() AccumulatingTracer::getInstance()->printTraces()
-#	else
-#		define TRACE(__name__)                                                                    \
-			ScopedTrace<Tracer> __trace__(std::string(__name__), __FILE__, __LINE__, __FUNCTION__)
 
-#		define PRINT_TRACES() Tracer::getInstance()->printTraces()
-#	endif
+// tracing is switched on at runtime via Tracer::setEnabled, event names need to be string literals
+#define TRACE_CONCATENATE_INNER(__a__, __b__) __a__##__b__
+#define TRACE_CONCATENATE(__a__, __b__) TRACE_CONCATENATE_INNER(__a__, __b__)
 
+#define TRACE(__name__)                                                                            \
+	ScopedTrace TRACE_CONCATENATE(__trace__, __LINE__)(                                            \
+		"" __name__, __FILE__, __LINE__, __FUNCTION__)
 
-#else
-#	define TRACE(__name__)
-#	define PRINT_TRACES()
-#endif
+#define PRINT_TRACES()                                                                             \
+	if (Tracer::isEnabled())                                                                       \
+	{                                                                                              \
+		Tracer::getInstance()->printTraces();                                                      \
+	}
 
 #endif	  // TRACING_H
@@ -0,0 +1,91 @@
+#include "utilityMemory.h"
+
+#if defined(_WIN32)
+#	include <windows.h>
+#	include <psapi.h>
+#elif defined(__APPLE__)
+#	include <mach/mach.h>
+#	include <sys/resource.h>
+#else
+#	include <fstream>
+#	include <string>
+#endif
+
+namespace
+{
+#if !defined(_WIN32) && !defined(__APPLE__)
+size_t readProcStatusValue(const std::string& key)
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, key.size(), key) == 0)
+		{
+			// values are given in kB, e.g. "VmHWM:     12345 kB"
+			return std::stoull(line.substr(key.size())) * 1024;
+		}
+	}
+	return 0;
+}
+#endif
+}	 // namespace
+
+namespace utility
+{
+size_t getResidentMemoryUsage()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return counters.WorkingSetSize;
+	}
+	return 0;
+#elif defined(__APPLE__)
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) ==
+		KERN_SUCCESS)
+	{
+		return info.resident_size;
+	}
+	return 0;
+#else
+	return readProcStatusValue("VmRSS:");
+#endif
+}
+
+size_t getPeakMemoryUsage()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#elif defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+		return usage.ru_maxrss;
+	}
+	return 0;
+#else
+	return readProcStatusValue("VmHWM:");
+#endif
+}
+
+void resetPeakMemoryUsage()
+{
+#if !defined(_WIN32) && !defined(__APPLE__)
+	// resets the "VmHWM" value of this process, only the Linux kernel supports this
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (clearRefs)
+	{
+		clearRefs << "5";
+	}
+#endif
+}
+}	 // namespace utility
@@ -0,0 +1,16 @@
+#ifndef UTILITY_MEMORY_H
+#define UTILITY_MEMORY_H
+
+#include <cstddef>
+
+namespace utility
+{
+// resident memory of the current process in bytes, returns 0 if not available on this platform
+size_t getResidentMemoryUsage();
+
+// highest resident memory of the current process since start or since the last reset
+size_t getPeakMemoryUsage();
+void resetPeakMemoryUsage();
+}	 // namespace utility
+
+#endif	  // UTILITY_MEMORY_H
@@ -1,7 +1,9 @@
 #include "CxxIndexerCommandProvider.h"
 
+#include "CxxPreambleCache.h"
 #include "IndexerCommandCxx.h"
 #include "logging.h"
+#include "utility.h"
 
 CxxIndexerCommandProvider::CxxIndexerCommandProvider(): m_nextId(1) {}
 
@@ -105,6 +107,12 @@ void CxxIndexerCommandProvider::addCommand(const std::shared_ptr<IndexerCommandC
 	m_commands.emplace(command->getSourceFilePath(), representation);
 }
 
+void CxxIndexerCommandProvider::setPreambleCache(
+	std::shared_ptr<const CxxPreambleCache> preambleCache)
+{
+	m_preambleCache = preambleCache;
+}
+
 std::vector<FilePath> CxxIndexerCommandProvider::getAllSourceFilePaths() const
 {
 	std::vector<FilePath> paths;
@@ -220,6 +228,11 @@ std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::represetationToCom
 		compilerFlags.push_back(m_idsToCompilerFlags[id]);
 	}
 
+	if (m_preambleCache)
+	{
+		utility::append(compilerFlags, m_preambleCache->getIncludePreambleFlags(sourceFilePath));
+	}
+
 	return std::make_shared<IndexerCommandCxx>(
 		sourceFilePath, indexedPaths, excludeFilters, includeFilters, workingDirectory, compilerFlags);
 }
@@ -9,6 +9,7 @@
 #include "IndexerCommandProvider.h"
 #include "types.h"
 
+class CxxPreambleCache;
 class IndexerCommandCxx;
 
 class CxxIndexerCommandProvider: public IndexerCommandProvider
@@ -16,6 +17,11 @@ class CxxIndexerCommandProvider: public IndexerCommandProvider
 public:
 	CxxIndexerCommandProvider();
 	void addCommand(const std::shared_ptr<IndexerCommandCxx>& command);
+
+	// preamble flags are added when commands are consumed, which happens after the preambles got
+	// built, so commands only use preambles that were built successfully
+	void setPreambleCache(std::shared_ptr<const CxxPreambleCache> preambleCache);
+
 	std::vector<FilePath> getAllSourceFilePaths() const override;
 	std::shared_ptr<IndexerCommand> consumeCommand() override;
 	std::shared_ptr<IndexerCommand> consumeCommandForSourceFilePath(const FilePath& filePath) override;
@@ -52,6 +58,8 @@ private:
 	std::map<FilePath, Id> m_workingDirectoriesToIds;
 	std::map<Id, std::wstring> m_idsToCompilerFlags;
 	std::unordered_map<std::wstring, Id> m_compilerFlagsToIds;
+
+	std::shared_ptr<const CxxPreambleCache> m_preambleCache;
 };
 
 #endif	  // CXX_INDEXER_COMMAND_PROVIDER_H
@@ -1,20 +1,47 @@
 #include "IndexerCxx.h"
 
+#include <mutex>
+
+#include "ApplicationSettings.h"
 #include "CxxParser.h"
 #include "FileRegister.h"
 
+IndexerCxx::IndexerCxx(): m_fileSystemCache(getSharedFileSystemCache()) {}
+
 void IndexerCxx::doIndex(
 	std::shared_ptr<IndexerCommandCxx> indexerCommand,
 	std::shared_ptr<ParserClientImpl> parserClient,
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo)
 {
+	// clang sets the working directory of the file system for each translation unit
+	llvm::IntrusiveRefCntPtr<CxxCachingFileSystem> fileSystem(
+		new CxxCachingFileSystem(llvm::vfs::getRealFileSystem(), m_fileSystemCache));
+
 	CxxParser parser(
 		parserClient,
 		std::make_shared<FileRegister>(
 			indexerCommand->getSourceFilePath(),
 			indexerCommand->getIndexedPaths(),
 			indexerCommand->getExcludeFilters()),
-		m_indexerStateInfo);
+		m_indexerStateInfo,
+		fileSystem);
 
 	parser.buildIndex(indexerCommand);
 }
+
+std::shared_ptr<CxxCachingFileSystem::Cache> IndexerCxx::getSharedFileSystemCache()
+{
+	static std::mutex s_mutex;
+	static std::weak_ptr<CxxCachingFileSystem::Cache> s_cache;
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	std::shared_ptr<CxxCachingFileSystem::Cache> cache = s_cache.lock();
+	if (!cache)
+	{
+		// counts against the indexing memory budget, which leaves this part to the indexers
+		cache = std::make_shared<CxxCachingFileSystem::Cache>(
+			ApplicationSettings::getInstance()->getIndexingFileCacheByteSize());
+		s_cache = cache;
+	}
+	return cache;
+}
@@ -1,16 +1,26 @@
 #ifndef INDEXER_CXX_H
 #define INDEXER_CXX_H
 
+#include "CxxCachingFileSystem.h"
 #include "Indexer.h"
 #include "IndexerCommandCxx.h"
 
 class IndexerCxx: public Indexer<IndexerCommandCxx>
 {
+public:
+	IndexerCxx();
+
 private:
 	void doIndex(
 		std::shared_ptr<IndexerCommandCxx> indexerCommand,
 		std::shared_ptr<ParserClientImpl> parserClient,
 		std::shared_ptr<IndexerStateInfo> m_indexerStateInfo) override;
+
+	// all C++ indexers of the process share one cache while any of them exists, which covers the
+	// whole indexing run if the indexers run as threads of the app
+	static std::shared_ptr<CxxCachingFileSystem::Cache> getSharedFileSystemCache();
+
+	std::shared_ptr<CxxCachingFileSystem::Cache> m_fileSystemCache;
 };
 
 #endif	  // INDEXER_CXX_H
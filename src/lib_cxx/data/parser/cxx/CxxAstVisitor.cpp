@@ -62,6 +62,11 @@ CanonicalFilePathCache* CxxAstVisitor::getCanonicalFilePathCache() const
 	return m_canonicalFilePathCache.get();
 }
 
+CxxNameResolverCache* CxxAstVisitor::getNameResolverCache()
+{
+	return &m_nameResolverCache;
+}
+
 void CxxAstVisitor::indexDecl(clang::Decl* d)
 {
 	LOG_INFO("starting AST traversal");
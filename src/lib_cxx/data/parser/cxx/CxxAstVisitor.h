@@ -12,6 +12,7 @@
 #include "CxxAstVisitorComponentIndexer.h"
 #include "CxxAstVisitorComponentTypeRefKind.h"
 #include "CxxContext.h"
+#include "CxxNameResolverCache.h"
 
 class CanonicalFilePathCache;
 class ParserClient;
@@ -46,6 +47,7 @@ public:
 	T* getComponent();
 
 	CanonicalFilePathCache* getCanonicalFilePathCache() const;
+	CxxNameResolverCache* getNameResolverCache();
 
 	// Indexing entry point
 	void indexDecl(clang::Decl* d);
@@ -173,6 +175,7 @@ protected:
 	std::shared_ptr<ParserClient> m_client;
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo;
 	std::shared_ptr<CanonicalFilePathCache> m_canonicalFilePathCache;
+	CxxNameResolverCache m_nameResolverCache;
 
 	CxxAstVisitorComponentContext m_contextComponent;
 	CxxAstVisitorComponentDeclRefKind m_declRefKindComponent;
@@ -978,8 +978,9 @@ Id CxxAstVisitorComponentIndexer::getOrCreateSymbolId(const clang::NamedDecl* de
 	NameHierarchy symbolName(L"global", NAME_DELIMITER_UNKNOWN);
 	if (decl)
 	{
-		std::unique_ptr<CxxDeclName> declName =
-			CxxDeclNameResolver(getAstVisitor()->getCanonicalFilePathCache()).getName(decl);
+		CxxDeclNameResolver declNameResolver(
+			getAstVisitor()->getCanonicalFilePathCache(), getAstVisitor()->getNameResolverCache());
+		std::unique_ptr<CxxDeclName> declName = declNameResolver.getName(decl);
 		if (declName)
 		{
 			symbolName = declName->toNameHierarchy();
@@ -1015,8 +1016,9 @@ Id CxxAstVisitorComponentIndexer::getOrCreateSymbolId(const clang::Type* type)
 	NameHierarchy symbolName(L"global", NAME_DELIMITER_UNKNOWN);
 	if (type)
 	{
-		std::unique_ptr<CxxTypeName> typeName =
-			CxxTypeNameResolver(getAstVisitor()->getCanonicalFilePathCache()).getName(type);
+		CxxTypeNameResolver typeNameResolver(
+			getAstVisitor()->getCanonicalFilePathCache(), getAstVisitor()->getNameResolverCache());
+		std::unique_ptr<CxxTypeName> typeName = typeNameResolver.getName(type);
 		if (typeName)
 		{
 			symbolName = typeName->toNameHierarchy();
@@ -1061,5 +1063,14 @@ Id CxxAstVisitorComponentIndexer::getOrCreateSymbolId(
 		}
 	}
 
-	return m_client->recordSymbol(fallback);	// TODO: cache result somehow
+	const std::wstring serializedFallback = NameHierarchy::serialize(fallback);
+	auto it = m_fallbackSymbolIds.find(serializedFallback);
+	if (it != m_fallbackSymbolIds.end())
+	{
+		return it->second;
+	}
+
+	Id symbolId = m_client->recordSymbol(fallback);
+	m_fallbackSymbolIds.emplace(serializedFallback, symbolId);
+	return symbolId;
 }
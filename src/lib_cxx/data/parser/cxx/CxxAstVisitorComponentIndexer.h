@@ -80,6 +80,7 @@ private:
 
 	std::map<const clang::NamedDecl*, Id> m_declSymbolIds;
 	std::map<const clang::Type*, Id> m_typeSymbolIds;
+	std::unordered_map<std::wstring, Id> m_fallbackSymbolIds;
 };
 
 #endif	  // CXX_AST_VISITOR_COMPONENT_INDEXER_H
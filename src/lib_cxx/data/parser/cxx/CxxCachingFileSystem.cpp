@@ -0,0 +1,301 @@
+#include "CxxCachingFileSystem.h"
+
+#include <llvm/Support/Path.h>
+
+namespace
+{
+// owns a reference to the cached buffer, so the buffer stays valid even after it has been dropped
+// from the cache
+class SharedMemoryBuffer: public llvm::MemoryBuffer
+{
+public:
+	SharedMemoryBuffer(std::shared_ptr<llvm::MemoryBuffer> buffer, std::string name)
+		: m_buffer(buffer), m_name(std::move(name))
+	{
+		init(m_buffer->getBufferStart(), m_buffer->getBufferEnd(), false);
+	}
+
+	llvm::StringRef getBufferIdentifier() const override
+	{
+		return m_name;
+	}
+
+	BufferKind getBufferKind() const override
+	{
+		return MemoryBuffer_Malloc;
+	}
+
+private:
+	std::shared_ptr<llvm::MemoryBuffer> m_buffer;
+	const std::string m_name;
+};
+
+class CachedFileHandle: public llvm::vfs::File
+{
+public:
+	CachedFileHandle(llvm::vfs::Status status, std::shared_ptr<llvm::MemoryBuffer> buffer)
+		: m_status(std::move(status)), m_buffer(buffer)
+	{
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status() override
+	{
+		return m_status;
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(
+		const llvm::Twine& Name,
+		int64_t FileSize,
+		bool RequiresNullTerminator,
+		bool IsVolatile) override
+	{
+		return std::unique_ptr<llvm::MemoryBuffer>(new SharedMemoryBuffer(m_buffer, Name.str()));
+	}
+
+	std::error_code close() override
+	{
+		return std::error_code();
+	}
+
+private:
+	const llvm::vfs::Status m_status;
+	std::shared_ptr<llvm::MemoryBuffer> m_buffer;
+};
+
+class CachedDirectoryIterator: public llvm::vfs::detail::DirIterImpl
+{
+public:
+	CachedDirectoryIterator(
+		std::string directoryPath,
+		std::shared_ptr<const std::vector<llvm::vfs::directory_entry>> entries)
+		: m_directoryPath(std::move(directoryPath)), m_entries(entries), m_index(0)
+	{
+		updateCurrentEntry();
+	}
+
+	std::error_code increment() override
+	{
+		m_index++;
+		updateCurrentEntry();
+		return std::error_code();
+	}
+
+private:
+	// entries are cached by absolute directory path, so their paths are rebuilt from the
+	// spelling that was used for this listing
+	void updateCurrentEntry()
+	{
+		if (m_index < m_entries->size())
+		{
+			const llvm::vfs::directory_entry& entry = (*m_entries)[m_index];
+			llvm::SmallString<256> path(m_directoryPath);
+			llvm::sys::path::append(path, llvm::sys::path::filename(entry.path()));
+			CurrentEntry = llvm::vfs::directory_entry(path.str().str(), entry.type());
+		}
+		else
+		{
+			CurrentEntry = llvm::vfs::directory_entry();
+		}
+	}
+
+	const std::string m_directoryPath;
+	std::shared_ptr<const std::vector<llvm::vfs::directory_entry>> m_entries;
+	size_t m_index;
+};
+
+llvm::ErrorOr<llvm::vfs::Status> renameStatus(
+	const llvm::ErrorOr<llvm::vfs::Status>& status, const llvm::Twine& name)
+{
+	if (status)
+	{
+		return llvm::vfs::Status::copyWithNewName(*status, name);
+	}
+	return status;
+}
+}	 // namespace
+
+CxxCachingFileSystem::Cache::Cache(size_t maxBufferByteSize)
+	: m_maxBufferByteSize(maxBufferByteSize), m_bufferByteSize(0)
+{
+}
+
+size_t CxxCachingFileSystem::Cache::getBufferByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_bufferByteSize;
+}
+
+CxxCachingFileSystem::CxxCachingFileSystem(
+	llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, std::shared_ptr<Cache> cache)
+	: llvm::vfs::ProxyFileSystem(fileSystem), m_cache(cache)
+{
+}
+
+llvm::ErrorOr<llvm::vfs::Status> CxxCachingFileSystem::status(const llvm::Twine& Path)
+{
+	const std::string absolutePath = getAbsolutePath(Path);
+	if (absolutePath.empty())
+	{
+		return ProxyFileSystem::status(Path);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		auto it = m_cache->m_statuses.find(absolutePath);
+		if (it != m_cache->m_statuses.end())
+		{
+			return renameStatus(it->second, Path);
+		}
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status = ProxyFileSystem::status(Path);
+
+	// missing files are remembered as well, because header search probes every include directory
+	if (status || status.getError() == std::errc::no_such_file_or_directory)
+	{
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		m_cache->m_statuses.emplace(absolutePath, status);
+	}
+
+	return status;
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> CxxCachingFileSystem::openFileForRead(
+	const llvm::Twine& Path)
+{
+	const std::string absolutePath = getAbsolutePath(Path);
+	if (absolutePath.empty())
+	{
+		return ProxyFileSystem::openFileForRead(Path);
+	}
+
+	Cache::CachedFile cachedFile;
+	{
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		auto it = m_cache->m_files.find(absolutePath);
+		if (it != m_cache->m_files.end())
+		{
+			cachedFile = it->second;
+		}
+	}
+
+	if (cachedFile.buffer)
+	{
+		const llvm::ErrorOr<llvm::vfs::Status> currentStatus = ProxyFileSystem::status(Path);
+		if (currentStatus &&
+			currentStatus->getLastModificationTime() ==
+				cachedFile.status.getLastModificationTime() &&
+			currentStatus->getSize() == cachedFile.status.getSize())
+		{
+			return std::unique_ptr<llvm::vfs::File>(new CachedFileHandle(
+				llvm::vfs::Status::copyWithNewName(cachedFile.status, Path), cachedFile.buffer));
+		}
+
+		// the file changed since it was cached, so it is read again below
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		auto it = m_cache->m_files.find(absolutePath);
+		if (it != m_cache->m_files.end() && it->second.buffer == cachedFile.buffer)
+		{
+			m_cache->m_bufferByteSize -= it->second.buffer->getBufferSize();
+			m_cache->m_files.erase(it);
+		}
+		m_cache->m_statuses.erase(absolutePath);
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> file = ProxyFileSystem::openFileForRead(Path);
+	if (!file)
+	{
+		return file;
+	}
+
+	llvm::ErrorOr<llvm::vfs::Status> status = (*file)->status();
+	if (!status || !status->isRegularFile())
+	{
+		return file;
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = (*file)->getBuffer(
+		Path, status->getSize(), true, false);
+	if (!buffer)
+	{
+		return buffer.getError();
+	}
+	(*file)->close();
+
+	std::shared_ptr<llvm::MemoryBuffer> sharedBuffer(std::move(*buffer));
+	{
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		const size_t bufferByteSize = sharedBuffer->getBufferSize();
+		if (m_cache->m_bufferByteSize + bufferByteSize <= m_cache->m_maxBufferByteSize &&
+			m_cache->m_files.emplace(absolutePath, Cache::CachedFile {*status, sharedBuffer})
+				.second)
+		{
+			m_cache->m_bufferByteSize += bufferByteSize;
+		}
+		m_cache->m_statuses.erase(absolutePath);
+		m_cache->m_statuses.emplace(absolutePath, *status);
+	}
+
+	return std::unique_ptr<llvm::vfs::File>(new CachedFileHandle(
+		llvm::vfs::Status::copyWithNewName(*status, Path), sharedBuffer));
+}
+
+llvm::vfs::directory_iterator CxxCachingFileSystem::dir_begin(
+	const llvm::Twine& Dir, std::error_code& EC)
+{
+	const std::string absolutePath = getAbsolutePath(Dir);
+	if (absolutePath.empty())
+	{
+		return ProxyFileSystem::dir_begin(Dir, EC);
+	}
+
+	std::shared_ptr<const std::vector<llvm::vfs::directory_entry>> entries;
+	{
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		auto it = m_cache->m_directories.find(absolutePath);
+		if (it != m_cache->m_directories.end())
+		{
+			entries = it->second;
+		}
+	}
+
+	if (!entries)
+	{
+		std::vector<llvm::vfs::directory_entry> collectedEntries;
+		for (llvm::vfs::directory_iterator it = ProxyFileSystem::dir_begin(Dir, EC);
+			 !EC && it != llvm::vfs::directory_iterator();
+			 it.increment(EC))
+		{
+			collectedEntries.push_back(*it);
+		}
+
+		if (EC)
+		{
+			return llvm::vfs::directory_iterator();
+		}
+
+		entries = std::make_shared<const std::vector<llvm::vfs::directory_entry>>(
+			std::move(collectedEntries));
+
+		std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+		m_cache->m_directories.emplace(absolutePath, entries);
+	}
+
+	EC = std::error_code();
+	return llvm::vfs::directory_iterator(
+		std::make_shared<CachedDirectoryIterator>(Dir.str(), entries));
+}
+
+std::string CxxCachingFileSystem::getAbsolutePath(const llvm::Twine& path) const
+{
+	llvm::SmallString<256> absolutePath;
+	path.toVector(absolutePath);
+	if (makeAbsolute(absolutePath))
+	{
+		return "";
+	}
+
+	// ".." is kept, because removing it would not respect symlinks
+	llvm::sys::path::remove_dots(absolutePath, false);
+	return absolutePath.str().str();
+}
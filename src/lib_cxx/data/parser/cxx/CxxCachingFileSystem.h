@@ -0,0 +1,63 @@
+#ifndef CXX_CACHING_FILE_SYSTEM_H
+#define CXX_CACHING_FILE_SYSTEM_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+// File system that remembers stat results, directory listings and file buffers of the real file
+// system in a thread safe cache keyed by absolute path. The file systems of all indexer threads of
+// a process share one cache, so every header is only looked up and read once, no matter how many
+// translation units include it. Each translation unit still needs its own file system, because
+// clang sets the working directory of the file system for each of them. Cached files are checked
+// for changes of their modification time and size when opened again, which only costs a stat.
+class CxxCachingFileSystem: public llvm::vfs::ProxyFileSystem
+{
+public:
+	class Cache
+	{
+	public:
+		// file buffers are only cached until they reach maxBufferByteSize in total
+		Cache(size_t maxBufferByteSize);
+
+		size_t getBufferByteSize() const;
+
+	private:
+		friend class CxxCachingFileSystem;
+
+		struct CachedFile
+		{
+			llvm::vfs::Status status;
+			std::shared_ptr<llvm::MemoryBuffer> buffer;
+		};
+
+		const size_t m_maxBufferByteSize;
+
+		mutable std::mutex m_mutex;
+		std::map<std::string, llvm::ErrorOr<llvm::vfs::Status>> m_statuses;
+		std::map<std::string, CachedFile> m_files;
+		std::map<std::string, std::shared_ptr<const std::vector<llvm::vfs::directory_entry>>>
+			m_directories;
+		size_t m_bufferByteSize;
+	};
+
+	CxxCachingFileSystem(
+		llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, std::shared_ptr<Cache> cache);
+
+	llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& Path) override;
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+		const llvm::Twine& Path) override;
+	llvm::vfs::directory_iterator dir_begin(const llvm::Twine& Dir, std::error_code& EC) override;
+
+private:
+	std::string getAbsolutePath(const llvm::Twine& path) const;
+
+	std::shared_ptr<Cache> m_cache;
+};
+
+#endif	  // CXX_CACHING_FILE_SYSTEM_H
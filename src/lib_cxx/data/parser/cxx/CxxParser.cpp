@@ -121,8 +121,12 @@ void CxxParser::initializeLLVM()
 CxxParser::CxxParser(
 	std::shared_ptr<ParserClient> client,
 	std::shared_ptr<FileRegister> fileRegister,
-	std::shared_ptr<IndexerStateInfo> indexerStateInfo)
-	: Parser(client), m_fileRegister(fileRegister), m_indexerStateInfo(indexerStateInfo)
+	std::shared_ptr<IndexerStateInfo> indexerStateInfo,
+	llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem)
+	: Parser(client)
+	, m_fileRegister(fileRegister)
+	, m_indexerStateInfo(indexerStateInfo)
+	, m_fileSystem(fileSystem ? fileSystem : llvm::vfs::getRealFileSystem())
 {
 	llvm::InitializeNativeTarget();
 	llvm::InitializeNativeTargetAsmParser();
@@ -171,7 +175,9 @@ void CxxParser::runTool(
 
 	clang::tooling::ClangTool tool(
 		*compilationDatabase,
-		std::vector<std::string>(1, utility::encodeToUtf8(sourceFilePath.wstr())));
+		std::vector<std::string>(1, utility::encodeToUtf8(sourceFilePath.wstr())),
+		std::make_shared<clang::PCHContainerOperations>(),
+		m_fileSystem);
 
 	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
 		std::make_shared<CanonicalFilePathCache>(m_fileRegister);
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include <llvm/Support/VirtualFileSystem.h>
+
 #include "Parser.h"
 
 class CanonicalFilePathCache;
@@ -35,7 +37,8 @@ public:
 	CxxParser(
 		std::shared_ptr<ParserClient> client,
 		std::shared_ptr<FileRegister> fileRegister,
-		std::shared_ptr<IndexerStateInfo> indexerStateInfo);
+		std::shared_ptr<IndexerStateInfo> indexerStateInfo,
+		llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = nullptr);
 
 	void buildIndex(std::shared_ptr<IndexerCommandCxx> indexerCommand);
 	void buildIndex(
@@ -56,6 +59,7 @@ private:
 
 	std::shared_ptr<FileRegister> m_fileRegister;
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo;
+	llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_fileSystem;
 };
 
 #endif	  // CXX_PARSER_H
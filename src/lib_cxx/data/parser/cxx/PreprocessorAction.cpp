@@ -0,0 +1,20 @@
+#include "PreprocessorAction.h"
+
+#include <clang/Frontend/CompilerInstance.h>
+
+#include "PreprocessorCallbacks.h"
+
+PreprocessorAction::PreprocessorAction(
+	std::shared_ptr<ParserClient> client,
+	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache)
+	: m_client(client), m_canonicalFilePathCache(canonicalFilePathCache)
+{
+}
+
+bool PreprocessorAction::BeginSourceFileAction(clang::CompilerInstance& compiler)
+{
+	clang::Preprocessor& preprocessor = compiler.getPreprocessor();
+	preprocessor.addPPCallbacks(llvm::make_unique<PreprocessorCallbacks>(
+		compiler.getSourceManager(), m_client, m_canonicalFilePathCache));
+	return true;
+}
@@ -0,0 +1,28 @@
+#ifndef PREPROCESSOR_ACTION_H
+#define PREPROCESSOR_ACTION_H
+
+#include <memory>
+
+#include <clang/Frontend/FrontendActions.h>
+
+class ParserClient;
+class CanonicalFilePathCache;
+
+// runs the preprocessor only and records includes and macros, e.g. for headers of a precompiled
+// header that has been generated during a previous indexing run
+class PreprocessorAction: public clang::PreprocessOnlyAction
+{
+public:
+	explicit PreprocessorAction(
+		std::shared_ptr<ParserClient> client,
+		std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache);
+
+protected:
+	bool BeginSourceFileAction(clang::CompilerInstance& compiler) override;
+
+private:
+	std::shared_ptr<ParserClient> m_client;
+	std::shared_ptr<CanonicalFilePathCache> m_canonicalFilePathCache;
+};
+
+#endif	  // PREPROCESSOR_ACTION_H
@@ -1,7 +1,18 @@
 #include "CxxName.h"
 
+#include "SmallObjectAllocator.h"
 #include "utilityString.h"
 
+void* CxxName::operator new(size_t size)
+{
+	return SmallObjectAllocator::allocate(size);
+}
+
+void CxxName::operator delete(void* block, size_t size)
+{
+	SmallObjectAllocator::deallocate(block, size);
+}
+
 CxxName::CxxName() {}
 
 CxxName::CxxName(std::shared_ptr<CxxName> parent): m_parent(parent) {}
@@ -15,6 +15,10 @@ public:
 
 	virtual ~CxxName() = default;
 
+	// names are created and dropped in large numbers while indexing, so they are pool allocated
+	static void* operator new(size_t size);
+	static void operator delete(void* block, size_t size);
+
 	void setParent(std::shared_ptr<CxxName> parent);
 	std::shared_ptr<CxxName> getParent() const;
 
@@ -4,6 +4,7 @@
 
 #include "CanonicalFilePathCache.h"
 #include "CxxFunctionDeclName.h"
+#include "CxxNameResolverCache.h"
 #include "CxxSpecifierNameResolver.h"
 #include "CxxStaticFunctionDeclName.h"
 #include "CxxTemplateArgumentNameResolver.h"
@@ -14,8 +15,9 @@
 #include "utilityClang.h"
 #include "utilityString.h"
 
-CxxDeclNameResolver::CxxDeclNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache), m_currentDecl(nullptr)
+CxxDeclNameResolver::CxxDeclNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache), m_currentDecl(nullptr)
 {
 }
 
@@ -72,9 +74,30 @@ std::unique_ptr<CxxDeclName> CxxDeclNameResolver::getName(const clang::NamedDecl
 	return declName;
 }
 
-std::unique_ptr<CxxName> CxxDeclNameResolver::getContextName(const clang::DeclContext* declContext)
+std::shared_ptr<CxxName> CxxDeclNameResolver::getContextName(const clang::DeclContext* declContext)
 {
-	std::unique_ptr<CxxName> contextDeclName;
+	// ignored contexts may shorten the name, so only names resolved without them are shared
+	CxxNameResolverCache* nameResolverCache = getIgnoredContextDecls().empty()
+		? getNameResolverCache()
+		: nullptr;
+	if (!nameResolverCache)
+	{
+		return resolveContextName(declContext);
+	}
+
+	std::shared_ptr<CxxName> contextName;
+	if (!nameResolverCache->getContextName(declContext, &contextName))
+	{
+		contextName = resolveContextName(declContext);
+		nameResolverCache->addContextName(declContext, contextName);
+	}
+	return contextName;
+}
+
+std::shared_ptr<CxxName> CxxDeclNameResolver::resolveContextName(
+	const clang::DeclContext* declContext)
+{
+	std::shared_ptr<CxxName> contextDeclName;
 
 	if (declContext && !ignoresContext(declContext))
 	{
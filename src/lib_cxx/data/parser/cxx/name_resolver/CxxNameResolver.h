@@ -6,11 +6,13 @@
 #include <clang/AST/Decl.h>
 
 class CanonicalFilePathCache;
+class CxxNameResolverCache;
 
 class CxxNameResolver
 {
 public:
-	CxxNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache);
 	CxxNameResolver(const CxxNameResolver* other);
 
 	void ignoreContextDecl(const clang::Decl* decl);
@@ -19,10 +21,12 @@ public:
 
 protected:
 	CanonicalFilePathCache* getCanonicalFilePathCache() const;
+	CxxNameResolverCache* getNameResolverCache() const;
 	const std::vector<const clang::Decl*>& getIgnoredContextDecls() const;
 
 private:
 	CanonicalFilePathCache* m_canonicalFilePathCache;
+	CxxNameResolverCache* m_nameResolverCache;
 	std::vector<const clang::Decl*> m_ignoredContextDecls;
 };
 
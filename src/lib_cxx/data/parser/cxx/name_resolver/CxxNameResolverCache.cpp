@@ -0,0 +1,39 @@
+#include "CxxNameResolverCache.h"
+
+#include "CxxName.h"
+
+bool CxxNameResolverCache::getContextName(
+	const clang::DeclContext* declContext, std::shared_ptr<CxxName>* name) const
+{
+	auto it = m_contextNames.find(declContext);
+	if (it != m_contextNames.end())
+	{
+		*name = it->second;
+		return true;
+	}
+	return false;
+}
+
+void CxxNameResolverCache::addContextName(
+	const clang::DeclContext* declContext, std::shared_ptr<CxxName> name)
+{
+	m_contextNames.emplace(declContext, std::move(name));
+}
+
+bool CxxNameResolverCache::getTemplateArgumentName(
+	const void* argumentType, std::wstring* name) const
+{
+	auto it = m_templateArgumentNames.find(argumentType);
+	if (it != m_templateArgumentNames.end())
+	{
+		*name = it->second;
+		return true;
+	}
+	return false;
+}
+
+void CxxNameResolverCache::addTemplateArgumentName(
+	const void* argumentType, const std::wstring& name)
+{
+	m_templateArgumentNames.emplace(argumentType, name);
+}
@@ -0,0 +1,30 @@
+#ifndef CXX_NAME_RESOLVER_CACHE_H
+#define CXX_NAME_RESOLVER_CACHE_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <clang/AST/DeclBase.h>
+
+class CxxName;
+
+// Names resolved while indexing a single translation unit. All name resolvers of the translation
+// unit share this cache, so enclosing contexts and template arguments are resolved only once.
+class CxxNameResolverCache
+{
+public:
+	bool getContextName(
+		const clang::DeclContext* declContext, std::shared_ptr<CxxName>* name) const;
+	void addContextName(const clang::DeclContext* declContext, std::shared_ptr<CxxName> name);
+
+	bool getTemplateArgumentName(const void* argumentType, std::wstring* name) const;
+	void addTemplateArgumentName(const void* argumentType, const std::wstring& name);
+
+private:
+	// context names are shared as parents by all names within the context and must not be altered
+	std::unordered_map<const clang::DeclContext*, std::shared_ptr<CxxName>> m_contextNames;
+	std::unordered_map<const void*, std::wstring> m_templateArgumentNames;
+};
+
+#endif	  // CXX_NAME_RESOLVER_CACHE_H
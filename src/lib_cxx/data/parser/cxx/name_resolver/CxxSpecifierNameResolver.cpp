@@ -8,8 +8,9 @@
 #include "CxxTypeNameResolver.h"
 #include "utilityString.h"
 
-CxxSpecifierNameResolver::CxxSpecifierNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache)
+CxxSpecifierNameResolver::CxxSpecifierNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache)
 {
 }
 
@@ -10,7 +10,8 @@ class CxxName;
 class CxxSpecifierNameResolver: public CxxNameResolver
 {
 public:
-	CxxSpecifierNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxSpecifierNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache);
 	CxxSpecifierNameResolver(const CxxNameResolver* other);
 
 	std::unique_ptr<CxxName> getName(const clang::NestedNameSpecifier* nestedNameSpecifier);
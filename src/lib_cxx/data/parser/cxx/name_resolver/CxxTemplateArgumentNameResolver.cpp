@@ -5,12 +5,13 @@
 #include <clang/AST/DeclTemplate.h>
 #include <clang/AST/PrettyPrinter.h>
 
+#include "CxxNameResolverCache.h"
 #include "CxxTypeNameResolver.h"
 #include "utilityString.h"
 
 CxxTemplateArgumentNameResolver::CxxTemplateArgumentNameResolver(
-	CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache)
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache)
 {
 }
 
@@ -29,10 +30,28 @@ std::wstring CxxTemplateArgumentNameResolver::getTemplateArgumentName(
 	{
 	case clang::TemplateArgument::Type:
 	{
+		// ignored contexts may shorten the name, so only names resolved without them are shared
+		CxxNameResolverCache* nameResolverCache = getIgnoredContextDecls().empty()
+			? getNameResolverCache()
+			: nullptr;
+		const void* argumentType = argument.getAsType().getAsOpaquePtr();
+
+		std::wstring name;
+		if (nameResolverCache && nameResolverCache->getTemplateArgumentName(argumentType, &name))
+		{
+			return name;
+		}
+
 		CxxTypeNameResolver typeNameResolver(this);
 		std::unique_ptr<CxxTypeName> typeName = CxxTypeName::makeUnsolvedIfNull(
 			typeNameResolver.getName(argument.getAsType()));
-		return typeName->toString();
+		name = typeName->toString();
+
+		if (nameResolverCache)
+		{
+			nameResolverCache->addTemplateArgumentName(argumentType, name);
+		}
+		return name;
 	}
 	case clang::TemplateArgument::Integral:
 	case clang::TemplateArgument::Null:
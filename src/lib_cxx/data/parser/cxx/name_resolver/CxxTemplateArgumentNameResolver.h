@@ -10,7 +10,8 @@ class DataType;
 class CxxTemplateArgumentNameResolver: public CxxNameResolver
 {
 public:
-	CxxTemplateArgumentNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxTemplateArgumentNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache);
 	CxxTemplateArgumentNameResolver(const CxxNameResolver* other);
 
 	std::wstring getTemplateArgumentName(const clang::TemplateArgument& argument);
@@ -9,8 +9,8 @@
 #include "utilityString.h"
 
 CxxTemplateParameterStringResolver::CxxTemplateParameterStringResolver(
-	CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache)
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache)
 {
 }
 
@@ -12,7 +12,8 @@ class DataType;
 class CxxTemplateParameterStringResolver: public CxxNameResolver
 {
 public:
-	CxxTemplateParameterStringResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxTemplateParameterStringResolver(
+		CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache);
 	CxxTemplateParameterStringResolver(const CxxNameResolver* other);
 
 	std::wstring getTemplateParameterString(const clang::NamedDecl* parameter);
@@ -10,8 +10,9 @@
 #include "logging.h"
 #include "utilityString.h"
 
-CxxTypeNameResolver::CxxTypeNameResolver(CanonicalFilePathCache* canonicalFilePathCache)
-	: CxxNameResolver(canonicalFilePathCache)
+CxxTypeNameResolver::CxxTypeNameResolver(
+	CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache)
+	: CxxNameResolver(canonicalFilePathCache, nameResolverCache)
 {
 }
 
@@ -7,7 +7,8 @@
 class CxxTypeNameResolver: public CxxNameResolver
 {
 public:
-	CxxTypeNameResolver(CanonicalFilePathCache* canonicalFilePathCache);
+	CxxTypeNameResolver(
+		CanonicalFilePathCache* canonicalFilePathCache, CxxNameResolverCache* nameResolverCache);
 	CxxTypeNameResolver(const CxxNameResolver* other);
 
 	std::unique_ptr<CxxTypeName> getName(const clang::QualType& qualType);
@@ -0,0 +1,604 @@
+#include "CxxPreambleCache.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem/fstream.hpp>
+#include <clang/Basic/Version.h>
+
+#include "DialogView.h"
+#include "FileSystem.h"
+#include "IntermediateStorage.h"
+#include "StorageProvider.h"
+#include "logging.h"
+#include "utility.h"
+#include "utilitySourceGroupCxx.h"
+
+namespace
+{
+const unsigned long long s_hashOffsetBasis = 14695981039346656037ULL;
+const unsigned long long s_hashPrime = 1099511628211ULL;
+
+// FNV-1a, which is stable across runs and platforms unlike std::hash
+unsigned long long hashBytes(unsigned long long hash, const char* data, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= s_hashPrime;
+	}
+	return hash;
+}
+
+unsigned long long hashString(unsigned long long hash, const std::string& str)
+{
+	// hashing the terminating null character keeps ["ab", "c"] and ["a", "bc"] apart
+	return hashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+bool getFileContentHash(const FilePath& filePath, unsigned long long& hash)
+{
+	boost::filesystem::ifstream file(filePath.getPath(), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	hash = s_hashOffsetBasis;
+	std::vector<char> buffer(65536);
+	while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+	{
+		hash = hashBytes(hash, buffer.data(), static_cast<size_t>(file.gcount()));
+	}
+	return true;
+}
+
+std::string toHexString(unsigned long long value)
+{
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << value;
+	return ss.str();
+}
+
+// removes the generated preamble header from the storage, so it doesn't show up in the index
+void removeFile(IntermediateStorage* storage, const FilePath& filePath)
+{
+	Id fileId = 0;
+	std::vector<StorageFile> files;
+	for (const StorageFile& file: storage->getStorageFiles())
+	{
+		if (FilePath(file.filePath) == filePath)
+		{
+			fileId = file.id;
+		}
+		else
+		{
+			files.push_back(file);
+		}
+	}
+
+	if (!fileId)
+	{
+		return;
+	}
+
+	std::vector<StorageNode> nodes;
+	for (const StorageNode& node: storage->getStorageNodes())
+	{
+		if (node.id != fileId)
+		{
+			nodes.push_back(node);
+		}
+	}
+
+	std::set<Id> removedElementIds;
+	std::vector<StorageEdge> edges;
+	for (const StorageEdge& edge: storage->getStorageEdges())
+	{
+		if (edge.sourceNodeId == fileId)
+		{
+			removedElementIds.insert(edge.id);
+		}
+		else
+		{
+			edges.push_back(edge);
+		}
+	}
+
+	std::set<Id> removedLocationIds;
+	std::set<StorageSourceLocation> sourceLocations;
+	for (const StorageSourceLocation& location: storage->getStorageSourceLocations())
+	{
+		if (location.fileNodeId == fileId)
+		{
+			removedLocationIds.insert(location.id);
+		}
+		else
+		{
+			sourceLocations.insert(location);
+		}
+	}
+
+	std::set<StorageOccurrence> occurrences;
+	for (const StorageOccurrence& occurrence: storage->getStorageOccurrences())
+	{
+		if (removedLocationIds.find(occurrence.sourceLocationId) != removedLocationIds.end())
+		{
+			// errors only located in the removed file go along with it
+			removedElementIds.insert(occurrence.elementId);
+		}
+		else if (removedElementIds.find(occurrence.elementId) == removedElementIds.end())
+		{
+			occurrences.insert(occurrence);
+		}
+	}
+
+	std::vector<StorageError> errors;
+	for (const StorageError& error: storage->getErrors())
+	{
+		if (removedElementIds.find(error.id) == removedElementIds.end())
+		{
+			errors.push_back(error);
+		}
+	}
+
+	storage->setStorageFiles(std::move(files));
+	storage->setStorageNodes(std::move(nodes));
+	storage->setStorageEdges(std::move(edges));
+	storage->setStorageSourceLocations(std::move(sourceLocations));
+	storage->setStorageOccurrences(std::move(occurrences));
+	storage->setErrors(std::move(errors));
+}
+}	 // namespace
+
+const size_t CxxPreambleCache::s_minTranslationUnitCount = 3;
+const size_t CxxPreambleCache::s_maxIncludeDirectiveCount = 40;
+
+CxxPreambleCache::CxxPreambleCache(
+	const FilePath& cacheDirectoryPath,
+	const std::set<FilePath>& indexedHeaderPaths,
+	const std::set<FilePathFilter>& excludeFilters)
+	: m_cacheDirectoryPath(cacheDirectoryPath)
+	, m_indexedHeaderPaths(indexedHeaderPaths)
+	, m_excludeFilters(excludeFilters)
+{
+}
+
+void CxxPreambleCache::addTranslationUnit(
+	const FilePath& sourceFilePath,
+	const FilePath& workingDirectory,
+	const std::vector<std::wstring>& compilerFlags)
+{
+	TranslationUnit unit;
+	unit.sourceFilePath = sourceFilePath;
+	unit.workingDirectory = workingDirectory;
+	unit.includeDirectives = getLeadingIncludeDirectives(sourceFilePath);
+	if (unit.includeDirectives.empty())
+	{
+		return;
+	}
+
+	bool hasQuotedIncludes = false;
+	for (const std::string& directive: unit.includeDirectives)
+	{
+		hasQuotedIncludes = hasQuotedIncludes || directive.find('"') != std::string::npos;
+	}
+	unit.preambleCompilerFlags = getPreambleCompilerFlags(
+		sourceFilePath, compilerFlags, hasQuotedIncludes);
+
+	// precompiled headers are not compatible between clang versions
+	unsigned long long hash = hashString(s_hashOffsetBasis, clang::getClangFullVersion());
+	hash = hashString(hash, utility::encodeToUtf8(workingDirectory.wstr()));
+	for (const std::wstring& flag: unit.preambleCompilerFlags)
+	{
+		hash = hashString(hash, utility::encodeToUtf8(flag));
+	}
+	unit.flagsHash = hash;
+
+	m_translationUnits.push_back(std::move(unit));
+}
+
+void CxxPreambleCache::createPreambles()
+{
+	std::map<unsigned long long, size_t> prefixCounts;
+	for (const TranslationUnit& unit: m_translationUnits)
+	{
+		unsigned long long hash = unit.flagsHash;
+		for (const std::string& directive: unit.includeDirectives)
+		{
+			hash = hashString(hash, directive);
+			prefixCounts[hash]++;
+		}
+	}
+
+	std::set<std::string> cachedPreambleIds;
+	if (m_cacheDirectoryPath.exists())
+	{
+		for (const FilePath& path:
+			 FileSystem::getFilePathsFromDirectory(m_cacheDirectoryPath, {L".pch"}))
+		{
+			cachedPreambleIds.insert(utility::encodeToUtf8(path.withoutExtension().fileName()));
+		}
+	}
+
+	std::map<std::string, size_t> preambleIndicesById;
+	for (const TranslationUnit& unit: m_translationUnits)
+	{
+		// use the longest prefix that is either shared by enough units or already precompiled
+		size_t prefixLength = 0;
+		std::string preambleId;
+
+		unsigned long long hash = unit.flagsHash;
+		for (size_t i = 0; i < unit.includeDirectives.size(); i++)
+		{
+			hash = hashString(hash, unit.includeDirectives[i]);
+
+			const std::string id = toHexString(hash);
+			if (prefixCounts[hash] >= s_minTranslationUnitCount ||
+				cachedPreambleIds.find(id) != cachedPreambleIds.end())
+			{
+				prefixLength = i + 1;
+				preambleId = id;
+			}
+		}
+
+		if (!prefixLength)
+		{
+			continue;
+		}
+
+		std::map<std::string, size_t>::const_iterator it = preambleIndicesById.find(preambleId);
+		if (it == preambleIndicesById.end())
+		{
+			Preamble preamble;
+			preamble.id = preambleId;
+			preamble.workingDirectory = unit.workingDirectory;
+			preamble.compilerFlags = unit.preambleCompilerFlags;
+			preamble.includeDirectives = std::vector<std::string>(
+				unit.includeDirectives.begin(), unit.includeDirectives.begin() + prefixLength);
+			preamble.translationUnitCount = 0;
+
+			it = preambleIndicesById.emplace(preambleId, m_preambles.size()).first;
+			m_preambles.push_back(std::move(preamble));
+		}
+
+		m_preambles[it->second].translationUnitCount++;
+		m_preambleIndices.emplace(unit.sourceFilePath, it->second);
+	}
+
+	LOG_INFO(
+		"Assigned " + std::to_string(m_preambleIndices.size()) + " of " +
+		std::to_string(m_translationUnits.size()) + " translation units to " +
+		std::to_string(m_preambles.size()) + " precompiled preambles");
+
+	m_translationUnits.clear();
+}
+
+size_t CxxPreambleCache::getPreambleCount() const
+{
+	return m_preambles.size();
+}
+
+void CxxPreambleCache::buildPreambles(
+	std::shared_ptr<StorageProvider> storageProvider, std::shared_ptr<DialogView> dialogView)
+{
+	for (size_t i = 0; i < m_preambles.size(); i++)
+	{
+		dialogView->showProgressDialog(
+			L"Preparing Indexing",
+			L"Processing Precompiled Preambles",
+			i * 100 / m_preambles.size());
+
+		if (buildPreamble(
+				m_preambles[i],
+				m_cacheDirectoryPath,
+				m_indexedHeaderPaths,
+				m_excludeFilters,
+				storageProvider))
+		{
+			std::lock_guard<std::mutex> lock(m_builtPreambleIdsMutex);
+			m_builtPreambleIds.insert(m_preambles[i].id);
+		}
+	}
+
+	dialogView->hideProgressDialog();
+}
+
+std::vector<std::wstring> CxxPreambleCache::getIncludePreambleFlags(
+	const FilePath& sourceFilePath) const
+{
+	std::map<FilePath, size_t>::const_iterator it = m_preambleIndices.find(sourceFilePath);
+	if (it == m_preambleIndices.end())
+	{
+		return {};
+	}
+
+	const std::string& id = m_preambles[it->second].id;
+	{
+		std::lock_guard<std::mutex> lock(m_builtPreambleIdsMutex);
+		if (m_builtPreambleIds.find(id) == m_builtPreambleIds.end())
+		{
+			return {};
+		}
+	}
+
+	const FilePath pchFilePath = m_cacheDirectoryPath.getConcatenated(
+		utility::decodeFromUtf8(id) + L".pch");
+	if (!pchFilePath.exists())
+	{
+		return {};
+	}
+
+	// the preamble and its headers were validated by their content before indexing, clang's own
+	// validation would reject it for headers that were only touched
+	return {
+		L"-fallow-pch-with-compiler-errors",
+		L"-Xclang",
+		L"-fno-validate-pch",
+		L"-include-pch",
+		pchFilePath.wstr()};
+}
+
+std::vector<std::string> CxxPreambleCache::getLeadingIncludeDirectives(
+	const FilePath& sourceFilePath)
+{
+	std::vector<std::string> directives;
+
+	boost::filesystem::ifstream file(sourceFilePath.getPath());
+	std::string line;
+	bool inBlockComment = false;
+	while (directives.size() < s_maxIncludeDirectiveCount && std::getline(file, line))
+	{
+		std::string code;
+		for (size_t i = 0; i < line.size(); i++)
+		{
+			if (inBlockComment)
+			{
+				if (line.compare(i, 2, "*/") == 0)
+				{
+					inBlockComment = false;
+					i++;
+				}
+			}
+			else if (line.compare(i, 2, "/*") == 0)
+			{
+				inBlockComment = true;
+				i++;
+			}
+			else if (line.compare(i, 2, "//") == 0)
+			{
+				break;
+			}
+			else
+			{
+				code += line[i];
+			}
+		}
+
+		code = utility::trim(code);
+		if (code.empty())
+		{
+			continue;
+		}
+
+		// any code or other directive may change the meaning of the following includes
+		if (code[0] != '#')
+		{
+			break;
+		}
+
+		const std::string directive = utility::trim(code.substr(1));
+		if (directive == "pragma once")
+		{
+			continue;
+		}
+
+		if (!utility::isPrefix<std::string>("include", directive))
+		{
+			break;
+		}
+
+		const std::string header = utility::trim(directive.substr(7));
+		if (header.empty() || (header[0] != '<' && header[0] != '"'))
+		{
+			break;
+		}
+
+		directives.push_back("#include " + header);
+	}
+
+	return directives;
+}
+
+std::vector<std::wstring> CxxPreambleCache::getPreambleCompilerFlags(
+	const FilePath& sourceFilePath,
+	const std::vector<std::wstring>& compilerFlags,
+	bool hasQuotedIncludes)
+{
+	std::vector<std::wstring> flags;
+	std::wstring language;
+
+	for (size_t i = 0; i < compilerFlags.size(); i++)
+	{
+		const std::wstring& flag = compilerFlags[i];
+
+		if ((i == 0 && !utility::isPrefix<std::wstring>(L"-", flag)) || flag == L"-c" ||
+			flag == L"-MD" || flag == L"-MMD")
+		{
+			continue;
+		}
+
+		if (flag == L"-o" || flag == L"-MF" || flag == L"-MT" || flag == L"-MQ")
+		{
+			i++;
+			continue;
+		}
+
+		if (!utility::isPrefix<std::wstring>(L"-", flag) &&
+			FilePath(flag).fileName() == sourceFilePath.fileName())
+		{
+			continue;
+		}
+
+		if (flag == L"-x" && i + 1 < compilerFlags.size())
+		{
+			language = compilerFlags[i + 1];
+		}
+
+		flags.push_back(flag);
+	}
+
+	if (language.empty())
+	{
+		const std::wstring extension = utility::toLowerCase(sourceFilePath.extension());
+		if (extension == L".c")
+		{
+			language = L"c";
+		}
+		else if (extension == L".m")
+		{
+			language = L"objective-c";
+		}
+		else if (extension == L".mm")
+		{
+			language = L"objective-c++";
+		}
+		else
+		{
+			language = L"c++";
+		}
+	}
+
+	flags.push_back(L"-x");
+	flags.push_back(language + L"-header");
+
+	// quoted includes are looked up relative to the source file, which the preamble header isn't
+	// located next to
+	if (hasQuotedIncludes)
+	{
+		flags.push_back(L"-iquote");
+		flags.push_back(sourceFilePath.getParentDirectory().wstr());
+	}
+
+	return flags;
+}
+
+bool CxxPreambleCache::buildPreamble(
+	const Preamble& preamble,
+	const FilePath& cacheDirectoryPath,
+	const std::set<FilePath>& indexedHeaderPaths,
+	const std::set<FilePathFilter>& excludeFilters,
+	std::shared_ptr<StorageProvider> storageProvider)
+{
+	const std::wstring id = utility::decodeFromUtf8(preamble.id);
+	const FilePath headerFilePath = cacheDirectoryPath.getConcatenated(id + L".h");
+	const FilePath pchFilePath = cacheDirectoryPath.getConcatenated(id + L".pch");
+	const FilePath manifestFilePath = cacheDirectoryPath.getConcatenated(id + L".deps");
+
+	std::shared_ptr<IntermediateStorage> storage;
+	bool success = true;
+
+	if (isCachedPreambleValid(pchFilePath, manifestFilePath))
+	{
+		LOG_INFO(
+			L"Reusing precompiled preamble \"" + pchFilePath.wstr() + L"\" for " +
+			std::to_wstring(preamble.translationUnitCount) + L" translation units");
+
+		// the preprocessor data of the headers is still needed for the current index
+		storage = utility::preprocessPrecompiledHeaderInput(
+			headerFilePath,
+			preamble.workingDirectory,
+			preamble.compilerFlags,
+			indexedHeaderPaths,
+			excludeFilters);
+	}
+	else
+	{
+		if (!cacheDirectoryPath.exists())
+		{
+			FileSystem::createDirectory(cacheDirectoryPath);
+		}
+
+		// a precompiled header left over from an older run must not pass as the result of this one
+		FileSystem::remove(manifestFilePath);
+		FileSystem::remove(pchFilePath);
+		{
+			boost::filesystem::ofstream headerFile(headerFilePath.getPath());
+			for (const std::string& directive: preamble.includeDirectives)
+			{
+				headerFile << directive << '\n';
+			}
+		}
+
+		storage = utility::generatePrecompiledHeader(
+			headerFilePath,
+			pchFilePath,
+			preamble.workingDirectory,
+			preamble.compilerFlags,
+			indexedHeaderPaths,
+			excludeFilters);
+
+		if (pchFilePath.recheckExists())
+		{
+			// the precompiled header itself is part of the manifest, so it is never used unchecked
+			std::vector<FilePath> manifestFilePaths = {pchFilePath};
+			for (const StorageFile& file: storage->getStorageFiles())
+			{
+				manifestFilePaths.push_back(FilePath(file.filePath));
+			}
+
+			boost::filesystem::ofstream manifestFile(manifestFilePath.getPath());
+			for (const FilePath& filePath: manifestFilePaths)
+			{
+				unsigned long long hash = 0;
+				if (getFileContentHash(filePath, hash))
+				{
+					manifestFile << toHexString(hash) << '\t'
+								 << utility::encodeToUtf8(filePath.wstr()) << '\n';
+				}
+			}
+		}
+		else
+		{
+			LOG_ERROR(L"Failed to generate precompiled preamble \"" + pchFilePath.wstr() + L"\"");
+			success = false;
+		}
+	}
+
+	removeFile(storage.get(), headerFilePath.getCanonical());
+	storageProvider->insert(storage);
+	return success;
+}
+
+bool CxxPreambleCache::isCachedPreambleValid(
+	const FilePath& pchFilePath, const FilePath& manifestFilePath)
+{
+	if (!pchFilePath.exists() || !manifestFilePath.exists())
+	{
+		return false;
+	}
+
+	boost::filesystem::ifstream manifestFile(manifestFilePath.getPath());
+	std::string line;
+	size_t fileCount = 0;
+	while (std::getline(manifestFile, line))
+	{
+		const size_t separatorPos = line.find('\t');
+		if (separatorPos == std::string::npos)
+		{
+			return false;
+		}
+
+		const FilePath filePath(utility::decodeFromUtf8(line.substr(separatorPos + 1)));
+		unsigned long long hash = 0;
+		if (!getFileContentHash(filePath, hash) ||
+			toHexString(hash) != line.substr(0, separatorPos))
+		{
+			return false;
+		}
+
+		fileCount++;
+	}
+
+	return fileCount > 0;
+}
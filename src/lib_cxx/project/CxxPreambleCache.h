@@ -0,0 +1,99 @@
+#ifndef CXX_PREAMBLE_CACHE_H
+#define CXX_PREAMBLE_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "FilePathFilter.h"
+
+class DialogView;
+class StorageProvider;
+
+// Detects the leading includes that translation units with equal compiler flags have in common
+// and precompiles them once as a preamble for all of these units. Preambles are cached on disk,
+// keyed by the content of all headers they contain, so later indexing runs can reuse them.
+class CxxPreambleCache
+{
+public:
+	CxxPreambleCache(
+		const FilePath& cacheDirectoryPath,
+		const std::set<FilePath>& indexedHeaderPaths,
+		const std::set<FilePathFilter>& excludeFilters);
+
+	void addTranslationUnit(
+		const FilePath& sourceFilePath,
+		const FilePath& workingDirectory,
+		const std::vector<std::wstring>& compilerFlags);
+
+	// assigns preambles to all added translation units
+	void createPreambles();
+
+	size_t getPreambleCount() const;
+
+	// builds or validates all preambles, only the ones that succeeded are used afterwards
+	void buildPreambles(
+		std::shared_ptr<StorageProvider> storageProvider, std::shared_ptr<DialogView> dialogView);
+
+	// returns the flags that make the translation unit use its preamble or nothing if it has none
+	// or the preamble was not built successfully
+	std::vector<std::wstring> getIncludePreambleFlags(const FilePath& sourceFilePath) const;
+
+	// the include directives at the start of the file, up to the first code or other directive
+	static std::vector<std::string> getLeadingIncludeDirectives(const FilePath& sourceFilePath);
+
+	// the compiler flags of the translation unit without its output and source file, set up to
+	// compile a header of its language
+	static std::vector<std::wstring> getPreambleCompilerFlags(
+		const FilePath& sourceFilePath,
+		const std::vector<std::wstring>& compilerFlags,
+		bool hasQuotedIncludes);
+
+private:
+	struct TranslationUnit
+	{
+		FilePath sourceFilePath;
+		FilePath workingDirectory;
+		std::vector<std::wstring> preambleCompilerFlags;
+		std::vector<std::string> includeDirectives;
+		unsigned long long flagsHash;
+	};
+
+	struct Preamble
+	{
+		std::string id;
+		FilePath workingDirectory;
+		std::vector<std::wstring> compilerFlags;
+		std::vector<std::string> includeDirectives;
+		size_t translationUnitCount;
+	};
+
+	static bool buildPreamble(
+		const Preamble& preamble,
+		const FilePath& cacheDirectoryPath,
+		const std::set<FilePath>& indexedHeaderPaths,
+		const std::set<FilePathFilter>& excludeFilters,
+		std::shared_ptr<StorageProvider> storageProvider);
+	static bool isCachedPreambleValid(
+		const FilePath& pchFilePath, const FilePath& manifestFilePath);
+
+	static const size_t s_minTranslationUnitCount;
+	static const size_t s_maxIncludeDirectiveCount;
+
+	const FilePath m_cacheDirectoryPath;
+	const std::set<FilePath> m_indexedHeaderPaths;
+	const std::set<FilePathFilter> m_excludeFilters;
+
+	std::vector<TranslationUnit> m_translationUnits;
+	std::vector<Preamble> m_preambles;
+	std::map<FilePath, size_t> m_preambleIndices;
+
+	mutable std::mutex m_builtPreambleIdsMutex;
+	std::set<std::string> m_builtPreambleIds;
+};
+
+#endif	  // CXX_PREAMBLE_CACHE_H
@@ -7,6 +7,7 @@
 #include "ApplicationSettings.h"
 #include "ClangInvocationInfo.h"
 #include "CxxCompilationDatabaseSingle.h"
+#include "CxxPreambleCache.h"
 #include "CxxIndexerCommandProvider.h"
 #include "IndexerCommandCxx.h"
 #include "MessageStatus.h"
@@ -18,6 +19,8 @@
 
 SourceGroupCxxCdb::SourceGroupCxxCdb(std::shared_ptr<SourceGroupSettingsCxxCdb> settings)
 	: m_settings(settings)
+	, m_cdbCacheEntry(
+		  utility::getCDBCacheEntry(settings->getCompilationDatabasePathExpandedAndAbsolute()))
 {
 }
 
@@ -48,8 +51,7 @@ std::set<FilePath> SourceGroupCxxCdb::filterToContainedFilePaths(const std::set<
 
 std::set<FilePath> SourceGroupCxxCdb::getAllSourceFilePaths() const
 {
-	return getAllSourceFilePaths(
-		utility::loadCDB(m_settings->getCompilationDatabasePathExpandedAndAbsolute()));
+	return getAllSourceFilePaths(loadCDB());
 }
 
 std::set<FilePath> SourceGroupCxxCdb::getAllSourceFilePaths(
@@ -90,8 +92,10 @@ std::shared_ptr<IndexerCommandProvider> SourceGroupCxxCdb::getIndexerCommandProv
 	std::shared_ptr<CxxIndexerCommandProvider> provider =
 		std::make_shared<CxxIndexerCommandProvider>();
 
+	m_preambleCache.reset();
+
 	const FilePath cdbPath = m_settings->getCompilationDatabasePathExpandedAndAbsolute();
-	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = utility::loadCDB(cdbPath);
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = loadCDB();
 	if (!cdb)
 	{
 		return provider;
@@ -108,42 +112,97 @@ std::shared_ptr<IndexerCommandProvider> SourceGroupCxxCdb::getIndexerCommandProv
 		m_settings->getExcludeFiltersExpandedAndAbsolute());
 	const std::set<FilePath>& sourceFilePaths = getAllSourceFilePaths(cdb);
 
-	for (const clang::tooling::CompileCommand& command: cdb->getAllCompileCommands())
+	std::shared_ptr<CxxPreambleCache> preambleCache;
+	if (ApplicationSettings::getInstance()->getCxxAutomaticPreamblesEnabled() &&
+		includePchFlags.empty())
+	{
+		preambleCache = std::make_shared<CxxPreambleCache>(
+			m_settings->getPchDependenciesDirectoryPath().concatenate(L"preambles"),
+			indexedHeaderPaths,
+			excludeFilters);
+	}
+
+	// only the flags of the database are stored per command, the flags of the source group are
+	// the same for all of them
+	struct CommandInfo
 	{
-		FilePath sourcePath = FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
-		if (!sourcePath.isAbsolute())
+		FilePath sourcePath;
+		FilePath workingDirectory;
+		std::vector<std::wstring> cdbFlags;
+	};
+	std::vector<CommandInfo> commandInfos;
+
+	// commands are copied out of the parsed database file by file instead of all at once, the
+	// parsed database itself is kept in memory by clang
+	for (const std::string& file: cdb->getAllFiles())
+	{
+		for (const clang::tooling::CompileCommand& command: cdb->getCompileCommands(file))
 		{
-			sourcePath = FilePath(utility::decodeFromUtf8(command.Directory + '/' + command.Filename))
-							 .makeCanonical();
+			FilePath sourcePath =
+				FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
 			if (!sourcePath.isAbsolute())
 			{
-				sourcePath = cdbPath.getParentDirectory().getConcatenated(sourcePath).makeCanonical();
+				sourcePath = FilePath(utility::decodeFromUtf8(
+										  command.Directory + '/' + command.Filename))
+								 .makeCanonical();
+				if (!sourcePath.isAbsolute())
+				{
+					sourcePath =
+						cdbPath.getParentDirectory().getConcatenated(sourcePath).makeCanonical();
+				}
+			}
+
+			if (info.filesToIndex.find(sourcePath) == info.filesToIndex.end() ||
+				sourceFilePaths.find(sourcePath) == sourceFilePaths.end())
+			{
+				continue;
 			}
-		}
 
-		if (info.filesToIndex.find(sourcePath) != info.filesToIndex.end() &&
-			sourceFilePaths.find(sourcePath) != sourceFilePaths.end())
-		{
 			std::vector<std::wstring> cdbFlags = utility::convert<std::string, std::wstring>(
 				command.CommandLine, [](const std::string& s) { return utility::decodeFromUtf8(s); });
 
 			utility::removeIncludePchFlag(cdbFlags);
 
+			const FilePath workingDirectory(utility::decodeFromUtf8(command.Directory));
+
 			if (command.CommandLine.size() != cdbFlags.size())
 			{
 				utility::append(cdbFlags, includePchFlags);
 			}
+			else if (preambleCache)
+			{
+				preambleCache->addTranslationUnit(
+					sourcePath, workingDirectory, utility::concat(cdbFlags, compilerFlags));
+			}
 
-			provider->addCommand(std::make_shared<IndexerCommandCxx>(
-				sourcePath,
-				utility::concat(indexedHeaderPaths, {sourcePath}),
-				excludeFilters,
-				std::set<FilePathFilter>(),
-				FilePath(utility::decodeFromUtf8(command.Directory)),
-				utility::concat(cdbFlags, compilerFlags)));
+			commandInfos.push_back({sourcePath, workingDirectory, std::move(cdbFlags)});
 		}
 	}
 
+	if (preambleCache)
+	{
+		preambleCache->createPreambles();
+		provider->setPreambleCache(preambleCache);
+	}
+	m_preambleCache = preambleCache;
+
+	for (CommandInfo& commandInfo: commandInfos)
+	{
+		std::vector<std::wstring> commandFlags = utility::concat(
+			commandInfo.cdbFlags, compilerFlags);
+		commandInfo.cdbFlags.clear();
+		commandInfo.cdbFlags.shrink_to_fit();
+
+		// the provider interns the flags, so equal flags of different commands are only stored once
+		provider->addCommand(std::make_shared<IndexerCommandCxx>(
+			commandInfo.sourcePath,
+			utility::concat(indexedHeaderPaths, {commandInfo.sourcePath}),
+			excludeFilters,
+			std::set<FilePathFilter>(),
+			commandInfo.workingDirectory,
+			commandFlags));
+	}
+
 	provider->logStats();
 
 	return provider;
@@ -160,6 +219,13 @@ std::shared_ptr<Task> SourceGroupCxxCdb::getPreIndexTask(
 {
 	if (m_settings->getPchInputFilePath().empty())
 	{
+		std::shared_ptr<CxxPreambleCache> preambleCache = m_preambleCache;
+		if (preambleCache && preambleCache->getPreambleCount() > 0)
+		{
+			return std::make_shared<TaskLambda>([preambleCache, storageProvider, dialogView]() {
+				preambleCache->buildPreambles(storageProvider, dialogView);
+			});
+		}
 		return std::make_shared<TaskLambda>([]() {});
 	}
 
@@ -168,7 +234,7 @@ std::shared_ptr<Task> SourceGroupCxxCdb::getPreIndexTask(
 	if (m_settings->getUseCompilerFlags())
 	{
 		const FilePath cdbPath = m_settings->getCompilationDatabasePathExpandedAndAbsolute();
-		std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = utility::loadCDB(cdbPath);
+		std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb = loadCDB();
 		if (cdb)
 		{
 			const std::set<FilePath> sourceFilePaths = getAllSourceFilePaths(cdb);
@@ -227,6 +293,13 @@ std::shared_ptr<Task> SourceGroupCxxCdb::getPreIndexTask(
 	return utility::createBuildPchTask(m_settings.get(), compilerFlags, storageProvider, dialogView);
 }
 
+void SourceGroupCxxCdb::clearCaches() const
+{
+	// the parsed database is only needed while refreshing and can take a lot of memory
+	std::lock_guard<std::mutex> lock(m_cdbCacheEntry->mutex);
+	m_cdbCacheEntry->cdb.reset();
+}
+
 std::shared_ptr<SourceGroupSettings> SourceGroupCxxCdb::getSourceGroupSettings()
 {
 	return m_settings;
@@ -257,3 +330,11 @@ std::vector<std::wstring> SourceGroupCxxCdb::getBaseCompilerFlags() const
 
 	return compilerFlags;
 }
+
+std::shared_ptr<clang::tooling::JSONCompilationDatabase> SourceGroupCxxCdb::loadCDB() const
+{
+	return utility::loadCDB(
+		m_settings->getCompilationDatabasePathExpandedAndAbsolute(),
+		nullptr,
+		m_cdbCacheEntry.get());
+}
@@ -16,7 +16,12 @@ class JSONCompilationDatabase;
 }
 }	 // namespace clang
 
+class CxxPreambleCache;
 class SourceGroupSettingsCxxCdb;
+namespace utility
+{
+struct CDBCacheEntry;
+}
 
 class SourceGroupCxxCdb: public SourceGroup
 {
@@ -34,13 +39,21 @@ public:
 	std::shared_ptr<Task> getPreIndexTask(
 		std::shared_ptr<StorageProvider> storageProvider,
 		std::shared_ptr<DialogView> dialogView) const override;
+	void clearCaches() const override;
 
 private:
 	std::shared_ptr<SourceGroupSettings> getSourceGroupSettings() override;
 	std::shared_ptr<const SourceGroupSettings> getSourceGroupSettings() const override;
 	std::vector<std::wstring> getBaseCompilerFlags() const;
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB() const;
 
 	std::shared_ptr<SourceGroupSettingsCxxCdb> m_settings;
+	std::shared_ptr<utility::CDBCacheEntry> m_cdbCacheEntry;
+
+	// preambles of the last created indexer command provider, only assigned there and built by the
+	// pre-index task. The provider only adds preamble flags to its commands for preambles that were
+	// built, so the commands stay valid no matter if and when the pre-index task runs.
+	mutable std::shared_ptr<CxxPreambleCache> m_preambleCache;
 };
 
 #endif	  // SOURCE_GROUP_CXX_CDB_H
@@ -1,5 +1,8 @@
 #include "utilitySourceGroupCxx.h"
 
+#include <map>
+#include <mutex>
+
 #include <clang/Tooling/JSONCompilationDatabase.h>
 
 #include "CanonicalFilePathCache.h"
@@ -11,7 +14,9 @@
 #include "FileRegister.h"
 #include "FileSystem.h"
 #include "GeneratePCHAction.h"
+#include "IntermediateStorage.h"
 #include "ParserClientImpl.h"
+#include "PreprocessorAction.h"
 #include "SingleFrontendActionFactory.h"
 #include "SourceGroupSettingsWithCxxPchOptions.h"
 #include "StorageProvider.h"
@@ -19,6 +24,54 @@
 #include "logging.h"
 #include "utility.h"
 
+namespace
+{
+std::shared_ptr<IntermediateStorage> runPchInputAction(
+	const FilePath& pchInputFilePath,
+	const FilePath& workingDirectory,
+	const std::vector<std::wstring>& compilerFlags,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters,
+	std::function<clang::FrontendAction*(
+		std::shared_ptr<ParserClient>, std::shared_ptr<CanonicalFilePathCache>)> createAction)
+{
+	CxxParser::initializeLLVM();
+
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<ParserClientImpl> client = std::make_shared<ParserClientImpl>(storage.get());
+
+	std::shared_ptr<FileRegister> fileRegister = std::make_shared<FileRegister>(
+		pchInputFilePath, indexedPaths, excludeFilters);
+
+	std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
+		std::make_shared<CanonicalFilePathCache>(fileRegister);
+
+	clang::tooling::CompileCommand pchCommand;
+	pchCommand.Filename = utility::encodeToUtf8(pchInputFilePath.fileName());
+	pchCommand.Directory = workingDirectory.str();
+	pchCommand.CommandLine = utility::concat(
+		{"clang-tool"}, CxxParser::getCommandlineArgumentsEssential(compilerFlags));
+
+	CxxCompilationDatabaseSingle compilationDatabase(pchCommand);
+	clang::tooling::ClangTool tool(
+		compilationDatabase, {utility::encodeToUtf8(pchInputFilePath.wstr())});
+	clang::FrontendAction* action = createAction(client, canonicalFilePathCache);
+
+	llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> options = new clang::DiagnosticOptions();
+	CxxDiagnosticConsumer diagnostics(
+		llvm::errs(), &*options, client, canonicalFilePathCache, pchInputFilePath, true);
+
+	tool.setDiagnosticConsumer(&diagnostics);
+	tool.clearArgumentsAdjusters();
+	tool.run(new SingleFrontendActionFactory(action));
+
+	return storage;
+}
+
+std::mutex s_cdbCacheEntriesMutex;
+std::map<FilePath, std::weak_ptr<utility::CDBCacheEntry>> s_cdbCacheEntries;
+}	 // namespace
+
 namespace utility
 {
 std::shared_ptr<Task> createBuildPchTask(
@@ -46,70 +99,127 @@ std::shared_ptr<Task> createBuildPchTask(
 										   .getConcatenated(pchInputFilePath.fileName())
 										   .replaceExtension(L"pch");
 
-	utility::removeIncludePchFlag(compilerFlags);
-	compilerFlags.push_back(pchInputFilePath.wstr());
-	compilerFlags.push_back(L"-emit-pch");
-	compilerFlags.push_back(L"-o");
-	compilerFlags.push_back(pchOutputFilePath.wstr());
-
 	return std::make_shared<TaskLambda>(
 		[dialogView, storageProvider, pchInputFilePath, pchOutputFilePath, compilerFlags]() {
 			dialogView->showUnknownProgressDialog(
 				L"Preparing Indexing", L"Processing Precompiled Headers");
-			LOG_INFO(
-				L"Generating precompiled header output for input file \"" +
-				pchInputFilePath.wstr() + L"\" at location \"" + pchOutputFilePath.wstr() + L"\"");
 
-			CxxParser::initializeLLVM();
+			storageProvider->insert(generatePrecompiledHeader(
+				pchInputFilePath,
+				pchOutputFilePath,
+				pchOutputFilePath.getParentDirectory(),
+				compilerFlags,
+				std::set<FilePath> {pchInputFilePath},
+				std::set<FilePathFilter> {}));
+		});
+}
 
-			if (!pchOutputFilePath.getParentDirectory().exists())
-			{
-				FileSystem::createDirectory(pchOutputFilePath.getParentDirectory());
-			}
+std::shared_ptr<IntermediateStorage> generatePrecompiledHeader(
+	const FilePath& pchInputFilePath,
+	const FilePath& pchOutputFilePath,
+	const FilePath& workingDirectory,
+	std::vector<std::wstring> compilerFlags,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters)
+{
+	LOG_INFO(
+		L"Generating precompiled header output for input file \"" + pchInputFilePath.wstr() +
+		L"\" at location \"" + pchOutputFilePath.wstr() + L"\"");
 
-			std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
-			std::shared_ptr<ParserClientImpl> client = std::make_shared<ParserClientImpl>(
-				storage.get());
+	if (!pchOutputFilePath.getParentDirectory().exists())
+	{
+		FileSystem::createDirectory(pchOutputFilePath.getParentDirectory());
+	}
 
-			std::shared_ptr<FileRegister> fileRegister = std::make_shared<FileRegister>(
-				pchInputFilePath, std::set<FilePath> {pchInputFilePath}, std::set<FilePathFilter> {});
+	utility::removeIncludePchFlag(compilerFlags);
+	compilerFlags.push_back(pchInputFilePath.wstr());
+	compilerFlags.push_back(L"-emit-pch");
+	compilerFlags.push_back(L"-o");
+	compilerFlags.push_back(pchOutputFilePath.wstr());
 
-			std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache =
-				std::make_shared<CanonicalFilePathCache>(fileRegister);
+	// DON'T use "-fsyntax-only" here because it will cause the output file to be erased
+	return runPchInputAction(
+		pchInputFilePath,
+		workingDirectory,
+		compilerFlags,
+		indexedPaths,
+		excludeFilters,
+		[](std::shared_ptr<ParserClient> client,
+		   std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache) {
+			return new GeneratePCHAction(client, canonicalFilePathCache);
+		});
+}
 
-			clang::tooling::CompileCommand pchCommand;
-			pchCommand.Filename = utility::encodeToUtf8(pchInputFilePath.fileName());
-			pchCommand.Directory = pchOutputFilePath.getParentDirectory().str();
-			// DON'T use "-fsyntax-only" here because it will cause the output file to be erased
-			pchCommand.CommandLine = utility::concat(
-				{"clang-tool"}, CxxParser::getCommandlineArgumentsEssential(compilerFlags));
+std::shared_ptr<IntermediateStorage> preprocessPrecompiledHeaderInput(
+	const FilePath& pchInputFilePath,
+	const FilePath& workingDirectory,
+	std::vector<std::wstring> compilerFlags,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters)
+{
+	utility::removeIncludePchFlag(compilerFlags);
+	compilerFlags.push_back(pchInputFilePath.wstr());
 
-			CxxCompilationDatabaseSingle compilationDatabase(pchCommand);
-			clang::tooling::ClangTool tool(
-				compilationDatabase, {utility::encodeToUtf8(pchInputFilePath.wstr())});
-			GeneratePCHAction* action = new GeneratePCHAction(client, canonicalFilePathCache);
+	return runPchInputAction(
+		pchInputFilePath,
+		workingDirectory,
+		compilerFlags,
+		indexedPaths,
+		excludeFilters,
+		[](std::shared_ptr<ParserClient> client,
+		   std::shared_ptr<CanonicalFilePathCache> canonicalFilePathCache) {
+			return new PreprocessorAction(client, canonicalFilePathCache);
+		});
+}
 
-			llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> options =
-				new clang::DiagnosticOptions();
-			CxxDiagnosticConsumer diagnostics(
-				llvm::errs(), &*options, client, canonicalFilePathCache, pchInputFilePath, true);
+std::shared_ptr<CDBCacheEntry> getCDBCacheEntry(const FilePath& cdbPath)
+{
+	std::lock_guard<std::mutex> lock(s_cdbCacheEntriesMutex);
 
-			tool.setDiagnosticConsumer(&diagnostics);
-			tool.clearArgumentsAdjusters();
-			tool.run(new SingleFrontendActionFactory(action));
+	for (auto it = s_cdbCacheEntries.begin(); it != s_cdbCacheEntries.end();)
+	{
+		if (it->second.expired())
+		{
+			it = s_cdbCacheEntries.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
 
-			storageProvider->insert(storage);
-		});
+	std::shared_ptr<CDBCacheEntry> entry = s_cdbCacheEntries[cdbPath].lock();
+	if (!entry)
+	{
+		entry = std::make_shared<CDBCacheEntry>();
+		s_cdbCacheEntries[cdbPath] = entry;
+	}
+	return entry;
 }
 
 std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB(
-	const FilePath& cdbPath, std::string* error)
+	const FilePath& cdbPath, std::string* error, CDBCacheEntry* cacheEntry)
 {
 	if (cdbPath.empty() || !cdbPath.exists())
 	{
 		return std::shared_ptr<clang::tooling::JSONCompilationDatabase>();
 	}
 
+	// the database is only parsed again if its file changed, because parsing large databases
+	// takes a lot of time and a single refresh asks for it multiple times
+	const TimeStamp lastWriteTime = FileSystem::getLastWriteTime(cdbPath);
+	const unsigned long long byteSize = FileSystem::getFileByteSize(cdbPath);
+	std::unique_lock<std::mutex> lock;
+	if (cacheEntry)
+	{
+		lock = std::unique_lock<std::mutex>(cacheEntry->mutex);
+		if (cacheEntry->cdb && cacheEntry->lastWriteTime == lastWriteTime &&
+			cacheEntry->byteSize == byteSize)
+		{
+			return cacheEntry->cdb;
+		}
+	}
+
 	std::string errorString;
 	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb =
 		std::shared_ptr<clang::tooling::JSONCompilationDatabase>(
@@ -123,6 +233,13 @@ std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB(
 		*error = errorString;
 	}
 
+	if (cacheEntry)
+	{
+		cacheEntry->lastWriteTime = lastWriteTime;
+		cacheEntry->byteSize = byteSize;
+		cacheEntry->cdb = cdb;
+	}
+
 	return cdb;
 }
 
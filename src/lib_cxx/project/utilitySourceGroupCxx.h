@@ -2,9 +2,13 @@
 #define UTILITY_SOURCE_GROUP_CXX_H
 
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "TimeStamp.h"
+
 namespace clang
 {
 namespace tooling
@@ -15,6 +19,8 @@ class JSONCompilationDatabase;
 
 class DialogView;
 class FilePath;
+class FilePathFilter;
+class IntermediateStorage;
 class SourceGroupSettingsWithCxxPchOptions;
 class StorageProvider;
 class Task;
@@ -27,8 +33,38 @@ std::shared_ptr<Task> createBuildPchTask(
 	std::shared_ptr<StorageProvider> storageProvider,
 	std::shared_ptr<DialogView> dialogView);
 
+// returns the preprocessor data recorded while generating the precompiled header
+std::shared_ptr<IntermediateStorage> generatePrecompiledHeader(
+	const FilePath& pchInputFilePath,
+	const FilePath& pchOutputFilePath,
+	const FilePath& workingDirectory,
+	std::vector<std::wstring> compilerFlags,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters);
+
+// records the same preprocessor data without generating the precompiled header again
+std::shared_ptr<IntermediateStorage> preprocessPrecompiledHeaderInput(
+	const FilePath& pchInputFilePath,
+	const FilePath& workingDirectory,
+	std::vector<std::wstring> compilerFlags,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters);
+
+// last parsed version of a compilation database, which is only parsed again if its file changes
+struct CDBCacheEntry
+{
+	std::mutex mutex;
+	TimeStamp lastWriteTime;
+	unsigned long long byteSize = 0;
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb;
+};
+
+// all callers for the same database share one entry, which is dropped together with the last of
+// them, so only the databases of the source groups of the loaded project stay in memory
+std::shared_ptr<CDBCacheEntry> getCDBCacheEntry(const FilePath& cdbPath);
+
 std::shared_ptr<clang::tooling::JSONCompilationDatabase> loadCDB(
-	const FilePath& cdbPath, std::string* error = nullptr);
+	const FilePath& cdbPath, std::string* error = nullptr, CDBCacheEntry* cacheEntry = nullptr);
 bool containsIncludePchFlags(std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb);
 bool containsIncludePchFlag(const std::vector<std::string>& args);
 std::vector<std::wstring> getWithRemoveIncludePchFlag(const std::vector<std::wstring>& args);
@@ -10,6 +10,7 @@
 #include "IncludeDirective.h"
 #include "TextAccess.h"
 #include "TextCodec.h"
+#include "ThreadPool.h"
 #include "utility.h"
 #include "utilityString.h"
 
@@ -97,10 +98,10 @@ std::set<FilePath> IncludeProcessing::getHeaderSearchDirectories(
 
 			std::set<FilePath> unprocessedFilePathsForNextIteration;
 
-			for (const FilePath& unprocessedFilePath: unprocessedFilePaths)
+			for (const std::vector<IncludeDirective>& includeDirectives:
+				 getIncludeDirectivesInParallel(unprocessedFilePaths))
 			{
-				for (const IncludeDirective& includeDirective:
-					 getIncludeDirectives(unprocessedFilePath))
+				for (const IncludeDirective& includeDirective: includeDirectives)
 				{
 					const FilePath includedFilePath = includeDirective.getIncludedFile();
 
@@ -194,6 +195,18 @@ std::vector<IncludeDirective> IncludeProcessing::getIncludeDirectives(
 	return includeDirectives;
 }
 
+std::vector<std::vector<IncludeDirective>> IncludeProcessing::getIncludeDirectivesInParallel(
+	const std::set<FilePath>& filePaths)
+{
+	// reading the files dominates, their sizes vary a lot, so they are handed out one by one
+	const std::vector<FilePath> filePathVector = utility::toVector(filePaths);
+	std::vector<std::vector<IncludeDirective>> includeDirectives(filePathVector.size());
+	ThreadPool::getInstance()->forEachIndex(filePathVector.size(), [&](size_t i) {
+		includeDirectives[i] = getIncludeDirectives(filePathVector[i]);
+	});
+	return includeDirectives;
+}
+
 std::vector<IncludeDirective> IncludeProcessing::doGetUnresolvedIncludeDirectives(
 	std::set<FilePath> filePathsToProcess,
 	std::unordered_set<std::wstring>& processedFilePaths,
@@ -212,12 +225,27 @@ std::vector<IncludeDirective> IncludeProcessing::doGetUnresolvedIncludeDirective
 
 		std::set<FilePath> filePathsToProcessForNextIteration;
 
-		for (const FilePath& filePath: filePathsToProcess)
+		// resolving checks the file system for every search directory, so it runs in parallel too
+		const std::vector<FilePath> filePaths = utility::toVector(filePathsToProcess);
+		std::vector<std::vector<std::pair<IncludeDirective, FilePath>>> resolvedIncludes(
+			filePaths.size());
+		ThreadPool::getInstance()->forEachIndex(filePaths.size(), [&](size_t i) {
+			for (const IncludeDirective& includeDirective: getIncludeDirectives(filePaths[i]))
+			{
+				resolvedIncludes[i].emplace_back(
+					includeDirective,
+					resolveIncludeDirective(includeDirective, headerSearchDirectories)
+						.makeCanonical());
+			}
+		});
+
+		for (const std::vector<std::pair<IncludeDirective, FilePath>>& fileIncludes:
+			 resolvedIncludes)
 		{
-			for (const IncludeDirective& includeDirective: getIncludeDirectives(filePath))
+			for (const std::pair<IncludeDirective, FilePath>& resolvedInclude: fileIncludes)
 			{
-				const FilePath resolvedIncludePath =
-					resolveIncludeDirective(includeDirective, headerSearchDirectories).makeCanonical();
+				const IncludeDirective& includeDirective = resolvedInclude.first;
+				const FilePath& resolvedIncludePath = resolvedInclude.second;
 				if (resolvedIncludePath.empty())
 				{
 					unresolvedIncludeDirectives.push_back(includeDirective);
@@ -34,6 +34,9 @@ public:
 	static std::vector<IncludeDirective> getIncludeDirectives(std::shared_ptr<TextAccess> textAccess);
 
 private:
+	static std::vector<std::vector<IncludeDirective>> getIncludeDirectivesInParallel(
+		const std::set<FilePath>& filePaths);
+
 	static std::vector<IncludeDirective> doGetUnresolvedIncludeDirectives(
 		std::set<FilePath> filePathsToProcess,
 		std::unordered_set<std::wstring>& processedFilePaths,
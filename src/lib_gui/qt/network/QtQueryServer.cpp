@@ -0,0 +1,116 @@
+#include "QtQueryServer.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMetaObject>
+
+#include "StorageQueryHandler.h"
+#include "ThreadPool.h"
+#include "logging.h"
+
+QtQueryServer::QtQueryServer(std::shared_ptr<const StorageQueryHandler> handler, QObject* parent)
+	: QObject(parent), m_handler(handler)
+{
+	m_server = new QLocalServer(this);
+
+	connect(m_server, &QLocalServer::newConnection, this, &QtQueryServer::acceptConnection);
+}
+
+QtQueryServer::~QtQueryServer()
+{
+	std::unique_lock<std::mutex> lock(m_runningQueryMutex);
+	m_runningQueryCondition.wait(lock, [this]() { return m_runningQueryCount == 0; });
+}
+
+bool QtQueryServer::listen(const std::string& serverName)
+{
+	// a server that has not been shut down cleanly leaves its socket file behind
+	QLocalServer::removeServer(QString::fromStdString(serverName));
+
+	if (!m_server->listen(QString::fromStdString(serverName)))
+	{
+		LOG_ERROR_STREAM(
+			<< "Query server failed to start with error: \""
+			<< m_server->errorString().toStdString() << "\"");
+		return false;
+	}
+
+	LOG_INFO_STREAM(<< "Query server listening on " << m_server->fullServerName().toStdString());
+	return true;
+}
+
+void QtQueryServer::acceptConnection()
+{
+	while (m_server->hasPendingConnections())
+	{
+		QLocalSocket* socket = m_server->nextPendingConnection();
+
+		connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+			answerRequests(socket);
+		});
+		connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+			m_busySockets.erase(socket);
+		});
+		connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+
+		// requests may have arrived before the signals got connected
+		answerRequests(socket);
+	}
+}
+
+void QtQueryServer::answerRequests(QLocalSocket* socket)
+{
+	if (m_busySockets.find(socket) != m_busySockets.end())
+	{
+		return;
+	}
+
+	while (socket->canReadLine())
+	{
+		const std::string request = socket->readLine().trimmed().toStdString();
+		if (request.empty())
+		{
+			continue;
+		}
+
+		m_busySockets.insert(socket);
+		{
+			std::lock_guard<std::mutex> lock(m_runningQueryMutex);
+			m_runningQueryCount++;
+		}
+
+		std::shared_ptr<const StorageQueryHandler> handler = m_handler;
+		QPointer<QLocalSocket> socketPointer(socket);
+		ThreadPool::getInstance()->execute([this, handler, socketPointer, request]() {
+			const std::string response = handler->handleRequest(request);
+
+			// the socket may only be used on the thread of the server
+			QMetaObject::invokeMethod(
+				this,
+				[this, socketPointer, response]() { sendResponse(socketPointer, response); },
+				Qt::QueuedConnection);
+
+			std::lock_guard<std::mutex> lock(m_runningQueryMutex);
+			m_runningQueryCount--;
+			m_runningQueryCondition.notify_all();
+		});
+		return;
+	}
+}
+
+void QtQueryServer::sendResponse(QPointer<QLocalSocket> socket, const std::string& response)
+{
+	// the client disconnected while its query was running
+	if (!socket)
+	{
+		return;
+	}
+
+	m_busySockets.erase(socket.data());
+
+	socket->write(response.c_str(), response.size());
+	socket->write("\n", 1);
+	socket->flush();
+
+	answerRequests(socket.data());
+}
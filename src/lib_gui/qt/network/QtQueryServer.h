@@ -0,0 +1,50 @@
+#ifndef QT_QUERY_SERVER_H
+#define QT_QUERY_SERVER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <QObject>
+#include <QPointer>
+
+class QLocalServer;
+class QLocalSocket;
+class StorageQueryHandler;
+
+// Serves queries on a local socket (a Unix domain socket or a named pipe on Windows). Clients may
+// stay connected and send any number of requests, each on its own line. Every request is answered
+// by a single line in the order the requests arrived. Queries run on the ThreadPool, the requests
+// of one client one after another and the ones of different clients at the same time.
+class QtQueryServer: public QObject
+{
+	Q_OBJECT
+
+public:
+	QtQueryServer(std::shared_ptr<const StorageQueryHandler> handler, QObject* parent = nullptr);
+	~QtQueryServer();
+
+	bool listen(const std::string& serverName);
+
+private slots:
+	void acceptConnection();
+
+private:
+	// starts the next request of the socket, unless one of its requests is still running
+	void answerRequests(QLocalSocket* socket);
+	void sendResponse(QPointer<QLocalSocket> socket, const std::string& response);
+
+	std::shared_ptr<const StorageQueryHandler> m_handler;
+	QLocalServer* m_server;
+
+	std::set<QLocalSocket*> m_busySockets;
+
+	// running queries post their response to the server, so it waits for them when destroyed
+	size_t m_runningQueryCount = 0;
+	std::mutex m_runningQueryMutex;
+	std::condition_variable m_runningQueryCondition;
+};
+
+#endif	  // QT_QUERY_SERVER_H
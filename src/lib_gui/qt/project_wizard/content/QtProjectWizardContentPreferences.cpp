@@ -238,6 +238,15 @@ void QtProjectWizardContentPreferences::populate(QGridLayout* layout, int& row)
 		layout,
 		row);
 
+	m_tracingEnabled = addCheckBox(
+		"Tracing",
+		"Enable performance tracing",
+		"<p>Record the time spent in Sourcetrail and its indexer processes. The trace is saved to "
+		"the log directory when Sourcetrail quits and can be opened with chrome://tracing or "
+		"Perfetto.</p>",
+		layout,
+		row);
+
 	addGap(layout, row);
 
 	// Network
@@ -306,6 +315,38 @@ void QtProjectWizardContentPreferences::populate(QGridLayout* layout, int& row)
 		layout,
 		row);
 
+	// indexing memory budget
+	m_indexingMemoryBudget = addLineEdit(
+		"Memory Budget (MB)",
+		"<p>Limits the memory used by indexed data that still waits to be written to the project "
+		"database. Indexers pause when the limit is reached.</p>"
+		"<p>0 means that the memory is not limited.</p>",
+		layout,
+		row);
+
+	// automatic preambles
+	m_cxxAutomaticPreambles = addCheckBox(
+		"Automatic<br />C/C++ Preambles",
+		"Precompile includes shared by source files",
+		"<p>Detect the leading includes that C/C++ source files with equal compiler flags have in "
+		"common and precompile them once for all of these files.</p>"
+		"<p>This speeds up indexing projects with many source files that include the same headers. "
+		"The precompiled headers are kept in the project's files and reused by following indexing "
+		"runs as long as the included headers don't change.</p>",
+		layout,
+		row);
+
+	// background indexing
+	m_backgroundIndexing = addCheckBox(
+		"Background Indexing",
+		"Index changed files automatically",
+		"<p>Watch the files of the loaded project and index files that were changed, together with "
+		"the files depending on them, in the background after they were saved.</p>"
+		"<p>New source files are still picked up by a manual refresh. Changing this setting takes "
+		"effect when the project is loaded the next time.</p>",
+		layout,
+		row);
+
 	addGap(layout, row);
 
 
@@ -489,6 +530,7 @@ void QtProjectWizardContentPreferences::load()
 	m_loggingEnabled->setChecked(appSettings->getLoggingEnabled());
 	m_verboseIndexerLoggingEnabled->setChecked(appSettings->getVerboseIndexerLoggingEnabled());
 	m_verboseIndexerLoggingEnabled->setEnabled(m_loggingEnabled->isChecked());
+	m_tracingEnabled->setChecked(appSettings->getTracingEnabled());
 
 	m_automaticUpdateCheck->setChecked(appSettings->getAutomaticUpdateCheck());
 
@@ -499,6 +541,9 @@ void QtProjectWizardContentPreferences::load()
 		appSettings->getIndexerThreadCount());	  // index and value are the same
 	indexerThreadsChanges(m_threads->currentIndex());
 	m_multiProcessIndexing->setChecked(appSettings->getMultiProcessIndexingEnabled());
+	m_indexingMemoryBudget->setText(QString::number(appSettings->getIndexingMemoryBudget()));
+	m_cxxAutomaticPreambles->setChecked(appSettings->getCxxAutomaticPreamblesEnabled());
+	m_backgroundIndexing->setChecked(appSettings->getBackgroundIndexingEnabled());
 
 	if (m_javaPath)
 	{
@@ -552,6 +597,7 @@ void QtProjectWizardContentPreferences::save()
 
 	appSettings->setLoggingEnabled(m_loggingEnabled->isChecked());
 	appSettings->setVerboseIndexerLoggingEnabled(m_verboseIndexerLoggingEnabled->isChecked());
+	appSettings->setTracingEnabled(m_tracingEnabled->isChecked());
 
 	appSettings->setAutomaticUpdateCheck(m_automaticUpdateCheck->isChecked());
 
@@ -565,6 +611,9 @@ void QtProjectWizardContentPreferences::save()
 
 	appSettings->setIndexerThreadCount(m_threads->currentIndex());	  // index and value are the same
 	appSettings->setMultiProcessIndexingEnabled(m_multiProcessIndexing->isChecked());
+	appSettings->setIndexingMemoryBudget(m_indexingMemoryBudget->text().toInt());
+	appSettings->setCxxAutomaticPreamblesEnabled(m_cxxAutomaticPreambles->isChecked());
+	appSettings->setBackgroundIndexingEnabled(m_backgroundIndexing->isChecked());
 
 	if (m_javaPath)
 	{
@@ -114,6 +114,7 @@ private:
 
 	QCheckBox* m_loggingEnabled;
 	QCheckBox* m_verboseIndexerLoggingEnabled;
+	QCheckBox* m_tracingEnabled;
 
 	QCheckBox* m_automaticUpdateCheck;
 
@@ -124,6 +125,9 @@ private:
 	QLabel* m_threadsInfoLabel;
 
 	QCheckBox* m_multiProcessIndexing;
+	QLineEdit* m_indexingMemoryBudget;
+	QCheckBox* m_cxxAutomaticPreambles;
+	QCheckBox* m_backgroundIndexing;
 
 	std::shared_ptr<CombinedPathDetector> m_javaPathDetector;
 	std::shared_ptr<CombinedPathDetector> m_jreSystemLibraryPathsDetector;
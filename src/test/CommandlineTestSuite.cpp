@@ -98,5 +98,35 @@ TEST_CASE("command line")
 		REQUIRE(processes == 1);
 	}
 
+	SECTION("command index shard")
+	{
+		std::vector<std::string> args({"index", "--shard", "2/4"});
+
+		commandline::CommandLineParser parser("2");
+		parser.preparse(args);
+		parser.parse();
+
+		REQUIRE(!parser.exitApplication());
+		REQUIRE(parser.getIndexingShardIndex() == 1);
+		REQUIRE(parser.getIndexingShardCount() == 4);
+	}
+
+	SECTION("command index invalid shard")
+	{
+		std::vector<std::string> args({"index", "--shard", "5/4"});
+
+		std::stringstream redStream;
+		auto oldBuf = std::cerr.rdbuf(redStream.rdbuf());
+
+		commandline::CommandLineParser parser("2");
+		parser.preparse(args);
+		parser.parse();
+
+		std::cerr.rdbuf(oldBuf);
+
+		REQUIRE(parser.exitApplication());
+		REQUIRE(parser.getIndexingShardCount() == 1);
+	}
+
 	ApplicationSettings::getInstance()->load(appSettingsPath);
 }
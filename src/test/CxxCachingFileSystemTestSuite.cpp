@@ -0,0 +1,188 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+
+#	include <fstream>
+#	include <map>
+
+#	include <clang/Basic/Diagnostic.h>
+#	include <clang/Frontend/FrontendActions.h>
+#	include <clang/Tooling/CompilationDatabase.h>
+#	include <clang/Tooling/Tooling.h>
+#	include <llvm/Support/Path.h>
+
+#	include "CxxCachingFileSystem.h"
+#	include "FileSystem.h"
+
+namespace
+{
+// passes everything on to the real file system and counts how often each file was opened
+class CountingFileSystem: public llvm::vfs::ProxyFileSystem
+{
+public:
+	CountingFileSystem(): llvm::vfs::ProxyFileSystem(llvm::vfs::getRealFileSystem()) {}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+		const llvm::Twine& Path) override
+	{
+		readCounts[llvm::sys::path::filename(Path.str()).str()]++;
+		return ProxyFileSystem::openFileForRead(Path);
+	}
+
+	mutable std::map<std::string, size_t> readCounts;
+};
+
+class TestFiles
+{
+public:
+	TestFiles(): m_directoryPath(FilePath(L"data/CxxCachingFileSystemTestSuite").getAbsolute())
+	{
+		FileSystem::createDirectory(m_directoryPath);
+	}
+
+	~TestFiles()
+	{
+		for (const FilePath& filePath: m_filePaths)
+		{
+			FileSystem::remove(filePath);
+		}
+		FileSystem::remove(m_directoryPath);
+	}
+
+	FilePath writeFile(const std::wstring& fileName, const std::string& text)
+	{
+		const FilePath filePath = m_directoryPath.getConcatenated(fileName);
+		{
+			std::ofstream file(filePath.str());
+			file << text;
+		}
+		m_filePaths.push_back(filePath);
+		return filePath;
+	}
+
+private:
+	const FilePath m_directoryPath;
+	std::vector<FilePath> m_filePaths;
+};
+
+// several file systems sharing one cache on top of a file system that counts the reads from disk
+class TestFileSystems
+{
+public:
+	TestFileSystems(size_t maxBufferByteSize)
+		: m_baseFileSystem(new CountingFileSystem())
+		, m_cache(std::make_shared<CxxCachingFileSystem::Cache>(maxBufferByteSize))
+	{
+	}
+
+	// runs a syntax only tool on its own caching file system, like the indexer does for every
+	// translation unit
+	bool runTool(const FilePath& sourceFilePath)
+	{
+		clang::tooling::FixedCompilationDatabase compilationDatabase(
+			sourceFilePath.getParentDirectory().str(), std::vector<std::string>());
+		clang::tooling::ClangTool tool(
+			compilationDatabase,
+			std::vector<std::string>(1, sourceFilePath.str()),
+			std::make_shared<clang::PCHContainerOperations>(),
+			new CxxCachingFileSystem(m_baseFileSystem, m_cache));
+
+		clang::IgnoringDiagConsumer diagnostics;
+		tool.setDiagnosticConsumer(&diagnostics);
+
+		return !tool.run(clang::tooling::newFrontendActionFactory<clang::SyntaxOnlyAction>().get());
+	}
+
+	std::string readFile(const FilePath& filePath)
+	{
+		CxxCachingFileSystem fileSystem(m_baseFileSystem, m_cache);
+		llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> file = fileSystem.openFileForRead(
+			filePath.str());
+		if (!file)
+		{
+			return "";
+		}
+
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = (*file)->getBuffer(
+			filePath.str());
+		return buffer ? (*buffer)->getBuffer().str() : "";
+	}
+
+	size_t getReadCount(const std::string& fileName) const
+	{
+		return m_baseFileSystem->readCounts[fileName];
+	}
+
+	size_t getBufferByteSize() const
+	{
+		return m_cache->getBufferByteSize();
+	}
+
+private:
+	llvm::IntrusiveRefCntPtr<CountingFileSystem> m_baseFileSystem;
+	std::shared_ptr<CxxCachingFileSystem::Cache> m_cache;
+};
+}	 // namespace
+
+TEST_CASE("caching file system reads header included by two tools from disk once")
+{
+	TestFiles files;
+	files.writeFile(L"header.h", "int foo();\n");
+	const FilePath firstSourceFilePath = files.writeFile(
+		L"first.cpp", "#include \"header.h\"\nint a = foo();\n");
+	const FilePath secondSourceFilePath = files.writeFile(
+		L"second.cpp", "#include \"header.h\"\nint b = foo();\n");
+
+	TestFileSystems fileSystems(1024 * 1024);
+	REQUIRE(fileSystems.runTool(firstSourceFilePath));
+	REQUIRE(fileSystems.runTool(secondSourceFilePath));
+
+	REQUIRE(fileSystems.getReadCount("header.h") == 1);
+}
+
+TEST_CASE("caching file system reads file from disk once")
+{
+	TestFiles files;
+	const FilePath filePath = files.writeFile(L"header.h", "int foo();\n");
+
+	TestFileSystems fileSystems(1024 * 1024);
+	REQUIRE(fileSystems.readFile(filePath) == "int foo();\n");
+	REQUIRE(fileSystems.readFile(filePath) == "int foo();\n");
+
+	REQUIRE(fileSystems.getReadCount("header.h") == 1);
+	REQUIRE(fileSystems.getBufferByteSize() == std::string("int foo();\n").size());
+}
+
+TEST_CASE("caching file system reads changed file from disk again")
+{
+	TestFiles files;
+	const FilePath filePath = files.writeFile(L"header.h", "int foo();\n");
+
+	TestFileSystems fileSystems(1024 * 1024);
+	REQUIRE(fileSystems.readFile(filePath) == "int foo();\n");
+
+	files.writeFile(L"header.h", "int foo(int bar);\n");
+
+	REQUIRE(fileSystems.readFile(filePath) == "int foo(int bar);\n");
+	REQUIRE(fileSystems.readFile(filePath) == "int foo(int bar);\n");
+
+	REQUIRE(fileSystems.getReadCount("header.h") == 2);
+	REQUIRE(fileSystems.getBufferByteSize() == std::string("int foo(int bar);\n").size());
+}
+
+TEST_CASE("caching file system does not cache files beyond its size limit")
+{
+	TestFiles files;
+	const FilePath filePath = files.writeFile(L"header.h", "int foo();\n");
+
+	TestFileSystems fileSystems(4);
+	REQUIRE(fileSystems.readFile(filePath) == "int foo();\n");
+	REQUIRE(fileSystems.readFile(filePath) == "int foo();\n");
+
+	REQUIRE(fileSystems.getReadCount("header.h") == 2);
+	REQUIRE(fileSystems.getBufferByteSize() == 0);
+}
+
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
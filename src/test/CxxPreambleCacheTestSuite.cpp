@@ -0,0 +1,225 @@
+#include "catch.hpp"
+
+#include "language_packages.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+
+#	include <fstream>
+
+#	include "CxxPreambleCache.h"
+#	include "FileSystem.h"
+
+namespace
+{
+const FilePath s_directoryPath(L"data/CxxPreambleCacheTestSuite");
+
+class TestFiles
+{
+public:
+	TestFiles()
+	{
+		FileSystem::createDirectory(s_directoryPath);
+	}
+
+	~TestFiles()
+	{
+		for (const FilePath& filePath: m_filePaths)
+		{
+			FileSystem::remove(filePath);
+		}
+		FileSystem::remove(s_directoryPath);
+	}
+
+	FilePath addFile(const std::wstring& fileName, const std::string& text)
+	{
+		const FilePath filePath = s_directoryPath.getConcatenated(fileName);
+		std::ofstream file(filePath.str());
+		file << text;
+		m_filePaths.push_back(filePath);
+		return filePath;
+	}
+
+private:
+	std::vector<FilePath> m_filePaths;
+};
+
+std::vector<std::string> getLeadingIncludeDirectives(const std::string& text)
+{
+	TestFiles files;
+	return CxxPreambleCache::getLeadingIncludeDirectives(files.addFile(L"main.cpp", text));
+}
+
+// adds a source file with the given includes for each of the compiler flags and returns the number
+// of preambles created for them
+size_t getPreambleCount(
+	const std::vector<std::string>& includes,
+	const std::vector<std::vector<std::wstring>>& compilerFlags)
+{
+	TestFiles files;
+	CxxPreambleCache cache(s_directoryPath.getConcatenated(L"cache"), {}, {});
+	for (size_t i = 0; i < compilerFlags.size(); i++)
+	{
+		const FilePath filePath = files.addFile(
+			L"main" + std::to_wstring(i) + L".cpp",
+			includes[i % includes.size()] + "\nint main() {}\n");
+		cache.addTranslationUnit(filePath, s_directoryPath, compilerFlags[i]);
+	}
+
+	cache.createPreambles();
+	return cache.getPreambleCount();
+}
+}	 // namespace
+
+TEST_CASE("preamble cache finds leading includes")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#include \"foo.h\"\n\nint a;\n") ==
+		std::vector<std::string>({"#include <vector>", "#include \"foo.h\""}));
+}
+
+TEST_CASE("preamble cache finds leading includes with spaces inside directive")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("  #  include   <vector>  \n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache finds leading includes between comments")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("// header\n/* license\n#include <map>\n*/\n"
+									"#include <vector> // comment\n"
+									"/* a */ #include <set> /* b */\n") ==
+		std::vector<std::string>({"#include <vector>", "#include <set>"}));
+}
+
+TEST_CASE("preamble cache skips pragma once before leading includes")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#pragma once\n#include <vector>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache stops leading includes at code")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\nint a;\n#include <map>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache stops leading includes at other directives")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#define FOO\n#include <map>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#pragma pack(1)\n#include <map>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache stops leading includes at include next")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#include_next <map>\n#include <set>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache stops leading includes at import")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#import <Foo/Foo.h>\n#include <set>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache stops leading includes at macro includes")
+{
+	REQUIRE(
+		getLeadingIncludeDirectives("#include <vector>\n#include HEADER\n#include <set>\n") ==
+		std::vector<std::string>({"#include <vector>"}));
+}
+
+TEST_CASE("preamble cache finds no leading includes in missing file")
+{
+	REQUIRE(CxxPreambleCache::getLeadingIncludeDirectives(
+				s_directoryPath.getConcatenated(L"missing.cpp"))
+				.empty());
+}
+
+TEST_CASE("preamble compiler flags drop compiler, output and source file")
+{
+	REQUIRE(
+		CxxPreambleCache::getPreambleCompilerFlags(
+			FilePath(L"src/main.cpp"),
+			{L"clang++",
+			 L"-c",
+			 L"-DFOO",
+			 L"-o",
+			 L"main.o",
+			 L"-MD",
+			 L"-MF",
+			 L"main.d",
+			 L"-Iinclude",
+			 L"src/main.cpp"},
+			false) == std::vector<std::wstring>({L"-DFOO", L"-Iinclude", L"-x", L"c++-header"}));
+}
+
+TEST_CASE("preamble compiler flags compile header of source file language")
+{
+	REQUIRE(
+		CxxPreambleCache::getPreambleCompilerFlags(FilePath(L"main.c"), {L"-DFOO"}, false) ==
+		std::vector<std::wstring>({L"-DFOO", L"-x", L"c-header"}));
+	REQUIRE(
+		CxxPreambleCache::getPreambleCompilerFlags(FilePath(L"main.mm"), {}, false) ==
+		std::vector<std::wstring>({L"-x", L"objective-c++-header"}));
+	REQUIRE(
+		CxxPreambleCache::getPreambleCompilerFlags(FilePath(L"main.c"), {L"-x", L"c++"}, false) ==
+		std::vector<std::wstring>({L"-x", L"c++", L"-x", L"c++-header"}));
+}
+
+TEST_CASE("preamble compiler flags look up quoted includes next to source file")
+{
+	const FilePath sourceFilePath(L"src/main.cpp");
+	REQUIRE(
+		CxxPreambleCache::getPreambleCompilerFlags(sourceFilePath, {}, true) ==
+		std::vector<std::wstring>(
+			{L"-x", L"c++-header", L"-iquote", sourceFilePath.getParentDirectory().wstr()}));
+}
+
+TEST_CASE("preamble cache creates preamble for includes shared by three translation units")
+{
+	REQUIRE(getPreambleCount({"#include <vector>"}, {{L"-DFOO"}, {L"-DFOO"}, {L"-DFOO"}}) == 1);
+}
+
+TEST_CASE("preamble cache creates no preamble for includes shared by two translation units")
+{
+	REQUIRE(getPreambleCount({"#include <vector>"}, {{L"-DFOO"}, {L"-DFOO"}}) == 0);
+}
+
+TEST_CASE("preamble cache creates no preamble for translation units with different flags")
+{
+	REQUIRE(getPreambleCount({"#include <vector>"}, {{L"-DFOO"}, {L"-DFOO"}, {L"-DBAR"}}) == 0);
+}
+
+TEST_CASE("preamble cache creates no preamble for translation units without includes")
+{
+	REQUIRE(getPreambleCount({"int a;"}, {{}, {}, {}}) == 0);
+}
+
+TEST_CASE("preamble cache groups translation units by their shared include prefix")
+{
+	// the second include is only shared by two units each, so all of them use the first one
+	REQUIRE(
+		getPreambleCount(
+			{"#include <vector>\n#include <map>", "#include <vector>\n#include <set>"},
+			{{}, {}, {}, {}}) == 1);
+}
+
+TEST_CASE("preamble cache creates preambles for the longest shared include prefixes")
+{
+	REQUIRE(
+		getPreambleCount(
+			{"#include <vector>\n#include <map>", "#include <vector>\n#include <set>"},
+			{{}, {}, {}, {}, {}, {}}) == 2);
+}
+
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
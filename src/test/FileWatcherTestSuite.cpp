@@ -0,0 +1,97 @@
+#include "catch.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+
+#include "FileSystem.h"
+#include "FileWatcher.h"
+
+namespace
+{
+class FileChangeCollector
+{
+public:
+	void onFilesChanged(const std::set<FilePath>& filePaths)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_callbackCount++;
+		m_filePaths.insert(filePaths.begin(), filePaths.end());
+		m_condition.notify_all();
+	}
+
+	bool waitForCallback()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_condition.wait_for(
+			lock, std::chrono::seconds(5), [this]() { return m_callbackCount > 0; });
+	}
+
+	size_t getCallbackCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_callbackCount;
+	}
+
+	std::set<FilePath> getFilePaths()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_filePaths;
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	size_t m_callbackCount = 0;
+	std::set<FilePath> m_filePaths;
+};
+
+void writeFile(const FilePath& filePath, const std::string& text)
+{
+	std::ofstream file(filePath.str());
+	file << text;
+}
+}	 // namespace
+
+TEST_CASE("file watcher reports changes of several files in one callback")
+{
+	if (!FileWatcher::isSupported())
+	{
+		return;
+	}
+
+	const FilePath directoryPath = FilePath(L"data/FileWatcherTestSuite").getAbsolute();
+	FileSystem::createDirectory(directoryPath);
+
+	const FilePath changedFilePath = directoryPath.getConcatenated(L"changed.cpp");
+	const FilePath createdFilePath = directoryPath.getConcatenated(L"created.h");
+	writeFile(changedFilePath, "int a;");
+
+	FileChangeCollector collector;
+	{
+		FileWatcher watcher(200, [&collector](const std::set<FilePath>& filePaths) {
+			collector.onFilesChanged(filePaths);
+		});
+		REQUIRE(watcher.start({directoryPath}));
+
+		writeFile(changedFilePath, "int b;");
+		writeFile(createdFilePath, "int c;");
+
+		REQUIRE(collector.waitForCallback());
+	}
+
+	REQUIRE(collector.getCallbackCount() == 1);
+	REQUIRE(collector.getFilePaths() == std::set<FilePath>({changedFilePath, createdFilePath}));
+
+	FileSystem::remove(changedFilePath);
+	FileSystem::remove(createdFilePath);
+	FileSystem::remove(directoryPath);
+}
+
+TEST_CASE("file watcher does not start without existing directories")
+{
+	FileWatcher watcher(200, [](const std::set<FilePath>& filePaths) {});
+	REQUIRE(!watcher.start({FilePath(L"data/FileWatcherTestSuite/missing")}));
+	REQUIRE(!watcher.isRunning());
+}
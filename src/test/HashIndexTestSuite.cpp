@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "HashIndex.h"
+
+namespace
+{
+struct Record
+{
+	Record(std::wstring name, int value): name(std::move(name)), value(value) {}
+
+	operator const std::wstring &() const
+	{
+		return name;
+	}
+
+	std::wstring name;
+	int value;
+};
+}	 // namespace
+
+TEST_CASE("hash index does not find elements when empty")
+{
+	HashIndex<std::wstring> index;
+	std::vector<std::wstring> values;
+
+	REQUIRE(index.find(L"foo", values) == HashIndex<std::wstring>::s_notFound);
+	REQUIRE(index.size() == 0);
+}
+
+TEST_CASE("hash index finds inserted elements by position")
+{
+	HashIndex<std::wstring> index;
+	std::vector<std::wstring> values;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		values.push_back(L"name" + std::to_wstring(i));
+		index.insert(values.size() - 1, values);
+	}
+
+	REQUIRE(index.size() == 1000);
+	REQUIRE(index.find(L"name0", values) == 0);
+	REQUIRE(index.find(L"name537", values) == 537);
+	REQUIRE(index.find(L"name999", values) == 999);
+	REQUIRE(index.find(L"name1000", values) == HashIndex<std::wstring>::s_notFound);
+}
+
+TEST_CASE("hash index finds records by converted key")
+{
+	HashIndex<std::wstring> index;
+	std::vector<Record> records;
+
+	records.emplace_back(L"a", 1);
+	index.insert(0, records);
+	records.emplace_back(L"b", 2);
+	index.insert(1, records);
+
+	REQUIRE(records[index.find(L"b", records)].value == 2);
+}
+
+TEST_CASE("hash index rebuild keeps first of equal elements")
+{
+	HashIndex<std::wstring> index;
+	const std::vector<std::wstring> values = {L"a", L"b", L"a", L"c"};
+
+	index.rebuild(values);
+
+	REQUIRE(index.size() == 3);
+	REQUIRE(index.find(L"a", values) == 0);
+	REQUIRE(index.find(L"c", values) == 3);
+
+	index.clear();
+
+	REQUIRE(index.size() == 0);
+	REQUIRE(index.find(L"a", values) == HashIndex<std::wstring>::s_notFound);
+}
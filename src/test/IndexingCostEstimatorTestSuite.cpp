@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include <fstream>
+
+#include "FileSystem.h"
+#include "IndexingCostEstimator.h"
+
+namespace
+{
+void writeFile(const FilePath& filePath, size_t byteSize)
+{
+	std::ofstream file(filePath.str());
+	file << std::string(byteSize, 'x');
+}
+}	 // namespace
+
+TEST_CASE("indexing cost estimator orders files by recorded wall time")
+{
+	const IndexingCostEstimator estimator(
+		{StorageIndexingCost(L"data/IndexingCostEstimatorTestSuite/a.cpp", 100, 0, 0),
+		 StorageIndexingCost(L"data/IndexingCostEstimatorTestSuite/b.cpp", 500, 0, 0),
+		 StorageIndexingCost(L"data/IndexingCostEstimatorTestSuite/c.cpp", 300, 0, 0)});
+
+	const std::vector<FilePath> sortedPaths = estimator.sortByEstimatedCost(
+		{FilePath(L"data/IndexingCostEstimatorTestSuite/a.cpp"),
+		 FilePath(L"data/IndexingCostEstimatorTestSuite/b.cpp"),
+		 FilePath(L"data/IndexingCostEstimatorTestSuite/c.cpp")});
+
+	REQUIRE(sortedPaths.size() == 3);
+	REQUIRE(sortedPaths[0].fileName() == L"b.cpp");
+	REQUIRE(sortedPaths[1].fileName() == L"c.cpp");
+	REQUIRE(sortedPaths[2].fileName() == L"a.cpp");
+}
+
+TEST_CASE("indexing cost estimator estimates files without history from their size")
+{
+	const FilePath directoryPath = FilePath(L"data/IndexingCostEstimatorTestSuite").getAbsolute();
+	FileSystem::createDirectory(directoryPath);
+
+	const FilePath recordedFilePath = directoryPath.getConcatenated(L"recorded.cpp");
+	const FilePath bigFilePath = directoryPath.getConcatenated(L"big.cpp");
+	const FilePath smallFilePath = directoryPath.getConcatenated(L"small.cpp");
+	writeFile(recordedFilePath, 1000);
+	writeFile(bigFilePath, 4000);
+	writeFile(smallFilePath, 100);
+
+	// the recorded file calibrates the estimate to 50 ms per 1000 bytes
+	const IndexingCostEstimator estimator({StorageIndexingCost(recordedFilePath.wstr(), 50, 0, 0)});
+
+	REQUIRE(estimator.getEstimatedCost(recordedFilePath) == Approx(50));
+	REQUIRE(estimator.getEstimatedCost(bigFilePath) == Approx(200));
+	REQUIRE(estimator.getEstimatedCost(smallFilePath) == Approx(5));
+
+	const std::vector<FilePath> sortedPaths =
+		estimator.sortByEstimatedCost({smallFilePath, recordedFilePath, bigFilePath});
+
+	REQUIRE(sortedPaths == std::vector<FilePath>({bigFilePath, recordedFilePath, smallFilePath}));
+
+	FileSystem::remove(recordedFilePath);
+	FileSystem::remove(bigFilePath);
+	FileSystem::remove(smallFilePath);
+	FileSystem::remove(directoryPath);
+}
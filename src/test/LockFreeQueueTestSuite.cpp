@@ -0,0 +1,90 @@
+#include "catch.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "LockFreeQueue.h"
+
+TEST_CASE("lock free queue is empty after construction")
+{
+	LockFreeQueue<int> queue;
+	int value = 0;
+
+	REQUIRE(queue.size() == 0);
+	REQUIRE(!queue.pop(&value));
+}
+
+TEST_CASE("lock free queue pops values in push order")
+{
+	LockFreeQueue<int> queue;
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+
+	REQUIRE(queue.size() == 3);
+
+	int value = 0;
+	REQUIRE(queue.pop(&value));
+	REQUIRE(value == 1);
+	REQUIRE(queue.pop(&value));
+	REQUIRE(value == 2);
+	REQUIRE(queue.pop(&value));
+	REQUIRE(value == 3);
+	REQUIRE(!queue.pop(&value));
+	REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("lock free queue keeps order of each producer")
+{
+	const int producerCount = 4;
+	const int valueCount = 10000;
+
+	LockFreeQueue<std::pair<int, int>> queue;
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < producerCount; producer++)
+	{
+		producers.emplace_back([&queue, producer, valueCount]() {
+			for (int i = 0; i < valueCount; i++)
+			{
+				queue.push(std::make_pair(producer, i));
+			}
+		});
+	}
+
+	std::vector<int> nextValues(producerCount, 0);
+	int poppedCount = 0;
+	bool ordered = true;
+	while (poppedCount < producerCount * valueCount)
+	{
+		std::pair<int, int> value;
+		if (queue.pop(&value))
+		{
+			ordered = ordered && value.second == nextValues[value.first];
+			nextValues[value.first] = value.second + 1;
+			poppedCount++;
+		}
+		else
+		{
+			queue.waitForValue();
+		}
+	}
+
+	for (std::thread& producer: producers)
+	{
+		producer.join();
+	}
+
+	REQUIRE(ordered);
+	REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("lock free queue wakes up waiting consumer")
+{
+	LockFreeQueue<int> queue;
+
+	std::thread waker([&queue]() { queue.wakeUp(); });
+	queue.waitForValue();
+	waker.join();
+
+	REQUIRE(queue.size() == 0);
+}
@@ -0,0 +1,70 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "LruCache.h"
+
+TEST_CASE("lru cache is empty after construction")
+{
+	LruCache<int, std::string> cache(2);
+	std::string value;
+
+	REQUIRE(cache.size() == 0);
+	REQUIRE(!cache.getValue(1, &value));
+}
+
+TEST_CASE("lru cache returns stored values")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+
+	std::string value;
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(value == "one");
+	REQUIRE(cache.getValue(2, &value));
+	REQUIRE(value == "two");
+}
+
+TEST_CASE("lru cache drops least recently used value when full")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+
+	std::string value;
+	REQUIRE(cache.getValue(1, &value));
+
+	cache.setValue(3, "three");
+
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(!cache.getValue(2, &value));
+	REQUIRE(cache.getValue(3, &value));
+}
+
+TEST_CASE("lru cache replaces value of existing key")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.setValue(2, "two");
+	cache.setValue(1, "uno");
+	cache.setValue(3, "three");
+
+	std::string value;
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.getValue(1, &value));
+	REQUIRE(value == "uno");
+	REQUIRE(!cache.getValue(2, &value));
+}
+
+TEST_CASE("lru cache is empty after clear")
+{
+	LruCache<int, std::string> cache(2);
+	cache.setValue(1, "one");
+	cache.clear();
+
+	std::string value;
+	REQUIRE(cache.size() == 0);
+	REQUIRE(!cache.getValue(1, &value));
+}
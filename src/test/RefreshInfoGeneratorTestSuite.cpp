@@ -217,6 +217,76 @@ TEST_CASE("refresh info for all files is empty for disabled source group")
 	cleanup();
 }
 
+TEST_CASE("refresh info restricted to shards distributes each source file to one shard")
+{
+	cleanup();
+	{
+		const std::set<FilePath> sourceFilePaths = {
+			m_sourceFolder.getConcatenated(L"a.cpp"),
+			m_sourceFolder.getConcatenated(L"b.cpp"),
+			m_sourceFolder.getConcatenated(L"c.cpp"),
+			m_sourceFolder.getConcatenated(L"d.cpp"),
+			m_sourceFolder.getConcatenated(L"e.cpp")};
+
+		std::vector<std::shared_ptr<SourceGroup>> sourceGroups;
+		sourceGroups.push_back(
+			std::shared_ptr<SourceGroupTest>(new SourceGroupTest(sourceFilePaths)));
+
+		for (const FilePath& sourceFilePath: sourceFilePaths)
+		{
+			addFileToFileSystem(sourceFilePath);
+		}
+
+		std::set<FilePath> shardedFilePaths;
+		for (size_t shardIndex = 0; shardIndex < 2; shardIndex++)
+		{
+			RefreshInfo refreshInfo = RefreshInfoGenerator::getRefreshInfoForAllFiles(sourceGroups);
+			RefreshInfoGenerator::restrictToShard(&refreshInfo, sourceGroups, shardIndex, 2);
+
+			REQUIRE((shardIndex == 0 ? 3 : 2) == refreshInfo.filesToIndex.size());
+			for (const FilePath& filePath: refreshInfo.filesToIndex)
+			{
+				REQUIRE(shardedFilePaths.insert(filePath).second);
+			}
+		}
+
+		REQUIRE(sourceFilePaths == shardedFilePaths);
+	}
+	cleanup();
+}
+
+TEST_CASE("refresh info for checkpoint resumes with files not indexed since checkpoint")
+{
+	const FilePath storedFilePath(L"/src/stored.cpp");
+	const FilePath indexedFilePath(L"/src/indexed.cpp");
+	const FilePath remainingFilePath(L"/src/remaining.cpp");
+
+	RefreshInfo info;
+	info.mode = REFRESH_UPDATED_FILES;
+	info.shallow = true;
+	info.filesToIndex = {storedFilePath, indexedFilePath, remainingFilePath};
+
+	const std::string checkpoint = RefreshInfoGenerator::getCheckpointForRefreshInfo(
+		info, {storedFilePath});
+
+	const RefreshInfo resumedInfo = RefreshInfoGenerator::getRefreshInfoForCheckpoint(
+		checkpoint, {storedFilePath, indexedFilePath});
+
+	REQUIRE(resumedInfo.resume);
+	REQUIRE(REFRESH_UPDATED_FILES == resumedInfo.mode);
+	REQUIRE(resumedInfo.shallow);
+	REQUIRE(0 == resumedInfo.filesToClear.size());
+	REQUIRE(std::set<FilePath>({storedFilePath, remainingFilePath}) == resumedInfo.filesToIndex);
+}
+
+TEST_CASE("refresh info for empty checkpoint does not resume")
+{
+	const RefreshInfo resumedInfo = RefreshInfoGenerator::getRefreshInfoForCheckpoint("", {});
+
+	REQUIRE(!resumedInfo.resume);
+	REQUIRE(REFRESH_NONE == resumedInfo.mode);
+}
+
 TEST_CASE("refresh info for all files is clears indexed files of disabled source group")
 {
 	cleanup();
@@ -300,6 +370,64 @@ TEST_CASE("refresh info for all files is clears nonindexed files of disabled sou
 	cleanup();
 }
 
+TEST_CASE("refresh info for changed files reindexes source files including the changed header")
+{
+	cleanup();
+	{
+		const FilePath includingSourceFilePath = m_sourceFolder.getConcatenated(L"including.cpp");
+		const FilePath otherSourceFilePath = m_sourceFolder.getConcatenated(L"other.cpp");
+		const FilePath headerFilePath = m_sourceFolder.getConcatenated(L"header.h");
+		const FilePath unknownFilePath = m_sourceFolder.getConcatenated(L"unknown.txt");
+
+		std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+			m_indexDbPath, m_bookmarkDbPath);
+		storage->setup();
+
+		const Id includingSourceFileId = addVeryNewFileToStorage(
+			includingSourceFilePath, true, true, storage);
+		addFileToFileSystem(includingSourceFilePath);
+		addVeryNewFileToStorage(otherSourceFilePath, true, true, storage);
+		addFileToFileSystem(otherSourceFilePath);
+		const Id headerFileId = addVeryNewFileToStorage(headerFilePath, false, true, storage);
+		addFileToFileSystem(headerFilePath);
+		addFileToFileSystem(unknownFilePath);
+
+		storage->addEdge(StorageEdgeData(Edge::EDGE_INCLUDE, includingSourceFileId, headerFileId));
+
+		storage->buildCaches();
+
+		const RefreshInfo refreshInfo = RefreshInfoGenerator::getRefreshInfoForChangedFiles(
+			{includingSourceFilePath, otherSourceFilePath},
+			storage,
+			{headerFilePath, unknownFilePath});
+
+		REQUIRE(REFRESH_UPDATED_FILES == refreshInfo.mode);
+		REQUIRE(refreshInfo.filesToIndex == std::set<FilePath>({includingSourceFilePath}));
+		REQUIRE(refreshInfo.filesToClear == std::set<FilePath>({includingSourceFilePath}));
+		REQUIRE(refreshInfo.nonIndexedFilesToClear == std::set<FilePath>({headerFilePath}));
+	}
+	cleanup();
+}
+
+TEST_CASE("refresh info for changed files ignores files unknown to the project")
+{
+	cleanup();
+	{
+		std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+			m_indexDbPath, m_bookmarkDbPath);
+		storage->setup();
+		storage->buildCaches();
+
+		const RefreshInfo refreshInfo = RefreshInfoGenerator::getRefreshInfoForChangedFiles(
+			{}, storage, {m_sourceFolder.getConcatenated(L"unknown.cpp")});
+
+		REQUIRE(REFRESH_NONE == refreshInfo.mode);
+		REQUIRE(refreshInfo.filesToIndex.empty());
+		REQUIRE(refreshInfo.filesToClear.empty());
+	}
+	cleanup();
+}
+
 TEST_CASE("refresh info for updated files is empty for empty storage and empty sourcegroup")
 {
 	cleanup();
@@ -91,3 +91,54 @@ TEST_CASE("search index rates higher on consecutive letters")
 	REQUIRE(L"ocbcabc" == results[0].text);
 	REQUIRE(L"oaabbcc" == results[1].text);
 }
+
+TEST_CASE("search index finds same results for query extended while typing")
+{
+	SearchIndex index;
+	index.addNode(
+		1, NameHierarchy::deserialize(L"::\tmfooBar\tsvoid\tp() const").getQualifiedName());
+	index.addNode(
+		2, NameHierarchy::deserialize(L"::\tmfoxbar\tsvoid\tp() const").getQualifiedName());
+	index.addNode(
+		3, NameHierarchy::deserialize(L"::\tmbarfoo\tsvoid\tp() const").getQualifiedName());
+	index.addNode(4, NameHierarchy::deserialize(L"::\tmfrob\tsvoid\tp() const").getQualifiedName());
+	index.finishSetup();
+
+	index.search(L"f", NodeTypeSet::all(), 0);
+	index.search(L"fo", NodeTypeSet::all(), 0);
+	std::vector<SearchResult> typedResults = index.search(L"fob", NodeTypeSet::all(), 0);
+
+	index.search(L"x", NodeTypeSet::all(), 0);
+	std::vector<SearchResult> results = index.search(L"fob", NodeTypeSet::all(), 0);
+
+	REQUIRE(3 == results.size());
+	REQUIRE(results.size() == typedResults.size());
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		REQUIRE(results[i].text == typedResults[i].text);
+		REQUIRE(results[i].indices == typedResults[i].indices);
+		REQUIRE(results[i].elementIds == typedResults[i].elementIds);
+	}
+}
+
+TEST_CASE("search index finds names with non ascii characters")
+{
+	SearchIndex index;
+	index.addNode(
+		1, NameHierarchy::deserialize(L"::\tmstraße\tsvoid\tp() const").getQualifiedName());
+	index.addNode(
+		2, NameHierarchy::deserialize(L"::\tmstrasse\tsvoid\tp() const").getQualifiedName());
+	index.addNode(
+		3, NameHierarchy::deserialize(L"::\tmÜber\tsvoid\tp() const").getQualifiedName());
+	index.finishSetup();
+
+	std::vector<SearchResult> results = index.search(L"sß", NodeTypeSet::all(), 0);
+	REQUIRE(1 == results.size());
+	REQUIRE(L"straße" == results[0].text);
+
+	results = index.search(L"Üb", NodeTypeSet::all(), 0);
+	REQUIRE(1 == results.size());
+	REQUIRE(L"Über" == results[0].text);
+
+	REQUIRE(index.search(L"sé", NodeTypeSet::all(), 0).empty());
+}
@@ -0,0 +1,44 @@
+#include "catch.hpp"
+
+#include <cstdint>
+#include <set>
+
+#include "SmallObjectAllocator.h"
+
+TEST_CASE("small object allocator returns distinct aligned blocks")
+{
+	std::set<void*> blocks;
+	for (int i = 0; i < 1000; i++)
+	{
+		void* block = SmallObjectAllocator::allocate(40);
+		REQUIRE(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t) == 0);
+		blocks.insert(block);
+	}
+
+	REQUIRE(blocks.size() == 1000);
+
+	for (void* block: blocks)
+	{
+		SmallObjectAllocator::deallocate(block, 40);
+	}
+}
+
+TEST_CASE("small object allocator reuses freed blocks of same size class")
+{
+	void* block = SmallObjectAllocator::allocate(24);
+	SmallObjectAllocator::deallocate(block, 24);
+
+	void* reusedBlock = SmallObjectAllocator::allocate(20);
+	REQUIRE(reusedBlock == block);
+	SmallObjectAllocator::deallocate(reusedBlock, 20);
+}
+
+TEST_CASE("small object allocator does not reserve chunks for large objects")
+{
+	const size_t reservedSize = SmallObjectAllocator::getReservedSize();
+
+	void* block = SmallObjectAllocator::allocate(100000);
+	REQUIRE(block != nullptr);
+	REQUIRE(SmallObjectAllocator::getReservedSize() == reservedSize);
+	SmallObjectAllocator::deallocate(block, 100000);
+}
@@ -1,5 +1,8 @@
 #include "catch.hpp"
 
+#include <atomic>
+#include <thread>
+
 #include "FileSystem.h"
 #include "SqliteIndexStorage.h"
 
@@ -76,3 +79,72 @@ TEST_CASE("storage removes edge successfully")
 
 	REQUIRE(0 == edgeCount);
 }
+
+TEST_CASE("storage replaces indexing cost of same file")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::vector<StorageIndexingCost> costs;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addIndexingCosts({StorageIndexingCost(L"a.cpp", 100, 2048, 512)});
+		storage.addIndexingCosts(
+			{StorageIndexingCost(L"a.cpp", 300, 4096, 1024),
+			 StorageIndexingCost(L"b.cpp", 50, 0, 0)});
+		storage.commitTransaction();
+		costs = storage.getIndexingCosts();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(2 == costs.size());
+	REQUIRE(L"a.cpp" == costs[0].filePath);
+	REQUIRE(300 == costs[0].wallTimeMs);
+	REQUIRE(4096 == costs[0].peakMemoryBytes);
+	REQUIRE(1024 == costs[0].storageByteSize);
+	REQUIRE(L"b.cpp" == costs[1].filePath);
+}
+
+TEST_CASE("storage answers queries from several threads with concurrent reads enabled")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	std::atomic<int> matchingQueryCount(0);
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		for (int i = 0; i < 100; i++)
+		{
+			storage.addNode(StorageNodeData(0, L"node" + std::to_wstring(i)));
+		}
+		storage.commitTransaction();
+
+		storage.setConcurrentReadsEnabled(true);
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&storage, &matchingQueryCount]() {
+				for (int i = 0; i < 100; i++)
+				{
+					const std::wstring name = L"node" + std::to_wstring(i);
+					if (storage.getNodeCount() == 100 &&
+						storage.getNodeBySerializedName(name).serializedName == name)
+					{
+						matchingQueryCount++;
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread: threads)
+		{
+			thread.join();
+		}
+
+		storage.setConcurrentReadsEnabled(false);
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(400 == matchingQueryCount);
+}
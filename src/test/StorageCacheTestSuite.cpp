@@ -0,0 +1,151 @@
+#include "catch.hpp"
+
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "CancellationToken.h"
+#include "StorageAccessProxy.h"
+#include "StorageCache.h"
+
+namespace
+{
+// answers every token with itself and counts how often each token was queried
+class TestStorageAccess: public StorageAccessProxy
+{
+public:
+	std::vector<Id> getActiveTokenIdsForId(Id tokenId, Id* declarationId) const override
+	{
+		queryCounts[tokenId]++;
+		if (onQuery)
+		{
+			onQuery();
+		}
+
+		*declarationId = tokenId;
+		return {tokenId};
+	}
+
+	mutable std::map<Id, size_t> queryCounts;
+	std::function<void()> onQuery;
+};
+
+class TestCache
+{
+public:
+	TestCache(): storageAccess(std::make_shared<TestStorageAccess>())
+	{
+		cache.setSubject(storageAccess);
+	}
+
+	void query(Id tokenId)
+	{
+		Id declarationId = 0;
+		cache.getActiveTokenIdsForId(tokenId, &declarationId);
+	}
+
+	void prefetch(Id tokenId)
+	{
+		StorageCache::ScopedPrefetch scopedPrefetch(std::make_shared<CancellationToken>());
+		query(tokenId);
+	}
+
+	size_t getQueryCount(Id tokenId) const
+	{
+		return storageAccess->queryCounts[tokenId];
+	}
+
+	std::shared_ptr<TestStorageAccess> storageAccess;
+	StorageCache cache;
+};
+}	 // namespace
+
+TEST_CASE("storage cache answers repeated queries from the cache")
+{
+	TestCache testCache;
+	testCache.query(1);
+	testCache.query(1);
+
+	REQUIRE(testCache.getQueryCount(1) == 1);
+}
+
+TEST_CASE("storage cache does not evict queried results for prefetched ones")
+{
+	TestCache testCache;
+	testCache.query(1);
+
+	for (Id tokenId = 2; tokenId < 500; tokenId++)
+	{
+		testCache.prefetch(tokenId);
+	}
+
+	testCache.query(1);
+	REQUIRE(testCache.getQueryCount(1) == 1);
+}
+
+TEST_CASE("storage cache answers queries with prefetched results")
+{
+	TestCache testCache;
+	testCache.prefetch(1);
+	testCache.query(1);
+
+	REQUIRE(testCache.getQueryCount(1) == 1);
+}
+
+TEST_CASE("storage cache keeps prefetched results once they got used")
+{
+	TestCache testCache;
+	testCache.prefetch(1);
+	testCache.query(1);
+
+	// fills up the cache of prefetched results, which drops the first one
+	for (Id tokenId = 2; tokenId < 500; tokenId++)
+	{
+		testCache.prefetch(tokenId);
+	}
+
+	testCache.query(1);
+	REQUIRE(testCache.getQueryCount(1) == 1);
+}
+
+TEST_CASE("storage cache drops prefetched results that were not used")
+{
+	TestCache testCache;
+	testCache.prefetch(1);
+
+	for (Id tokenId = 2; tokenId < 500; tokenId++)
+	{
+		testCache.prefetch(tokenId);
+	}
+
+	testCache.query(1);
+	REQUIRE(testCache.getQueryCount(1) == 2);
+}
+
+TEST_CASE("storage cache does not store results of queries started before it was cleared")
+{
+	TestCache testCache;
+	testCache.storageAccess->onQuery = [&testCache]() { testCache.cache.clear(); };
+	testCache.query(1);
+
+	testCache.storageAccess->onQuery = nullptr;
+	testCache.query(1);
+	testCache.query(1);
+
+	REQUIRE(testCache.getQueryCount(1) == 2);
+}
+
+TEST_CASE("storage cache does not store results of queries started before the subject changed")
+{
+	TestCache testCache;
+	testCache.storageAccess->onQuery = [&testCache]() {
+		testCache.cache.setSubject(testCache.storageAccess);
+	};
+	testCache.query(1);
+
+	testCache.storageAccess->onQuery = nullptr;
+	testCache.query(1);
+	testCache.query(1);
+
+	REQUIRE(testCache.getQueryCount(1) == 2);
+}
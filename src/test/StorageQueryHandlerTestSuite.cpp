@@ -0,0 +1,189 @@
+#include "catch.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "FileSystem.h"
+#include "IntermediateStorage.h"
+#include "ParserClientImpl.h"
+#include "PersistentStorage.h"
+#include "StorageQueryHandler.h"
+
+namespace
+{
+const FilePath s_indexDbPath(L"data/StorageQueryHandlerTestSuite.srctrldb");
+const FilePath s_bookmarkDbPath(L"data/StorageQueryHandlerTestSuite.srctrlbm");
+
+// a file with a function "caller" that calls a function "callee" defined in line 3
+class TestIndex
+{
+public:
+	TestIndex()
+		: m_storage(std::make_shared<PersistentStorage>(s_indexDbPath, s_bookmarkDbPath))
+	{
+		m_storage->clear();
+
+		std::shared_ptr<IntermediateStorage> intermediateStorage =
+			std::make_shared<IntermediateStorage>();
+		ParserClientImpl client(intermediateStorage.get());
+
+		const Id fileId = client.recordFile(FilePath(L"data/main.cpp"), true);
+
+		const Id callerSymbolId = client.recordSymbol(NameHierarchy(L"caller", NAME_DELIMITER_CXX));
+		client.recordSymbolKind(callerSymbolId, SYMBOL_FUNCTION);
+		client.recordDefinitionKind(callerSymbolId, DEFINITION_EXPLICIT);
+		client.recordLocation(
+			callerSymbolId, ParseLocation(fileId, 1, 6, 1, 11), ParseLocationType::TOKEN);
+
+		const Id calleeSymbolId = client.recordSymbol(NameHierarchy(L"callee", NAME_DELIMITER_CXX));
+		client.recordSymbolKind(calleeSymbolId, SYMBOL_FUNCTION);
+		client.recordDefinitionKind(calleeSymbolId, DEFINITION_EXPLICIT);
+		client.recordLocation(
+			calleeSymbolId, ParseLocation(fileId, 3, 6, 3, 11), ParseLocationType::TOKEN);
+
+		client.recordReference(
+			REFERENCE_CALL, calleeSymbolId, callerSymbolId, ParseLocation(fileId, 1, 16, 1, 21));
+
+		m_storage->inject(intermediateStorage.get());
+		m_storage->buildCaches();
+
+		// the storage assigns its own ids to the injected symbols
+		callerId = m_storage->getNodeIdForNameHierarchy(
+			NameHierarchy(L"caller", NAME_DELIMITER_CXX));
+		calleeId = m_storage->getNodeIdForNameHierarchy(
+			NameHierarchy(L"callee", NAME_DELIMITER_CXX));
+	}
+
+	~TestIndex()
+	{
+		m_storage.reset();
+		FileSystem::remove(s_indexDbPath);
+		FileSystem::remove(s_bookmarkDbPath);
+	}
+
+	std::string handleRequest(const std::string& request) const
+	{
+		return StorageQueryHandler(m_storage).handleRequest(request);
+	}
+
+	QJsonObject getResult(const std::string& request) const
+	{
+		return QJsonDocument::fromJson(QByteArray::fromStdString(handleRequest(request)))
+			.object()
+			.value("result")
+			.toObject();
+	}
+
+	Id callerId = 0;
+	Id calleeId = 0;
+
+private:
+	std::shared_ptr<PersistentStorage> m_storage;
+};
+
+std::string handleRequest(const std::string& request)
+{
+	return TestIndex().handleRequest(request);
+}
+}	 // namespace
+
+TEST_CASE("query handler answers with the id of the request")
+{
+	REQUIRE(
+		handleRequest(R"({"id":7,"query":"locations","tokenIds":[]})") ==
+		R"({"id":7,"result":{"locations":[]}})");
+}
+
+TEST_CASE("query handler answers autocompletion without matches")
+{
+	REQUIRE(
+		handleRequest(R"({"id":"a","query":"autocomplete","text":"foo"})") ==
+		R"({"id":"a","result":{"matches":[]}})");
+}
+
+TEST_CASE("query handler answers autocompletion with matching symbols")
+{
+	TestIndex index;
+	const QJsonArray matches =
+		index.getResult(R"({"id":1,"query":"autocomplete","text":"callee"})")
+			.value("matches")
+			.toArray();
+
+	REQUIRE(!matches.isEmpty());
+	const QJsonObject match = matches[0].toObject();
+	REQUIRE(match["name"].toString() == "callee");
+	REQUIRE(match["type"].toString() == "function");
+	REQUIRE(match["tokenIds"].toArray() == QJsonArray({double(index.calleeId)}));
+}
+
+TEST_CASE("query handler answers trail with callees of function")
+{
+	TestIndex index;
+	const QJsonObject result = index.getResult(
+		R"({"id":1,"query":"trail","tokenId":)" + std::to_string(index.callerId) + "}");
+
+	QJsonArray nodeIds;
+	for (const QJsonValue& node: result["nodes"].toArray())
+	{
+		nodeIds.append(node.toObject()["id"]);
+	}
+	REQUIRE(nodeIds.contains(double(index.callerId)));
+	REQUIRE(nodeIds.contains(double(index.calleeId)));
+
+	const QJsonArray edges = result["edges"].toArray();
+	REQUIRE(edges.size() == 1);
+	REQUIRE(edges[0].toObject()["type"].toString() == "call");
+	REQUIRE(edges[0].toObject()["sourceId"].toDouble() == double(index.callerId));
+	REQUIRE(edges[0].toObject()["targetId"].toDouble() == double(index.calleeId));
+}
+
+TEST_CASE("query handler answers trail in backward direction")
+{
+	TestIndex index;
+	const QJsonObject result = index.getResult(
+		R"({"id":1,"query":"trail","direction":"backward","tokenId":)" +
+		std::to_string(index.callerId) + "}");
+
+	REQUIRE(result["edges"].toArray().isEmpty());
+}
+
+TEST_CASE("query handler answers locations of tokens")
+{
+	TestIndex index;
+	const QJsonArray locations =
+		index
+			.getResult(
+				R"({"id":1,"query":"locations","tokenIds":[)" + std::to_string(index.calleeId) +
+				"]}")
+			.value("locations")
+			.toArray();
+
+	REQUIRE(locations.size() == 1);
+	const QJsonObject location = locations[0].toObject();
+	REQUIRE(location["filePath"].toString().endsWith("main.cpp"));
+	REQUIRE(location["startLine"].toDouble() == 3);
+	REQUIRE(location["startColumn"].toDouble() == 6);
+	REQUIRE(location["endLine"].toDouble() == 3);
+	REQUIRE(location["endColumn"].toDouble() == 11);
+	REQUIRE(location["type"].toString() == "token");
+	REQUIRE(location["tokenIds"].toArray() == QJsonArray({double(index.calleeId)}));
+}
+
+TEST_CASE("query handler reports unknown queries")
+{
+	REQUIRE(
+		handleRequest(R"({"id":1,"query":"drop"})") ==
+		R"({"error":"Unknown query \"drop\".","id":1})");
+}
+
+TEST_CASE("query handler reports trails without token")
+{
+	REQUIRE(
+		handleRequest(R"({"id":1,"query":"trail"})").find("\"error\"") != std::string::npos);
+}
+
+TEST_CASE("query handler reports invalid requests")
+{
+	REQUIRE(handleRequest("not json").find("\"error\"") != std::string::npos);
+}
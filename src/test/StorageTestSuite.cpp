@@ -130,6 +130,60 @@ TEST_CASE("storage saves field as member")
 	REQUIRE(foundEdge);
 }
 
+TEST_CASE("storage injects nodes and edges of other database")
+{
+	NameHierarchy a = createNameHierarchy(L"Struct");
+	NameHierarchy b = createNameHierarchy(L"Struct::m_field");
+
+	{
+		PersistentStorage sourceStorage(
+			FilePath(L"data/testInjectSource.sqlite"),
+			FilePath(L"data/testInjectSourceBookmarks.sqlite"));
+		sourceStorage.clear();
+
+		std::shared_ptr<IntermediateStorage> intermetiateStorage =
+			std::make_shared<IntermediateStorage>();
+
+		Id aId = intermetiateStorage
+					 ->addNode(StorageNodeData(
+						 NodeType::typeToInt(NodeType::NODE_STRUCT), NameHierarchy::serialize(a)))
+					 .first;
+		intermetiateStorage->addSymbol(StorageSymbol(aId, DEFINITION_EXPLICIT));
+
+		Id bId = intermetiateStorage
+					 ->addNode(StorageNodeData(
+						 NodeType::typeToInt(NodeType::NODE_FIELD), NameHierarchy::serialize(b)))
+					 .first;
+		intermetiateStorage->addSymbol(StorageSymbol(bId, DEFINITION_EXPLICIT));
+		intermetiateStorage->addEdge(StorageEdgeData(Edge::typeToInt(Edge::EDGE_MEMBER), aId, bId));
+
+		sourceStorage.inject(intermetiateStorage.get());
+	}
+
+	TestStorage storage;
+	storage.addNode(StorageNodeData(
+		NodeType::typeToInt(NodeType::NODE_CLASS),
+		NameHierarchy::serialize(createNameHierarchy(L"Class"))));
+
+	storage.injectDatabase(FilePath(L"data/testInjectSource.sqlite"));
+
+	const Id sourceId = storage.getNodeIdForNameHierarchy(a);
+	const Id targetId = storage.getNodeIdForNameHierarchy(b);
+	REQUIRE(sourceId != 0);
+	REQUIRE(targetId != 0);
+
+	bool foundEdge = false;
+	for (auto edge: storage.getStorageEdges())
+	{
+		if (edge.sourceNodeId == sourceId && edge.targetNodeId == targetId &&
+			edge.type == Edge::typeToInt(Edge::EDGE_MEMBER))
+		{
+			foundEdge = true;
+		}
+	}
+	REQUIRE(foundEdge);
+}
+
 TEST_CASE("storage saves method static")
 {
 	// TestStorage storage;
@@ -0,0 +1,87 @@
+#include "catch.hpp"
+
+#include "Edge.h"
+#include "FileSystem.h"
+#include "SqliteIndexStorage.h"
+#include "SyntheticIndexGenerator.h"
+
+namespace
+{
+const FilePath s_databasePath(L"data/SQLiteTestSuite/synthetic.sqlite");
+const FilePath s_sourceDirectory(L"data/SQLiteTestSuite/synthetic/");
+
+SyntheticIndexGenerator::Parameters getParameters(unsigned int seed)
+{
+	SyntheticIndexGenerator::Parameters parameters;
+	parameters.fileCount = 20;
+	parameters.seed = seed;
+	return parameters;
+}
+
+void cleanup()
+{
+	FileSystem::remove(s_databasePath);
+
+	for (const FilePath& path: FileSystem::getFilePathsFromDirectory(s_sourceDirectory))
+	{
+		FileSystem::remove(path);
+	}
+
+	std::vector<FilePath> directories = FileSystem::getRecursiveSubDirectories(s_sourceDirectory);
+	for (auto it = directories.rbegin(); it != directories.rend(); it++)
+	{
+		FileSystem::remove(*it);
+	}
+	FileSystem::remove(s_sourceDirectory);
+}
+
+std::vector<std::wstring> generateNodeNames(unsigned int seed)
+{
+	std::vector<std::wstring> names;
+	{
+		SqliteIndexStorage storage(s_databasePath);
+		storage.setup();
+		SyntheticIndexGenerator(getParameters(seed)).generate(&storage, s_sourceDirectory);
+
+		for (const StorageNode& node: storage.getAll<StorageNode>())
+		{
+			names.push_back(node.serializedName);
+		}
+	}
+	cleanup();
+	return names;
+}
+}	 // namespace
+
+TEST_CASE("synthetic index generator creates files, symbols and references")
+{
+	SyntheticIndexGenerator::Statistics statistics;
+	size_t callCount = 0;
+	bool isIncompatible = true;
+	{
+		SqliteIndexStorage storage(s_databasePath);
+		storage.setup();
+		statistics =
+			SyntheticIndexGenerator(getParameters(1)).generate(&storage, s_sourceDirectory);
+
+		callCount = storage.getEdgesByType(Edge::typeToInt(Edge::EDGE_CALL)).size();
+		isIncompatible = storage.isIncompatible();
+	}
+	cleanup();
+
+	REQUIRE(20 == statistics.fileCount);
+	REQUIRE(statistics.nodeCount > statistics.fileCount);
+	REQUIRE(statistics.edgeCount > statistics.nodeCount);
+	REQUIRE(statistics.sourceLocationCount > statistics.edgeCount);
+	REQUIRE(callCount > 0);
+	REQUIRE(!isIncompatible);
+}
+
+TEST_CASE("synthetic index generator creates the same index for the same seed")
+{
+	const std::vector<std::wstring> names = generateNodeNames(1);
+
+	REQUIRE(!names.empty());
+	REQUIRE(names == generateNodeNames(1));
+	REQUIRE(names != generateNodeNames(2));
+}
@@ -0,0 +1,183 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "CancellationToken.h"
+#include "ThreadPool.h"
+
+TEST_CASE("thread pool runs executed jobs")
+{
+	ThreadPool pool(2);
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	int runCount = 0;
+
+	for (int i = 0; i < 10; i++)
+	{
+		pool.execute([&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			runCount++;
+			condition.notify_all();
+		});
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	REQUIRE(condition.wait_for(
+		lock, std::chrono::seconds(10), [&runCount]() { return runCount == 10; }));
+}
+
+TEST_CASE("thread pool visits every index once")
+{
+	ThreadPool pool(3);
+
+	std::vector<std::atomic<int>> visitCounts(1000);
+	for (std::atomic<int>& visitCount: visitCounts)
+	{
+		visitCount = 0;
+	}
+
+	pool.forEachIndex(visitCounts.size(), [&visitCounts](size_t i) { visitCounts[i]++; });
+
+	for (const std::atomic<int>& visitCount: visitCounts)
+	{
+		REQUIRE(visitCount == 1);
+	}
+}
+
+TEST_CASE("thread pool runs values of for each")
+{
+	ThreadPool pool(2);
+
+	const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8};
+	std::atomic<int> sum(0);
+
+	pool.forEach<int>(values, [&sum](const int& value) { sum += value; });
+
+	REQUIRE(sum == 36);
+}
+
+TEST_CASE("thread pool finishes nested for each index on a single thread")
+{
+	ThreadPool pool(1);
+
+	std::atomic<int> runCount(0);
+	pool.forEachIndex(4, [&](size_t) {
+		pool.forEachIndex(4, [&](size_t) { runCount++; });
+	});
+
+	REQUIRE(runCount == 16);
+}
+
+TEST_CASE("thread pool skips indices after cancellation")
+{
+	ThreadPool pool(2);
+
+	std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+	std::atomic<int> runCount(0);
+
+	pool.forEachIndex(
+		10000,
+		[&](size_t) {
+			if (++runCount == 10)
+			{
+				token->cancel();
+			}
+		},
+		ThreadPool::PRIORITY_NORMAL,
+		token);
+
+	// indices that were already handed out still finish
+	REQUIRE(runCount >= 10);
+	REQUIRE(runCount < 10000);
+}
+
+TEST_CASE("thread pool skips pending jobs of cancelled token")
+{
+	ThreadPool pool(1);
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool blocked = true;
+	bool cancelledJobRan = false;
+	bool lastJobRan = false;
+
+	// keep the only worker busy until the job was cancelled
+	pool.execute([&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&blocked]() { return !blocked; });
+	});
+
+	std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+	pool.execute(
+		[&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			cancelledJobRan = true;
+		},
+		ThreadPool::PRIORITY_HIGH,
+		token);
+	pool.execute(
+		[&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			lastJobRan = true;
+			condition.notify_all();
+		},
+		ThreadPool::PRIORITY_LOW);
+
+	token->cancel();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		blocked = false;
+	}
+	condition.notify_all();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	REQUIRE(condition.wait_for(
+		lock, std::chrono::seconds(10), [&lastJobRan]() { return lastJobRan; }));
+	REQUIRE(!cancelledJobRan);
+}
+
+TEST_CASE("thread pool runs higher priority jobs first")
+{
+	ThreadPool pool(1);
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool blocked = true;
+	std::vector<int> order;
+
+	pool.execute([&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&blocked]() { return !blocked; });
+	});
+
+	pool.execute(
+		[&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(ThreadPool::PRIORITY_LOW);
+			condition.notify_all();
+		},
+		ThreadPool::PRIORITY_LOW);
+	pool.execute(
+		[&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(ThreadPool::PRIORITY_HIGH);
+			condition.notify_all();
+		},
+		ThreadPool::PRIORITY_HIGH);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		blocked = false;
+	}
+	condition.notify_all();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	REQUIRE(condition.wait_for(
+		lock, std::chrono::seconds(10), [&order]() { return order.size() == 2; }));
+	REQUIRE(order.front() == ThreadPool::PRIORITY_HIGH);
+}